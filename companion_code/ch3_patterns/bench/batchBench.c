@@ -0,0 +1,138 @@
+#include "bench_common.h"
+#include <stdlib.h>
+
+#include "api_rectangle.h"
+#include "api_circle.h"
+#include "api_triangle.h"
+#include "shape_batch.h"
+#include "shape_math.h"
+
+/*
+ * Per-object vtable path (one indirect call per shape) versus the batch
+ * kernels over dense dimension arrays, at 1k / 100k / 1M shapes.
+ * Same comparison for a whole-scene rescale: *_update* calls versus
+ * shape_scale_n followed by the area/perimeter kernels.
+ */
+
+#define SCALE 1.0f // Keeps the dimensions stable across repeats
+
+#define WORK_PER_SIZE 20000000u // Shapes processed per measurement
+
+static void run(uint32_t n)
+{
+    uint32_t seed = 42;
+    uint32_t repeats = (WORK_PER_SIZE / n) ? (WORK_PER_SIZE / n) : 1;
+
+    api_rectangle_t *rects = malloc(n * sizeof(api_rectangle_t));
+    api_circle_t *circles = malloc(n * sizeof(api_circle_t));
+    api_triangle_t *tris = malloc(n * sizeof(api_triangle_t));
+    api_shape_t **shapes = malloc(3 * n * sizeof(api_shape_t *));
+    uint32_t *dim_a = malloc(3 * n * sizeof(uint32_t));
+    uint32_t *dim_b = malloc(3 * n * sizeof(uint32_t));
+    float *area = malloc(3 * n * sizeof(float));
+    uint32_t *perimeter = malloc(3 * n * sizeof(uint32_t));
+
+    if (!rects || !circles || !tris || !shapes || !dim_a || !dim_b || !area || !perimeter) {
+        printf("  out of memory for n=%u\n", n);
+        exit(1);
+    }
+
+    for (uint32_t i = 0; i < n; i++) {
+        rect_config_t r_conf = {1 + bench_random(&seed) % 1000, 1 + bench_random(&seed) % 1000};
+        shape_config_t r_shape = {SHAPE_TYPE_RECTANGLE, 0, true};
+        api_rectangle_init(&rects[i], &r_conf, &r_shape);
+        dim_a[i] = r_conf.width;
+        dim_b[i] = r_conf.height;
+
+        circle_config_t c_conf = {1 + bench_random(&seed) % 1000};
+        shape_config_t c_shape = {SHAPE_TYPE_CIRCLE, 0, true};
+        api_circle_init(&circles[i], &c_conf, &c_shape);
+        dim_a[n + i] = c_conf.radius;
+        dim_b[n + i] = 0;
+
+        triangle_config_t t_conf = {1 + bench_random(&seed) % 1000, 1 + bench_random(&seed) % 1000};
+        shape_config_t t_shape = {SHAPE_TYPE_TRIANGLE, 0, true};
+        api_triangle_init(&tris[i], &t_conf, &t_shape);
+        dim_a[2 * n + i] = t_conf.base;
+        dim_b[2 * n + i] = t_conf.height;
+
+        shapes[i] = (api_shape_t *)&rects[i];
+        shapes[n + i] = (api_shape_t *)&circles[i];
+        shapes[2 * n + i] = (api_shape_t *)&tris[i];
+    }
+
+    // 1. Per-object path: one vtable call per shape and value
+    uint64_t start = bench_now_ns();
+    for (uint32_t r = 0; r < repeats; r++) {
+        for (uint32_t i = 0; i < 3 * n; i++) {
+            area[i] = shape_get_area(shapes[i]);
+            perimeter[i] = shape_get_perimeter(shapes[i]);
+        }
+        bench_sink += perimeter[r % (3 * n)];
+    }
+    uint64_t per_object = bench_now_ns() - start;
+
+    // 2. Batch path: one kernel call per type lane
+    start = bench_now_ns();
+    for (uint32_t r = 0; r < repeats; r++) {
+        for (uint32_t t = 0; t < 3; t++) {
+            shape_type_t type = (shape_type_t)(SHAPE_TYPE_RECTANGLE + t);
+            shape_get_area_n(type, &dim_a[t * n], &dim_b[t * n], &area[t * n], n);
+            shape_get_perimeter_n(type, &dim_a[t * n], &dim_b[t * n], &perimeter[t * n], n);
+        }
+        bench_sink += perimeter[r % (3 * n)];
+    }
+    uint64_t batch = bench_now_ns() - start;
+
+    // 3. Rescale, per-object path: each update recomputes the cached state
+    start = bench_now_ns();
+    for (uint32_t r = 0; r < repeats; r++) {
+        for (uint32_t i = 0; i < n; i++) {
+            rect_updateWidth(&rects[i].rect, shapeMath_scaleDim(rects[i].rect.width, SCALE));
+            circle_updateRadius(circles[i].circle, shapeMath_scaleDim(dim_a[n + i], SCALE));
+            triangle_updateDimensions(&tris[i].triangle, shapeMath_scaleDim(dim_a[2 * n + i], SCALE),
+                                      shapeMath_scaleDim(dim_b[2 * n + i], SCALE));
+        }
+        bench_sink += rects[r % n].rect.area;
+    }
+    uint64_t scale_per_object = bench_now_ns() - start;
+
+    // 4. Rescale, batch path: scale kernel then area/perimeter kernels per lane
+    start = bench_now_ns();
+    for (uint32_t r = 0; r < repeats; r++) {
+        shape_scale_n(dim_a, SCALE, 3 * n);
+        shape_scale_n(dim_b, SCALE, 3 * n);
+        for (uint32_t t = 0; t < 3; t++) {
+            shape_type_t type = (shape_type_t)(SHAPE_TYPE_RECTANGLE + t);
+            shape_get_area_n(type, &dim_a[t * n], &dim_b[t * n], &area[t * n], n);
+            shape_get_perimeter_n(type, &dim_a[t * n], &dim_b[t * n], &perimeter[t * n], n);
+        }
+        bench_sink += perimeter[r % (3 * n)];
+    }
+    uint64_t scale_batch = bench_now_ns() - start;
+
+    bench_report("per-object (vtable)", 3 * n, per_object, repeats);
+    bench_report("batch kernels", 3 * n, batch, repeats);
+    printf("  speedup x%.2f\n", (double)per_object / (double)batch);
+    bench_report("rescale per-object", 3 * n, scale_per_object, repeats);
+    bench_report("rescale batch", 3 * n, scale_batch, repeats);
+    printf("  speedup x%.2f\n\n", (double)scale_per_object / (double)scale_batch);
+
+    free(rects);
+    free(circles);
+    free(tris);
+    free(shapes);
+    free(dim_a);
+    free(dim_b);
+    free(area);
+    free(perimeter);
+}
+
+int main(void)
+{
+    printf("Batch area/perimeter benchmark (backend: %s)\n", shapeBatch_getBackend());
+    run(1000);
+    run(100000);
+    run(1000000);
+    return 0;
+}
@@ -0,0 +1,33 @@
+#ifndef BENCH_COMMON_H
+#define BENCH_COMMON_H
+
+#define _POSIX_C_SOURCE 199309L
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+// Monotonic wall clock in nanoseconds
+static inline uint64_t bench_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+// Deterministic pseudo random numbers so every run uses the same scene
+static inline uint32_t bench_random(uint32_t *state)
+{
+    *state = *state * 1664525u + 1013904223u;
+    return *state;
+}
+
+// Keeps the optimizer from discarding benchmark results
+static volatile uint32_t bench_sink;
+
+static inline void bench_report(const char *name, uint32_t n, uint64_t elapsed_ns, uint32_t repeats)
+{
+    double per_shape = (double)elapsed_ns / ((double)n * (double)repeats);
+    printf("  %-28s n=%-8u %8.3f ns/shape\n", name, n, per_shape);
+}
+
+#endif // BENCH_COMMON_H
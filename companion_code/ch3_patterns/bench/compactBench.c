@@ -0,0 +1,77 @@
+#include "bench_common.h"
+#include <stdlib.h>
+
+#include "api_rectangle.h"
+#include "api_circle.h"
+#include "api_triangle.h"
+#include "shape_compact.h"
+
+/*
+ * Footprint of the compact encoding against the api_* objects for a
+ * 10k-shape scene, plus the cost of unpacking on an area scan.
+ */
+
+#define SCENE_SIZE 10000u
+#define REPEATS 2000u
+
+static void footprint_row(const char *name, size_t size)
+{
+    printf("  %-20s %4zu B/shape %8zu B for %u shapes\n", name, size, size * SCENE_SIZE, SCENE_SIZE);
+}
+
+int main(void)
+{
+    uint32_t seed = 42;
+    api_rectangle_t *rects = malloc(SCENE_SIZE * sizeof(api_rectangle_t));
+    api_shape_t **shapes = malloc(SCENE_SIZE * sizeof(api_shape_t *));
+    shape_compact_t *compact = malloc(SCENE_SIZE * sizeof(shape_compact_t));
+
+    if (!rects || !shapes || !compact) {
+        printf("  out of memory\n");
+        return 1;
+    }
+
+    printf("Compact encoding footprint\n");
+    footprint_row("shape_t", sizeof(shape_t));
+    footprint_row("api_shape_t", sizeof(api_shape_t));
+    footprint_row("api_rectangle_t", sizeof(api_rectangle_t));
+    footprint_row("api_circle_t", sizeof(api_circle_t));
+    footprint_row("api_triangle_t", sizeof(api_triangle_t));
+    footprint_row("shape_compact_t", sizeof(shape_compact_t));
+    printf("  rectangle scene: x%.1f smaller (plus %zu B of api_shape_t* per shape for the vtable path)\n\n",
+           (double)sizeof(api_rectangle_t) / (double)sizeof(shape_compact_t), sizeof(api_shape_t *));
+
+    for (uint32_t i = 0; i < SCENE_SIZE; i++) {
+        rect_config_t conf = {1 + bench_random(&seed) % 1000, 1 + bench_random(&seed) % 1000};
+        shape_config_t shape = {SHAPE_TYPE_RECTANGLE, bench_random(&seed) & 0xFFFFFFu, true};
+        api_rectangle_init(&rects[i], &conf, &shape);
+        shapeCompact_initRectangle(&compact[i], &conf, &shape);
+        shapes[i] = (api_shape_t *)&rects[i];
+    }
+
+    printf("Area scan over rectangles\n");
+    uint64_t start = bench_now_ns();
+    for (uint32_t r = 0; r < REPEATS; r++) {
+        float total = 0.0f;
+        for (uint32_t i = 0; i < SCENE_SIZE; i++) {
+            total += shape_get_area(shapes[i]);
+        }
+        bench_sink += (uint32_t)total;
+    }
+    bench_report("api_* (cached area)", SCENE_SIZE, bench_now_ns() - start, REPEATS);
+
+    start = bench_now_ns();
+    for (uint32_t r = 0; r < REPEATS; r++) {
+        float total = 0.0f;
+        for (uint32_t i = 0; i < SCENE_SIZE; i++) {
+            total += shapeCompact_getArea(&compact[i]);
+        }
+        bench_sink += (uint32_t)total;
+    }
+    bench_report("compact (computed area)", SCENE_SIZE, bench_now_ns() - start, REPEATS);
+
+    free(rects);
+    free(shapes);
+    free(compact);
+    return 0;
+}
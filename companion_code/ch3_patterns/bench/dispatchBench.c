@@ -0,0 +1,71 @@
+#include "bench_common.h"
+#include <stdlib.h>
+
+#include "factory_shape.h"
+
+/*
+ * Same mixed workload in both dispatch modes. Build with
+ * API_SHAPE_DEVIRTUALIZE=0 (vtable) and =1 (type switch) and compare.
+ */
+
+#define WORK_PER_SIZE 20000000u
+
+static void run(uint32_t n)
+{
+    uint32_t seed = 7;
+    uint32_t repeats = (WORK_PER_SIZE / n) ? (WORK_PER_SIZE / n) : 1;
+
+    // Largest concrete type so any shape fits in a slot
+    typedef union {
+        api_rectangle_t rect;
+        api_circle_t circle;
+        api_triangle_t triangle;
+    } slot_t;
+
+    slot_t *slots = malloc(n * sizeof(slot_t));
+    api_shape_t **shapes = malloc(n * sizeof(api_shape_t *));
+    if (!slots || !shapes) {
+        printf("  out of memory for n=%u\n", n);
+        exit(1);
+    }
+
+    // Random type order: the worst case for indirect branch prediction
+    for (uint32_t i = 0; i < n; i++) {
+        factory_config_t conf;
+        conf.shape_conf.type = (shape_type_t)(SHAPE_TYPE_RECTANGLE + bench_random(&seed) % 3);
+        conf.shape_conf.color = 0;
+        conf.shape_conf.visible = true;
+        conf.shape.rect.width = 1 + bench_random(&seed) % 1000;
+        conf.shape.rect.height = 1 + bench_random(&seed) % 1000;
+        if (conf.shape_conf.type == SHAPE_TYPE_CIRCLE) {
+            conf.shape.circle.radius = 1 + bench_random(&seed) % 1000;
+        }
+        shapes[i] = factory_shape_create((api_shape_t *)&slots[i], &conf);
+    }
+
+    float total_area = 0.0f;
+    uint32_t total_perimeter = 0;
+    uint64_t start = bench_now_ns();
+    for (uint32_t r = 0; r < repeats; r++) {
+        for (uint32_t i = 0; i < n; i++) {
+            total_area += shape_get_area(shapes[i]);
+            total_perimeter += shape_get_perimeter(shapes[i]);
+        }
+    }
+    uint64_t elapsed = bench_now_ns() - start;
+
+    bench_sink += total_perimeter + (uint32_t)total_area;
+    bench_report(API_SHAPE_DEVIRTUALIZE ? "switch dispatch" : "vtable dispatch", n, elapsed, repeats);
+
+    free(slots);
+    free(shapes);
+}
+
+int main(void)
+{
+    printf("Dispatch benchmark (API_SHAPE_DEVIRTUALIZE=%d)\n", API_SHAPE_DEVIRTUALIZE);
+    run(1000);
+    run(100000);
+    run(1000000);
+    return 0;
+}
@@ -0,0 +1,105 @@
+#include "bench_common.h"
+#include <pthread.h>
+#include <stdlib.h>
+
+#include "factory_shape.h"
+
+/*
+ * Million-shape scene load: one factory_shape_create() per config against
+ * factory_shape_create_many(), serial and split across a small pthread
+ * fork/join pool through the executor callback.
+ */
+
+#define SCENE_SIZE 1000000u
+#define REPEATS 10u
+#define THREAD_COUNT 4u
+
+typedef struct {
+    factory_job_t job;
+    void *job_context;
+    uint32_t job_count;
+    uint32_t first;
+} worker_t;
+
+static void *worker_main(void *arg)
+{
+    worker_t *worker = (worker_t *)arg;
+    for (uint32_t j = worker->first; j < worker->job_count; j += THREAD_COUNT) {
+        worker->job(worker->job_context, j);
+    }
+    return NULL;
+}
+
+// Job j runs on thread j % THREAD_COUNT; the caller runs the first share
+static void thread_run_jobs(void *context, factory_job_t job, void *job_context, uint32_t job_count)
+{
+    (void)context;
+    pthread_t threads[THREAD_COUNT];
+    worker_t workers[THREAD_COUNT];
+
+    for (uint32_t t = 0; t < THREAD_COUNT; t++) {
+        workers[t] = (worker_t){job, job_context, job_count, t};
+        if (t > 0) {
+            pthread_create(&threads[t], NULL, worker_main, &workers[t]);
+        }
+    }
+    worker_main(&workers[0]);
+    for (uint32_t t = 1; t < THREAD_COUNT; t++) {
+        pthread_join(threads[t], NULL);
+    }
+}
+
+int main(void)
+{
+    uint32_t seed = 42;
+    factory_config_t *configs = malloc(SCENE_SIZE * sizeof(factory_config_t));
+    api_shape_storage_t *storage = malloc(SCENE_SIZE * sizeof(api_shape_storage_t));
+    api_shape_t **shapes = malloc(SCENE_SIZE * sizeof(api_shape_t *));
+
+    if (!configs || !storage || !shapes) {
+        printf("  out of memory\n");
+        return 1;
+    }
+
+    for (uint32_t i = 0; i < SCENE_SIZE; i++) {
+        factory_config_t *conf = &configs[i];
+        conf->shape_conf.type = (shape_type_t)(SHAPE_TYPE_RECTANGLE + (bench_random(&seed) >> 16) % 3);
+        conf->shape_conf.color = (bench_random(&seed) >> 8) & 0xFFFFFFu;
+        conf->shape_conf.visible = true;
+        conf->shape.rect.width = 1 + (bench_random(&seed) >> 16) % 1000;
+        conf->shape.rect.height = 1 + (bench_random(&seed) >> 16) % 1000;
+        if (conf->shape_conf.type == SHAPE_TYPE_CIRCLE) {
+            conf->shape.circle.radius = conf->shape.rect.width;
+        }
+    }
+
+    printf("Scene load, mixed types\n");
+    uint64_t start = bench_now_ns();
+    for (uint32_t r = 0; r < REPEATS; r++) {
+        for (uint32_t i = 0; i < SCENE_SIZE; i++) {
+            shapes[i] = factory_shape_create(&storage[i].super, &configs[i]);
+        }
+        bench_sink += shape_get_perimeter(shapes[r]);
+    }
+    bench_report("factory_shape_create loop", SCENE_SIZE, bench_now_ns() - start, REPEATS);
+
+    start = bench_now_ns();
+    for (uint32_t r = 0; r < REPEATS; r++) {
+        factory_shape_create_many(configs, SCENE_SIZE, storage, shapes, NULL);
+        bench_sink += shape_get_perimeter(shapes[r]);
+    }
+    bench_report("create_many (serial)", SCENE_SIZE, bench_now_ns() - start, REPEATS);
+
+    factory_executor_t executor = {thread_run_jobs, NULL, 0};
+    start = bench_now_ns();
+    for (uint32_t r = 0; r < REPEATS; r++) {
+        factory_shape_create_many(configs, SCENE_SIZE, storage, shapes, &executor);
+        bench_sink += shape_get_perimeter(shapes[r]);
+    }
+    bench_report("create_many (4 threads)", SCENE_SIZE, bench_now_ns() - start, REPEATS);
+
+    free(configs);
+    free(storage);
+    free(shapes);
+    return 0;
+}
@@ -0,0 +1,124 @@
+#include <stdio.h>
+
+#include "common.h"
+#include "shape.h"
+#include "shape_rectangle.h"
+#include "shape_circle.h"
+#include "shape_triangle.h"
+#include "api_shape.h"
+#include "factory_shape.h"
+#include "shape_registry.h"
+#include "shape_registry_view.h"
+#include "canvas.h"
+#include "shape_store.h"
+#include "shape_compact.h"
+#include "shape_pool.h"
+#include "shape_flyweight.h"
+
+/*
+ * Memory footprint report: size, alignment and padding of every public
+ * struct. Padding = sizeof - sum of the member sizes.
+ * Static RAM of the singletons is listed by the Makefile (nm -S).
+ */
+
+#define M(type, member) sizeof(((type *)0)->member)
+#define MAX(a, b) ((a) > (b) ? (a) : (b))
+#define ROW(type, members) report(#type, sizeof(type), ALIGNOF(type), (members))
+
+static void report(const char *name, size_t size, size_t align, size_t members)
+{
+    printf("  %-26s %5zu %6zu %8zu\n", name, size, align, size - members);
+}
+
+int main(void)
+{
+    printf("Public struct footprint (bytes)\n");
+    printf("  %-26s %5s %6s %8s\n", "struct", "size", "align", "padding");
+
+    // Core objects
+    ROW(shape_t, M(shape_t, type) + M(shape_t, color) + M(shape_t, visible));
+    ROW(shape_config_t, M(shape_config_t, type) + M(shape_config_t, color) + M(shape_config_t, visible));
+    ROW(rectangle_t, M(rectangle_t, width) + M(rectangle_t, height) + M(rectangle_t, area) +
+                     M(rectangle_t, perimeter) + M(rectangle_t, generation));
+    ROW(rect_config_t, M(rect_config_t, width) + M(rect_config_t, height));
+    ROW(circle_memory_t, M(circle_memory_t, _reserved));
+    ROW(circle_config_t, M(circle_config_t, radius));
+    ROW(triangle_t, M(triangle_t, area) + M(triangle_t, generation) + M(triangle_t, _private));
+    ROW(triangle_config_t, M(triangle_config_t, base) + M(triangle_config_t, height));
+
+    // Family (inheritance)
+    ROW(shape_rectangle_t, M(shape_rectangle_t, base) + M(shape_rectangle_t, rect));
+    ROW(shape_circle_t, M(shape_circle_t, base) + M(shape_circle_t, raw_memory) + M(shape_circle_t, circle));
+    ROW(shape_triangle_t, M(shape_triangle_t, base) + M(shape_triangle_t, triangle));
+
+    // VTable API
+    ROW(shape_vtable_t, M(shape_vtable_t, draw) + M(shape_vtable_t, get_area) + M(shape_vtable_t, get_perimeter) +
+                        M(shape_vtable_t, get_area_many) + M(shape_vtable_t, get_perimeter_many) +
+                        M(shape_vtable_t, get_generation));
+    ROW(api_shape_t, M(api_shape_t, base) + M(api_shape_t, vptr));
+    ROW(api_rectangle_t, M(api_rectangle_t, super) + M(api_rectangle_t, rect));
+    ROW(api_circle_t, M(api_circle_t, super) + M(api_circle_t, mem) + M(api_circle_t, circle));
+    ROW(api_triangle_t, M(api_triangle_t, super) + M(api_triangle_t, triangle));
+    ROW(factory_config_t, M(factory_config_t, shape_conf) + M(factory_config_t, shape));
+    // Union: padding is the slack over the largest member
+    ROW(api_shape_storage_t, MAX(MAX(sizeof(api_rectangle_t), sizeof(api_circle_t)), sizeof(api_triangle_t)));
+
+    // Registry, canvas
+    ROW(shape_registry_data_t, M(shape_registry_data_t, count) + M(shape_registry_data_t, api_shapes) +
+                               M(shape_registry_data_t, biggestArea) + M(shape_registry_data_t, biggestPerimeter));
+    ROW(shape_registry_t, M(shape_registry_t, count) + M(shape_registry_t, capacity) + M(shape_registry_t, api_shapes) +
+                          M(shape_registry_t, biggestArea) + M(shape_registry_t, biggestPerimeter) +
+                          M(shape_registry_t, max_area) + M(shape_registry_t, max_perimeter) +
+                          M(shape_registry_t, generations) + M(shape_registry_t, token_of) +
+                          M(shape_registry_t, slot_of) + M(shape_registry_t, free_token) +
+                          M(shape_registry_t, fresh_token) + M(shape_registry_t, area_of) +
+                          M(shape_registry_t, perimeter_of) + M(shape_registry_t, area_tree) +
+                          M(shape_registry_t, perimeter_tree) + M(shape_registry_t, key_of) +
+                          M(shape_registry_t, buckets) + M(shape_registry_t, next_same_key) +
+                          M(shape_registry_t, prev_same_key) + M(shape_registry_t, bucket_mask) +
+                          M(shape_registry_t, dirty) + M(shape_registry_t, is_dirty) +
+                          M(shape_registry_t, dirty_count) + M(shape_registry_t, executor) +
+                          M(shape_registry_t, workers) + M(shape_registry_t, unordered) +
+                          M(shape_registry_t, indexed) + M(shape_registry_t, track_changes) +
+                          M(shape_registry_t, changed));
+    ROW(canvas_config_t, M(canvas_config_t, positionListener) + M(canvas_config_t, positionContext));
+    ROW(canvas_move_observer_t, M(canvas_move_observer_t, _reserved));
+
+    // Store, compact encoding
+    ROW(shape_store_handle_t, M(shape_store_handle_t, super) + M(shape_store_handle_t, store) +
+                              M(shape_store_handle_t, index));
+    ROW(shape_store_lane_t, M(shape_store_lane_t, count) + M(shape_store_lane_t, capacity) +
+                            M(shape_store_lane_t, handles) + M(shape_store_lane_t, dim_a) +
+                            M(shape_store_lane_t, dim_b) + M(shape_store_lane_t, color) +
+                            M(shape_store_lane_t, visible) + M(shape_store_lane_t, area) +
+                            M(shape_store_lane_t, perimeter));
+    ROW(shape_store_t, M(shape_store_t, generation) + M(shape_store_t, lanes));
+    ROW(shape_compact_t, M(shape_compact_t, _type_flags) + M(shape_compact_t, _vtable) + M(shape_compact_t, _color) +
+                         M(shape_compact_t, _dim_a) + M(shape_compact_t, _dim_b));
+    ROW(shape_compact_vtable_t, M(shape_compact_vtable_t, draw) + M(shape_compact_vtable_t, get_area) +
+                                M(shape_compact_vtable_t, get_perimeter));
+
+    // Registry views (one per buffer)
+    ROW(shape_registry_view_t, M(shape_registry_view_t, version) + M(shape_registry_view_t, count) +
+                               M(shape_registry_view_t, biggestArea) + M(shape_registry_view_t, biggestPerimeter) +
+                               M(shape_registry_view_t, max_area) + M(shape_registry_view_t, max_perimeter) +
+                               M(shape_registry_view_t, api_shapes));
+    ROW(shape_registry_views_t, M(shape_registry_views_t, buffers) + M(shape_registry_views_t, readers) +
+                                M(shape_registry_views_t, buffer_count) + M(shape_registry_views_t, capacity) +
+                                M(shape_registry_views_t, current) + M(shape_registry_views_t, version));
+
+    // Flyweight: per-instance cost vs. the shared geometry
+    ROW(shape_flyweight_t, M(shape_flyweight_t, super) + M(shape_flyweight_t, geometry) +
+                           M(shape_flyweight_t, generation));
+    ROW(shape_geometry_t, M(shape_geometry_t, type) + M(shape_geometry_t, dim_a) + M(shape_geometry_t, dim_b) +
+                          M(shape_geometry_t, area) + M(shape_geometry_t, perimeter) + M(shape_geometry_t, refs));
+
+    // Slab pool
+    ROW(shape_pool_slab_t, M(shape_pool_slab_t, base) + M(shape_pool_slab_t, block_size) +
+                           M(shape_pool_slab_t, free_list) + M(shape_pool_slab_t, stats));
+    ROW(shape_pool_t, M(shape_pool_t, slabs) + M(shape_pool_t, lock) + M(shape_pool_t, unlock) +
+                      M(shape_pool_t, lock_context));
+    ROW(shape_pool_cache_t, M(shape_pool_cache_t, pool) + M(shape_pool_cache_t, count) +
+                            M(shape_pool_cache_t, blocks));
+    return 0;
+}
@@ -0,0 +1,68 @@
+#include "bench_common.h"
+#include <stdlib.h>
+
+#include "shape_math.h"
+
+/*
+ * Float formulas versus the Q-format integer helpers.
+ * Build twice (see Makefile target "math") to also time the float API
+ * wrappers with SHAPE_MATH_FIXED_POINT=1.
+ */
+
+#define COUNT 100000u
+#define REPEATS 200u
+
+int main(void)
+{
+    uint32_t seed = 7;
+    uint32_t *radius = malloc(COUNT * sizeof(uint32_t));
+    uint32_t *base = malloc(COUNT * sizeof(uint32_t));
+    uint32_t *height = malloc(COUNT * sizeof(uint32_t));
+    float *area = malloc(COUNT * sizeof(float));
+    shape_q_t *area_q = malloc(COUNT * sizeof(shape_q_t));
+    uint32_t *perimeter = malloc(COUNT * sizeof(uint32_t));
+
+    if (!radius || !base || !height || !area || !area_q || !perimeter) {
+        printf("  out of memory\n");
+        return 1;
+    }
+
+    for (uint32_t i = 0; i < COUNT; i++) {
+        radius[i] = 1 + bench_random(&seed) % 10000;
+        base[i] = 1 + bench_random(&seed) % 10000;
+        height[i] = 1 + bench_random(&seed) % 10000;
+    }
+
+    printf("Geometry math benchmark (backend: %s, Q%u)\n",
+           SHAPE_MATH_FIXED_POINT ? "fixed point" : "float", (unsigned)SHAPE_MATH_Q_BITS);
+
+    // 1. Public formulas (float API, selected backend)
+    uint64_t start = bench_now_ns();
+    for (uint32_t r = 0; r < REPEATS; r++) {
+        for (uint32_t i = 0; i < COUNT; i++) {
+            area[i] = shapeMath_circleArea(radius[i]) + shapeMath_triangleArea(base[i], height[i]);
+            perimeter[i] = shapeMath_circlePerimeter(radius[i]);
+        }
+        bench_sink += perimeter[r % COUNT];
+    }
+    bench_report("shapeMath_* (float API)", COUNT, bench_now_ns() - start, REPEATS);
+
+    // 2. Q helpers only: integer arithmetic end to end
+    start = bench_now_ns();
+    for (uint32_t r = 0; r < REPEATS; r++) {
+        for (uint32_t i = 0; i < COUNT; i++) {
+            area_q[i] = shapeMath_circleAreaQ(radius[i]) + shapeMath_triangleAreaQ(base[i], height[i]);
+            perimeter[i] = shapeMath_qToUint(shapeMath_circlePerimeterQ(radius[i]));
+        }
+        bench_sink += perimeter[r % COUNT] + (uint32_t)area_q[r % COUNT];
+    }
+    bench_report("shapeMath_*Q (integer)", COUNT, bench_now_ns() - start, REPEATS);
+
+    free(radius);
+    free(base);
+    free(height);
+    free(area);
+    free(area_q);
+    free(perimeter);
+    return 0;
+}
@@ -0,0 +1,119 @@
+#include "bench_common.h"
+#include <stdlib.h>
+
+#include "shape_pool.h"
+
+/*
+ * Create/destroy churn of a mixed scene: malloc + factory against the slab
+ * pool (direct and through a thread cache, with the locks a shared pool
+ * would take). Each round creates every shape, then frees them in a
+ * shuffled order so the free lists are not simply LIFO.
+ */
+
+#define SCENE_SIZE 1024u
+#define REPEATS 2000u
+
+static factory_config_t configs[SCENE_SIZE];
+static uint32_t free_order[SCENE_SIZE];
+static api_shape_t *shapes[SCENE_SIZE];
+static uint32_t lock_count;
+
+static void bench_lock(void *context)
+{
+    (void)context;
+    lock_count++;
+}
+
+static void bench_unlock(void *context)
+{
+    (void)context;
+}
+
+static void scene_init(void)
+{
+    uint32_t seed = 42;
+    for (uint32_t i = 0; i < SCENE_SIZE; i++) {
+        factory_config_t *conf = &configs[i];
+        conf->shape_conf.type = (shape_type_t)(SHAPE_TYPE_RECTANGLE + (bench_random(&seed) >> 16) % 3);
+        conf->shape_conf.color = (bench_random(&seed) >> 8) & 0xFFFFFFu;
+        conf->shape_conf.visible = true;
+        conf->shape.rect.width = 1 + (bench_random(&seed) >> 16) % 1000;
+        conf->shape.rect.height = 1 + (bench_random(&seed) >> 16) % 1000;
+        if (conf->shape_conf.type == SHAPE_TYPE_CIRCLE) {
+            conf->shape.circle.radius = conf->shape.rect.width;
+        }
+        free_order[i] = i;
+    }
+    for (uint32_t i = SCENE_SIZE - 1; i > 0; i--) {
+        uint32_t j = (bench_random(&seed) >> 16) % (i + 1);
+        uint32_t tmp = free_order[i];
+        free_order[i] = free_order[j];
+        free_order[j] = tmp;
+    }
+}
+
+int main(void)
+{
+    static uint8_t memory[SHAPE_POOL_MEMORY_SIZE(SCENE_SIZE, SCENE_SIZE, SCENE_SIZE)];
+    shape_pool_t pool;
+    shape_pool_config_t pool_conf = {memory, sizeof(memory), {SCENE_SIZE, SCENE_SIZE, SCENE_SIZE},
+                                     bench_lock, bench_unlock, NULL};
+
+    if (!shapePool_init(&pool, &pool_conf)) {
+        printf("  pool init failed\n");
+        return 1;
+    }
+    scene_init();
+
+    printf("Create/free churn, mixed scene\n");
+    uint64_t start = bench_now_ns();
+    for (uint32_t r = 0; r < REPEATS; r++) {
+        for (uint32_t i = 0; i < SCENE_SIZE; i++) {
+            shapes[i] = factory_shape_create(malloc(factory_shape_sizeof(configs[i].shape_conf.type)), &configs[i]);
+        }
+        bench_sink += (uint32_t)shape_get_perimeter(shapes[r % SCENE_SIZE]);
+        for (uint32_t i = 0; i < SCENE_SIZE; i++) {
+            free(shapes[free_order[i]]);
+        }
+    }
+    bench_report("malloc + factory", SCENE_SIZE, bench_now_ns() - start, REPEATS);
+
+    lock_count = 0;
+    start = bench_now_ns();
+    for (uint32_t r = 0; r < REPEATS; r++) {
+        for (uint32_t i = 0; i < SCENE_SIZE; i++) {
+            shapes[i] = shapePool_create(&pool, &configs[i]);
+        }
+        bench_sink += (uint32_t)shape_get_perimeter(shapes[r % SCENE_SIZE]);
+        for (uint32_t i = 0; i < SCENE_SIZE; i++) {
+            shapePool_free(&pool, shapes[free_order[i]]);
+        }
+    }
+    bench_report("shapePool_create", SCENE_SIZE, bench_now_ns() - start, REPEATS);
+    printf("  %-28s %.2f per shape\n", "locks taken", (double)lock_count / (2.0 * SCENE_SIZE * REPEATS));
+
+    shape_pool_cache_t cache;
+    shapePool_cacheInit(&cache, &pool);
+    lock_count = 0;
+    start = bench_now_ns();
+    for (uint32_t r = 0; r < REPEATS; r++) {
+        for (uint32_t i = 0; i < SCENE_SIZE; i++) {
+            shapes[i] = shapePool_cacheCreate(&cache, &configs[i]);
+        }
+        bench_sink += (uint32_t)shape_get_perimeter(shapes[r % SCENE_SIZE]);
+        for (uint32_t i = 0; i < SCENE_SIZE; i++) {
+            shapePool_cacheFree(&cache, shapes[free_order[i]]);
+        }
+    }
+    bench_report("shapePool_cacheCreate", SCENE_SIZE, bench_now_ns() - start, REPEATS);
+    printf("  %-28s %.2f per shape\n", "locks taken", (double)lock_count / (2.0 * SCENE_SIZE * REPEATS));
+    shapePool_cacheFlush(&cache);
+
+    shape_pool_stats_t stats;
+    for (shape_type_t t = SHAPE_TYPE_RECTANGLE; t <= SHAPE_TYPE_TRIANGLE; t++) {
+        shapePool_getStats(&pool, t, &stats);
+        printf("  type %d: capacity %u, high water %u, in use %u\n", (int)t, stats.capacity, stats.high_water,
+               stats.in_use);
+    }
+    return 0;
+}
@@ -0,0 +1,318 @@
+#include "bench_common.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "shape_registry.h"
+#include "api_rectangle.h"
+#include "shape_change.h"
+
+/*
+ * Register a scene, then unregister every shape in a shuffled order.
+ * Unregister by pointer searches and shifts (O(n) each, O(n^2) per round),
+ * so it runs on a smaller scene; unregister by token on an unordered
+ * registry is O(1) each and should stay flat as the scene grows.
+ *
+ * Churn: with a 50k scene registered, replace one shape and run Tasks,
+ * against a full rescan and against the indexed trees.
+ *
+ * Top 10 by area: copy + sort of the shapes against the ordered index.
+ *
+ * Tick: resize a few shapes, then Tasks, with generation polling against
+ * the dirty set fed by the change hook (built with SHAPE_CHANGE_HOOK=1).
+ *
+ * Scaling: one full rescan of a large registry split over 1..N workers
+ * (N = online cores) through a pthread fork/join executor.
+ */
+
+#define BIG_SCENE 1000000u
+#define SMALL_SCENE 16384u
+#define CHURN_SCENE 50000u
+#define CHURN_ROUNDS 2000u
+#define TOP_K 10u
+#define TOP_K_ROUNDS 50u
+#define TICK_CHANGES 16u
+#define TICK_ROUNDS 500u
+#define SCAN_SCENE 500000u
+#define SCAN_REPEATS 20u
+
+typedef struct {
+    factory_job_t job;
+    void *job_context;
+    uint32_t index;
+} worker_t;
+
+static api_rectangle_t *rects;
+static shape_registry_token_t *tokens;
+static uint32_t *order;
+
+static void scene_init(uint32_t n)
+{
+    uint32_t seed = 42;
+    shape_config_t shape_conf = {SHAPE_TYPE_RECTANGLE, 0, true};
+
+    for (uint32_t i = 0; i < n; i++) {
+        rect_config_t rect_conf = {1 + (bench_random(&seed) >> 16) % 1000, 1 + (bench_random(&seed) >> 16) % 1000};
+        api_rectangle_init(&rects[i], &rect_conf, &shape_conf);
+        order[i] = i;
+    }
+    for (uint32_t i = n - 1; i > 0; i--) {
+        uint32_t j = (bench_random(&seed) >> 16) % (i + 1);
+        uint32_t tmp = order[i];
+        order[i] = order[j];
+        order[j] = tmp;
+    }
+}
+
+static void run(const char *name, uint32_t n, bool unordered, bool by_token)
+{
+    size_t memory_size = SHAPE_REGISTRY_MEMORY_SIZE(n);
+    void *memory = malloc(memory_size);
+    shape_registry_t registry;
+    shape_registry_config_t config = {memory, memory_size, n, unordered};
+
+    if (memory == NULL || !shapeRegistry_InstanceInit(&registry, &config)) {
+        printf("  %s: registry init failed\n", name);
+        free(memory);
+        return;
+    }
+
+    scene_init(n);
+    uint64_t start = bench_now_ns();
+    for (uint32_t i = 0; i < n; i++) {
+        shapeRegistry_InstanceRegister(&registry, &rects[i].super, &tokens[i]);
+    }
+    for (uint32_t i = 0; i < n; i++) {
+        if (by_token) {
+            shapeRegistry_InstanceUnregisterToken(&registry, tokens[order[i]]);
+        } else {
+            shapeRegistry_InstanceUnregister(&registry, &rects[order[i]].super);
+        }
+    }
+    bench_report(name, n, bench_now_ns() - start, 1);
+    bench_sink += registry.count;
+    free(memory);
+}
+
+static void run_churn(const char *name, bool indexed)
+{
+    size_t memory_size = SHAPE_REGISTRY_INDEXED_MEMORY_SIZE(CHURN_SCENE);
+    void *memory = malloc(memory_size);
+    shape_registry_t registry;
+    shape_registry_config_t config = {memory, memory_size, CHURN_SCENE, true, indexed};
+    uint32_t seed = 7;
+
+    if (memory == NULL || !shapeRegistry_InstanceInit(&registry, &config)) {
+        printf("  %s: registry init failed\n", name);
+        free(memory);
+        return;
+    }
+
+    scene_init(CHURN_SCENE);
+    for (uint32_t i = 0; i < CHURN_SCENE; i++) {
+        shapeRegistry_InstanceRegister(&registry, &rects[i].super, &tokens[i]);
+    }
+    shapeRegistry_InstanceTasks(&registry);
+
+    uint64_t start = bench_now_ns();
+    for (uint32_t r = 0; r < CHURN_ROUNDS; r++) {
+        uint32_t i = (bench_random(&seed) >> 8) % CHURN_SCENE;
+        shapeRegistry_InstanceUnregisterToken(&registry, tokens[i]);
+        shapeRegistry_InstanceRegister(&registry, &rects[i].super, &tokens[i]);
+        shapeRegistry_InstanceTasks(&registry);
+        bench_sink += (uint32_t)registry.max_perimeter;
+    }
+    // One churn round per "shape" of the report
+    bench_report(name, CHURN_ROUNDS, bench_now_ns() - start, 1);
+    free(memory);
+}
+
+static void *worker_main(void *arg)
+{
+    worker_t *worker = (worker_t *)arg;
+    worker->job(worker->job_context, worker->index);
+    return NULL;
+}
+
+// One thread per job; the caller runs job 0
+static void thread_run_jobs(void *context, factory_job_t job, void *job_context, uint32_t job_count)
+{
+    (void)context;
+    pthread_t threads[SHAPE_REGISTRY_MAX_WORKERS];
+    worker_t workers[SHAPE_REGISTRY_MAX_WORKERS];
+
+    for (uint32_t j = 1; j < job_count; j++) {
+        workers[j] = (worker_t){job, job_context, j};
+        pthread_create(&threads[j], NULL, worker_main, &workers[j]);
+    }
+    job(job_context, 0);
+    for (uint32_t j = 1; j < job_count; j++) {
+        pthread_join(threads[j], NULL);
+    }
+}
+
+static void run_scaling(void)
+{
+    size_t memory_size = SHAPE_REGISTRY_MEMORY_SIZE(SCAN_SCENE);
+    void *memory = malloc(memory_size);
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    uint32_t max_workers = (cores > 0 && cores < (long)SHAPE_REGISTRY_MAX_WORKERS) ? (uint32_t)cores
+                                                                                   : SHAPE_REGISTRY_MAX_WORKERS;
+    factory_executor_t executor = {thread_run_jobs, NULL, 0};
+    api_shape_t *serial_area = NULL;
+
+    if (memory == NULL) {
+        printf("  scaling: out of memory\n");
+        return;
+    }
+
+    scene_init(SCAN_SCENE);
+    for (uint32_t workers = 1; workers <= max_workers; workers++) {
+        shape_registry_t registry;
+        shape_registry_config_t config = {memory, memory_size, SCAN_SCENE};
+        config.executor = &executor;
+        config.workers = workers;
+        shapeRegistry_InstanceInit(&registry, &config);
+        for (uint32_t i = 0; i < SCAN_SCENE; i++) {
+            shapeRegistry_InstanceRegister(&registry, &rects[i].super, NULL);
+        }
+
+        uint64_t start = bench_now_ns();
+        for (uint32_t r = 0; r < SCAN_REPEATS; r++) {
+            shapeRegistry_InstanceUpdate(&registry, 0); // Forces the full rescan
+            shapeRegistry_InstanceTasks(&registry);
+        }
+        char name[32];
+        snprintf(name, sizeof(name), "%u worker(s)", workers);
+        bench_report(name, SCAN_SCENE, bench_now_ns() - start, SCAN_REPEATS);
+
+        // Same answer on any worker count
+        serial_area = (workers == 1) ? registry.biggestArea : serial_area;
+        if (registry.biggestArea != serial_area) {
+            printf("  mismatch with %u workers\n", workers);
+        }
+    }
+    free(memory);
+}
+
+static int compare_area_desc(const void *a, const void *b)
+{
+    float area_a = shape_get_area(*(api_shape_t * const *)a);
+    float area_b = shape_get_area(*(api_shape_t * const *)b);
+    return (area_a < area_b) - (area_a > area_b);
+}
+
+static void run_top_k(void)
+{
+    size_t memory_size = SHAPE_REGISTRY_INDEXED_MEMORY_SIZE(CHURN_SCENE);
+    void *memory = malloc(memory_size);
+    api_shape_t **sorted = malloc(CHURN_SCENE * sizeof(api_shape_t *));
+    api_shape_t *top[TOP_K];
+    shape_registry_t registry;
+    shape_registry_config_t config = {memory, memory_size, CHURN_SCENE, true, true};
+
+    if (memory == NULL || sorted == NULL || !shapeRegistry_InstanceInit(&registry, &config)) {
+        printf("  top-k: registry init failed\n");
+        free(memory);
+        free(sorted);
+        return;
+    }
+
+    scene_init(CHURN_SCENE);
+    for (uint32_t i = 0; i < CHURN_SCENE; i++) {
+        shapeRegistry_InstanceRegister(&registry, &rects[i].super, NULL);
+    }
+
+    uint64_t start = bench_now_ns();
+    for (uint32_t r = 0; r < TOP_K_ROUNDS; r++) {
+        memcpy(sorted, registry.api_shapes, registry.count * sizeof(api_shape_t *));
+        qsort(sorted, registry.count, sizeof(api_shape_t *), compare_area_desc);
+        bench_sink += (uint32_t)shape_get_area(sorted[0]);
+    }
+    bench_report("copy + qsort", TOP_K_ROUNDS, bench_now_ns() - start, 1);
+
+    start = bench_now_ns();
+    for (uint32_t r = 0; r < TOP_K_ROUNDS; r++) {
+        bench_sink += shapeRegistry_TopK(&registry, SHAPE_REGISTRY_KEY_AREA, TOP_K, top);
+    }
+    bench_report("shapeRegistry_TopK", TOP_K_ROUNDS, bench_now_ns() - start, 1);
+
+    free(memory);
+    free(sorted);
+}
+
+static void run_ticks(const char *name, bool track_changes)
+{
+    size_t memory_size = SHAPE_REGISTRY_FULL_MEMORY_SIZE(CHURN_SCENE);
+    void *memory = malloc(memory_size);
+    shape_registry_t registry;
+    shape_registry_config_t config = {memory, memory_size, CHURN_SCENE, false, false, track_changes};
+    uint32_t seed = 3;
+
+    if (memory == NULL || !shapeRegistry_InstanceInit(&registry, &config)) {
+        printf("  %s: registry init failed\n", name);
+        free(memory);
+        return;
+    }
+
+    scene_init(CHURN_SCENE);
+    for (uint32_t i = 0; i < CHURN_SCENE; i++) {
+        shapeRegistry_InstanceRegister(&registry, &rects[i].super, NULL);
+    }
+    shapeRegistry_InstanceTasks(&registry);
+    if (track_changes) {
+        shapeChange_addHook(shapeRegistry_ChangeHook, &registry);
+    }
+
+    uint64_t start = bench_now_ns();
+    for (uint32_t r = 0; r < TICK_ROUNDS; r++) {
+        for (uint32_t c = 0; c < TICK_CHANGES; c++) {
+            uint32_t i = (bench_random(&seed) >> 8) % CHURN_SCENE;
+            rect_updateHeight(&rects[i].rect, 1 + (bench_random(&seed) >> 16) % 1000);
+        }
+        shapeRegistry_InstanceTasks(&registry);
+        bench_sink += registry.max_perimeter;
+    }
+    // One tick per "shape" of the report
+    bench_report(name, TICK_ROUNDS, bench_now_ns() - start, 1);
+
+    shapeChange_removeAll();
+    free(memory);
+}
+
+int main(void)
+{
+    rects = malloc(BIG_SCENE * sizeof(api_rectangle_t));
+    tokens = malloc(BIG_SCENE * sizeof(shape_registry_token_t));
+    order = malloc(BIG_SCENE * sizeof(uint32_t));
+    if (rects == NULL || tokens == NULL || order == NULL) {
+        printf("  out of memory\n");
+        return 1;
+    }
+
+    printf("Register + unregister every shape, shuffled order\n");
+    run("pointer, ordered", SMALL_SCENE, false, false);
+    run("token, ordered", SMALL_SCENE, false, true);
+    run("token, unordered", SMALL_SCENE, true, true);
+    run("token, unordered", BIG_SCENE, true, true);
+
+    printf("Churn: replace one shape + Tasks, %u shapes registered\n", CHURN_SCENE);
+    run_churn("full rescan", false);
+    run_churn("indexed trees", true);
+
+    printf("Top %u by area, %u shapes registered (one query per \"shape\")\n", TOP_K, CHURN_SCENE);
+    run_top_k();
+
+    printf("Tick: %u resizes + Tasks, %u shapes registered\n", TICK_CHANGES, CHURN_SCENE);
+    run_ticks("generation poll", false);
+    run_ticks("change hook dirty set", true);
+
+    printf("Full rescan, %u shapes, split over workers\n", SCAN_SCENE);
+    run_scaling();
+
+    free(rects);
+    free(tokens);
+    free(order);
+    return 0;
+}
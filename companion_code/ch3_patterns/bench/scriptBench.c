@@ -0,0 +1,153 @@
+#include "bench_common.h"
+#include <stdlib.h>
+#include <string.h>
+
+#include "shape_script.h"
+
+/*
+ * Scripted scene updates: one shapeScript_run() over a command stream
+ * versus the equivalent direct API calls issued one by one.
+ * Build with SHAPE_SCRIPT_COMPUTED_GOTO=0 to compare the switch dispatch.
+ */
+
+#define SLOTS 256u
+#define COMMANDS 100000u
+#define REPEATS 50u
+
+typedef struct {
+    uint8_t op;
+    uint8_t slot;
+    uint32_t a;
+    uint32_t b;
+} command_t;
+
+static const char *const g_op_names[SHAPE_OP_COUNT] = {
+    "end", "rectangle", "circle", "triangle", "resize", "set_color", "set_visible",
+    "canvas_add", "canvas_move", "canvas_remove", "canvas_task", "register",
+};
+
+static api_shape_storage_t g_slots[SLOTS];
+static api_shape_storage_t g_direct[SLOTS];
+
+// Same effect as the RESIZE/SET_COLOR/SET_VISIBLE handlers
+static void run_direct(const command_t *commands, uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++) {
+        api_shape_storage_t *s = &g_direct[commands[i].slot];
+        switch (commands[i].op) {
+            case SHAPE_OP_RESIZE:
+                if (s->super.base.type == SHAPE_TYPE_RECTANGLE) {
+                    rect_updateDimensions(&s->api_rectangle.rect, commands[i].a, commands[i].b);
+                } else if (s->super.base.type == SHAPE_TYPE_CIRCLE) {
+                    circle_updateRadius(s->api_circle.circle, commands[i].a);
+                } else {
+                    triangle_updateDimensions(&s->api_triangle.triangle, commands[i].a, commands[i].b);
+                }
+                break;
+            case SHAPE_OP_SET_COLOR:
+                s->super.base.color = commands[i].a;
+                break;
+            default:
+                s->super.base.visible = (commands[i].a != 0);
+                break;
+        }
+    }
+}
+
+int main(void)
+{
+    uint32_t seed = 42;
+    size_t capacity = 16u * SLOTS + 10u * COMMANDS;
+    uint8_t *setup = malloc(16u * SLOTS);
+    uint8_t *updates = malloc(capacity);
+    command_t *commands = malloc(COMMANDS * sizeof(command_t));
+
+    if (!setup || !updates || !commands) {
+        printf("  out of memory\n");
+        return 1;
+    }
+
+    shape_script_t script;
+    shape_script_config_t config = {g_slots, SLOTS};
+    shapeScript_init(&script, &config);
+
+    // 1. Scene setup: one create command per slot, mixed types
+    shape_script_writer_t writer;
+    shapeScript_writerInit(&writer, setup, 16u * SLOTS);
+    for (uint32_t i = 0; i < SLOTS; i++) {
+        shape_config_t shape = {(shape_type_t)(SHAPE_TYPE_RECTANGLE + i % 3), 0, true};
+        rect_config_t rect = {1 + i, 2 + i};
+        circle_config_t circle = {1 + i};
+        triangle_config_t tri = {1 + i, 2 + i};
+        if (shape.type == SHAPE_TYPE_RECTANGLE) {
+            shapeScript_emitRectangle(&writer, (uint8_t)i, &rect, &shape);
+        } else if (shape.type == SHAPE_TYPE_CIRCLE) {
+            shapeScript_emitCircle(&writer, (uint8_t)i, &circle, &shape);
+        } else {
+            shapeScript_emitTriangle(&writer, (uint8_t)i, &tri, &shape);
+        }
+    }
+    shapeScript_run(&script, setup, writer.size);
+    for (uint32_t i = 0; i < SLOTS; i++) {
+        memcpy(&g_direct[i], &g_slots[i], sizeof(api_shape_storage_t));
+        if (g_direct[i].super.base.type == SHAPE_TYPE_CIRCLE) {
+            g_direct[i].api_circle.circle = (hCircle_t)&g_direct[i].api_circle.mem;
+        }
+    }
+
+    // 2. Update stream: random mix of resize / color / visibility commands
+    shapeScript_writerInit(&writer, updates, capacity);
+    for (uint32_t i = 0; i < COMMANDS; i++) {
+        uint32_t kind = (bench_random(&seed) >> 16) % 4; // High bits: the low ones have a short period
+        command_t *c = &commands[i];
+        c->slot = (uint8_t)(bench_random(&seed) % SLOTS);
+        c->a = 1 + bench_random(&seed) % 1000;
+        c->b = 1 + bench_random(&seed) % 1000;
+        if (kind <= 1) {
+            c->op = SHAPE_OP_RESIZE;
+            shapeScript_emitResize(&writer, c->slot, c->a, c->b);
+        } else if (kind == 2) {
+            c->op = SHAPE_OP_SET_COLOR;
+            shapeScript_emitSetColor(&writer, c->slot, c->a);
+        } else {
+            c->op = SHAPE_OP_SET_VISIBLE;
+            c->a &= 1;
+            shapeScript_emitSetVisible(&writer, c->slot, c->a != 0);
+        }
+    }
+
+    shapeScript_resetCounters(&script);
+    uint64_t start = bench_now_ns();
+    for (uint32_t r = 0; r < REPEATS; r++) {
+        if (!shapeScript_run(&script, updates, writer.size)) {
+            printf("  script failed at offset %zu\n", script.error_offset);
+            return 1;
+        }
+        bench_sink += g_slots[r % SLOTS].super.base.color;
+    }
+    uint64_t scripted = bench_now_ns() - start;
+
+    start = bench_now_ns();
+    for (uint32_t r = 0; r < REPEATS; r++) {
+        run_direct(commands, COMMANDS);
+        bench_sink += g_direct[r % SLOTS].super.base.color;
+    }
+    uint64_t direct = bench_now_ns() - start;
+
+    printf("Command stream benchmark (%s dispatch, %zu bytes)\n",
+           SHAPE_SCRIPT_COMPUTED_GOTO ? "computed goto" : "switch", writer.size);
+    bench_report("shapeScript_run", COMMANDS, scripted, REPEATS);
+    bench_report("direct API calls", COMMANDS, direct, REPEATS);
+    printf("  opcode counts:");
+    for (uint32_t op = 0; op < SHAPE_OP_COUNT; op++) {
+        if (script.op_counts[op] != 0) {
+            printf(" %s=%u", g_op_names[op], script.op_counts[op]);
+        }
+    }
+    printf("\n\n");
+
+    free(setup);
+    free(updates);
+    free(commands);
+    return 0;
+}
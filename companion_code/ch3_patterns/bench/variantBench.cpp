@@ -0,0 +1,62 @@
+#include "bench_common.h"
+#include <vector>
+
+#include "shape_variant.hpp"
+
+/*
+ * C vtable dispatch (shape_get_area over api_shape_t pointers) versus the
+ * header-only C++ layer (std::visit over cdp::shape_variant values).
+ * Same shapes, same interleaved type order in both runs.
+ */
+
+#define COUNT 100000u
+#define REPEATS 200u
+
+int main(void)
+{
+    uint32_t seed = 42;
+    std::vector<cdp::shape_variant> shapes;
+    std::vector<api_shape_t *> c_shapes;
+    shapes.reserve(COUNT);
+    c_shapes.reserve(COUNT);
+
+    for (uint32_t i = 0; i < COUNT; i++) {
+        uint32_t a = 1 + bench_random(&seed) % 1000;
+        uint32_t b = 1 + bench_random(&seed) % 1000;
+        switch (bench_random(&seed) % 3) {
+            case 0: shapes.emplace_back(cdp::rectangle({a, b})); break;
+            case 1: shapes.emplace_back(cdp::circle({a})); break;
+            default: shapes.emplace_back(cdp::triangle({a, b})); break;
+        }
+    }
+    // Filled after the vector stopped growing: the C pointers stay valid
+    for (auto &shape : shapes) {
+        c_shapes.push_back(cdp::api(shape));
+    }
+
+    printf("C vtable vs. C++ variant dispatch (%s)\n", API_SHAPE_DEVIRTUALIZE ? "switch" : "vtable");
+
+    // 1. C dispatch through api_shape.c
+    uint64_t start = bench_now_ns();
+    for (uint32_t r = 0; r < REPEATS; r++) {
+        float total = 0.0f;
+        for (uint32_t i = 0; i < COUNT; i++) {
+            total += shape_get_area(c_shapes[i]) + (float)shape_get_perimeter(c_shapes[i]);
+        }
+        bench_sink += (uint32_t)total;
+    }
+    bench_report("C shape_get_* (api_shape.c)", COUNT, bench_now_ns() - start, REPEATS);
+
+    // 2. std::visit over the variants
+    start = bench_now_ns();
+    for (uint32_t r = 0; r < REPEATS; r++) {
+        float total = 0.0f;
+        for (const auto &shape : shapes) {
+            total += cdp::area(shape) + (float)cdp::perimeter(shape);
+        }
+        bench_sink += (uint32_t)total;
+    }
+    bench_report("cdp::area/perimeter (visit)", COUNT, bench_now_ns() - start, REPEATS);
+
+    return 0;
+}
@@ -12,4 +12,21 @@ typedef struct {
 
 void api_circle_init(api_circle_t *self, circle_config_t *circle_conf, shape_config_t *shape_conf);
 
+// Static initialization (see api_rectangle.h). The handle points into the
+// object itself, so the macro needs the name of the object being defined:
+// static const api_circle_t c = API_CIRCLE_STATIC_INIT(c, 5, 0x00FF00, true);
+#define API_CIRCLE_STATIC_INIT(self, radius, color, visible)                                   \
+    {                                                                                          \
+        .super = API_SHAPE_STATIC_INIT(SHAPE_TYPE_CIRCLE, color, visible, &api_circle_vtable), \
+        .mem = CIRCLE_MEMORY_STATIC_INIT(radius),                                              \
+        .circle = (hCircle_t)&(self).mem                                                       \
+    }
+
+// VTable and its implementations
+extern const shape_vtable_t api_circle_vtable;
+void api_circle_draw(api_shape_t *self);
+float api_circle_get_area(api_shape_t *self);
+uint32_t api_circle_get_perimeter(api_shape_t *self);
+uint32_t api_circle_get_generation(api_shape_t *self);
+
 #endif // API_CIRCLE_H
@@ -13,4 +13,22 @@ typedef struct {
 // We need config for shape (base), config for rect, and we set the vtable internally
 void api_rectangle_init(api_rectangle_t *self, rect_config_t *rect_conf, shape_config_t *shape_conf);
 
+/*
+ * Static initialization: a fully initialized object with no runtime code,
+ * e.g. static const api_rectangle_t r = API_RECTANGLE_STATIC_INIT(10, 20, 0xFF0000, true);
+ * const objects can live in flash; never pass them to a mutator.
+ */
+#define API_RECTANGLE_STATIC_INIT(width, height, color, visible)                                     \
+    {                                                                                                \
+        .super = API_SHAPE_STATIC_INIT(SHAPE_TYPE_RECTANGLE, color, visible, &api_rectangle_vtable), \
+        .rect = RECT_STATIC_INIT(width, height)                                                      \
+    }
+
+// VTable and its implementations, shared with the devirtualized dispatch in api_shape.c
+extern const shape_vtable_t api_rectangle_vtable;
+void api_rectangle_draw(api_shape_t *self);
+float api_rectangle_get_area(api_shape_t *self);
+uint32_t api_rectangle_get_perimeter(api_shape_t *self);
+uint32_t api_rectangle_get_generation(api_shape_t *self);
+
 #endif // API_RECTANGLE_H
@@ -3,6 +3,16 @@
 
 #include "shape.h"
 
+/*
+ * Build option: 1 = shape_draw/get_area/get_perimeter switch on the shape
+ * type (see api_shape_types.h) and call the in-tree implementations
+ * directly, so the compiler can inline them (enable LTO across files).
+ * Shapes whose vptr is not the in-tree vtable still use the vtable.
+ */
+#ifndef API_SHAPE_DEVIRTUALIZE
+#define API_SHAPE_DEVIRTUALIZE 0
+#endif
+
 // Forward declaration
 struct api_shape;
 
@@ -11,6 +21,13 @@ typedef struct {
    void (*draw)(struct api_shape *self);
    float (*get_area)(struct api_shape *self);
    uint32_t (*get_perimeter)(struct api_shape *self);
+   // Optional batch slots (may be NULL): every shape passed shares this vtable
+   void (*get_area_many)(struct api_shape **shapes, uint32_t n, float *out);
+   void (*get_perimeter_many)(struct api_shape **shapes, uint32_t n, uint32_t *out);
+   // Optional (may be NULL): counter that changes whenever area/perimeter may have changed
+   uint32_t (*get_generation)(struct api_shape *self);
+   // Optional (may be NULL): key the mutators report to the change hook (see shape_change.h)
+   const void *(*get_change_key)(struct api_shape *self);
 } shape_vtable_t;
 
 // 2. Base API structure (Inherits shape_t)
@@ -22,9 +39,34 @@ typedef struct api_shape {
 // 3. Initialization
 void api_shape_init(api_shape_t *self, shape_config_t *config, const shape_vtable_t *vptr);
 
+// Compile-time equivalent of api_shape_init: vptr resolved by the linker
+#define API_SHAPE_STATIC_INIT(type_, color_, visible_, vptr_) \
+   { .base = SHAPE_STATIC_INIT(type_, color_, visible_), .vptr = (vptr_) }
+
 // 4. Polymorphic API Wrapper functions
 void shape_draw(api_shape_t *self);
 float shape_get_area(api_shape_t *self);
 uint32_t shape_get_perimeter(api_shape_t *self);
 
+// 5. Batch dispatch: groups shapes by vptr and calls each batch slot once per group.
+// Types without batch slots fall back to the per-object calls. out[i] matches shapes[i].
+void shape_get_area_many(api_shape_t **shapes, uint32_t n, float *out);
+void shape_get_perimeter_many(api_shape_t **shapes, uint32_t n, uint32_t *out);
+
+// 6. Change tracking: false when the shape type does not track generations
+bool shape_get_generation(api_shape_t *self, uint32_t *generation);
+
+// NULL when the type has no change key of its own
+const void *shape_get_change_key(api_shape_t *self);
+
+// 7. Area and perimeter from the same update (retries while a writer is active,
+// see shape_seqlock.h). False when the type has no generation to check against.
+typedef struct {
+   float area;
+   uint32_t perimeter;
+   uint32_t generation;
+} shape_snapshot_t;
+
+bool shape_get_snapshot(api_shape_t *self, shape_snapshot_t *snapshot);
+
 #endif // API_SHAPE_H
@@ -0,0 +1,32 @@
+#ifndef API_SHAPE_TYPES_H
+#define API_SHAPE_TYPES_H
+
+#include "api_rectangle.h"
+#include "api_circle.h"
+#include "api_triangle.h"
+
+/*
+ * X-Macro list of the in-tree api_shape types.
+ * X(type_enum, prefix, object_type) where prefix names the vtable
+ * (prefix##_vtable) and the implementations (prefix##_get_area, ...).
+ * Adding a type here is enough for every generated switch to pick it up.
+ */
+#define API_SHAPE_TYPE_LIST(X)                                  \
+    X(SHAPE_TYPE_RECTANGLE, api_rectangle, api_rectangle_t)     \
+    X(SHAPE_TYPE_CIRCLE, api_circle, api_circle_t)              \
+    X(SHAPE_TYPE_TRIANGLE, api_triangle, api_triangle_t)
+
+/*
+ * One storage slot that fits (and is aligned for) any in-tree type, so a
+ * heterogeneous scene can be a single contiguous array of slots:
+ *   api_shape_storage_t scene[N];
+ *   factory_shape_create(&scene[i].super, &config);
+ */
+#define API_SHAPE_STORAGE_MEMBER(type, prefix, object) object prefix;
+
+typedef union {
+    api_shape_t super; // Common prefix of every member
+    API_SHAPE_TYPE_LIST(API_SHAPE_STORAGE_MEMBER)
+} api_shape_storage_t;
+
+#endif // API_SHAPE_TYPES_H
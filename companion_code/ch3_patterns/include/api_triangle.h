@@ -11,4 +11,18 @@ typedef struct {
 
 void api_triangle_init(api_triangle_t *self, triangle_config_t *tri_conf, shape_config_t * shape_conf);
 
+// Static initialization (see api_rectangle.h)
+#define API_TRIANGLE_STATIC_INIT(base, height, color, visible)                                     \
+    {                                                                                              \
+        .super = API_SHAPE_STATIC_INIT(SHAPE_TYPE_TRIANGLE, color, visible, &api_triangle_vtable), \
+        .triangle = TRIANGLE_STATIC_INIT(base, height)                                             \
+    }
+
+// VTable and its implementations
+extern const shape_vtable_t api_triangle_vtable;
+void api_triangle_draw(api_shape_t *self);
+float api_triangle_get_area(api_shape_t *self);
+uint32_t api_triangle_get_perimeter(api_shape_t *self);
+uint32_t api_triangle_get_generation(api_shape_t *self);
+
 #endif // API_TRIANGLE_H
@@ -46,4 +46,8 @@ void canvas_moveShape(api_shape_t *shape, int16_t target_x, int16_t target_y);
 void canvas_task(void);
 bool canvas_isMoving(api_shape_t *shape);
 
+// Scales every position (and pending target) about the origin, then adds (dx, dy).
+// Applied at once: positions saturate to int16 and no position callback fires.
+void canvas_transform(float scale, int16_t dx, int16_t dy);
+
 #endif /* CANVAS_H */
@@ -3,12 +3,15 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "shape_math.h"
 
 // We must expose the SIZE so the user can allocate memory.
 // Note: If the internal struct grows, this must be updated manually.
-#define CIRCLE_SIZE    (2)      // 2 elements 
-typedef struct {
+#define CIRCLE_SIZE    (4)      // 4 elements 
+typedef union {
     uint32_t _reserved[CIRCLE_SIZE];
+    // Typed view used only by CIRCLE_MEMORY_STATIC_INIT (checked against the private struct)
+    struct { uint32_t _radius; float _area; uint32_t _perimeter; uint32_t _generation; } _init;
 } circle_memory_t;
 
 // The Opaque Handle
@@ -19,6 +22,18 @@ typedef struct {
     uint32_t radius;
 } circle_config_t;
 
+// Compile-time initializer of the raw storage with the values circle_init would compute.
+// The handle of such a circle is simply (hCircle_t)&memory.
+#define CIRCLE_MEMORY_STATIC_INIT(r)                        \
+    {                                                       \
+        ._init = {                                          \
+            ._radius = (r),                                 \
+            ._area = SHAPE_MATH_CIRCLE_AREA(r),             \
+            ._perimeter = SHAPE_MATH_CIRCLE_PERIMETER(r),   \
+            ._generation = 0                                \
+        }                                                   \
+    }
+
 // Initialization now takes a pointer to the RAW storage
 hCircle_t circle_init(circle_memory_t *mem, circle_config_t *config);
 
@@ -28,4 +43,12 @@ uint32_t circle_getRadius(hCircle_t self);
 
 float circle_getArea(hCircle_t self);
 
+uint32_t circle_getPerimeter(hCircle_t self);
+
+// Changes every time the radius is updated
+uint32_t circle_getGeneration(hCircle_t self);
+
+// What circle_updateRadius reports to the change hook (see shape_change.h)
+const void *circle_getChangeKey(hCircle_t self);
+
 #endif // CIRCLE_H
\ No newline at end of file
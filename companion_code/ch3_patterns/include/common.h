@@ -2,8 +2,40 @@
 #define COMMON_H
 
 #include <stddef.h>
+#include <stdint.h>
 
 #define CONTAINER_OF(ptr, type, member) \
     ((type *)((char *)(ptr) - offsetof(type, member)))
 
-#endif
\ No newline at end of file
+/* Alignment requirement of a type (C99 has no _Alignof) */
+#define ALIGNOF(type) offsetof(struct { char c; type member; }, member)
+
+/* Compile-time check, usable at file scope. C99 fallback: a false
+ * condition declares an array of negative size. 'name' must be a valid
+ * identifier and unique within the file. */
+#if defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L)
+#define STATIC_ASSERT(cond, name) _Static_assert(cond, #name)
+#else
+#define STATIC_ASSERT(cond, name) typedef char static_assert_##name[(cond) ? 1 : -1]
+#endif
+
+/* Bytes from 'address' up to the next multiple of 'align' (any align > 0) */
+#define ALIGN_PADDING(address, align) (((align) - ((uintptr_t)(address) % (align))) % (align))
+
+/* Takes 'size' bytes aligned to 'align' from the front of a caller buffer:
+ * NULL (and nothing taken) when the rest of the buffer is too small. */
+static inline void *common_carve(uint8_t **cursor, size_t *remaining, size_t size, size_t align)
+{
+    size_t padding = ALIGN_PADDING(*cursor, align);
+
+    if (*remaining < padding || *remaining - padding < size) {
+        return NULL;
+    }
+
+    void *block = *cursor + padding;
+    *cursor += padding + size;
+    *remaining -= padding + size;
+    return block;
+}
+
+#endif
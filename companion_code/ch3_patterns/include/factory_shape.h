@@ -5,6 +5,9 @@
 #include "api_rectangle.h"
 #include "api_circle.h"
 #include "api_triangle.h"
+#include "api_shape_types.h"
+#include "shape_executor.h"
+#include <stddef.h>
 
 typedef struct {
     shape_config_t shape_conf;
@@ -17,4 +20,25 @@ typedef struct {
 
 api_shape_t* factory_shape_create(api_shape_t * shape, factory_config_t *config);
 
+// Storage the factory needs for a type (0 if the type is unknown).
+// api_shape_storage_t fits every type.
+size_t factory_shape_sizeof(shape_type_t type);
+size_t factory_shape_alignof(shape_type_t type);
+
+/*
+ * Bulk creation. Configs are partitioned by type (counting sort) and each
+ * type is constructed as one contiguous run of storage slots: rectangles
+ * first, then circles, then triangles. shapes[i] points at the object made
+ * from configs[i] (NULL for an unknown type), so the array keeps the
+ * config order and is ready for registration.
+ * storage needs one slot per config. Returns the number of shapes created.
+ */
+#ifndef FACTORY_CREATE_MANY_GRAIN
+#define FACTORY_CREATE_MANY_GRAIN 4096u // Default shapes per parallel job (executor->grain == 0)
+#endif
+
+// executor may be NULL: the whole batch is built on the calling thread
+uint32_t factory_shape_create_many(factory_config_t *configs, uint32_t n, api_shape_storage_t *storage,
+                                   api_shape_t **shapes, const factory_executor_t *executor);
+
 #endif
\ No newline at end of file
@@ -2,12 +2,15 @@
 #define RECTANGLE_H
 
 #include <stdint.h>
+#include "shape_math.h"
 
 // Object structure definition
 typedef struct {
    uint32_t width;
    uint32_t height;
-   const uint32_t area;
+   const uint32_t area;        // Dependent state (cached)
+   const uint32_t perimeter;   // Dependent state (cached)
+   const uint32_t generation;  // Bumped by every mutator (see shape_seqlock.h)
 } rectangle_t;
 
 // Object configuration structure definition (CS-06)
@@ -17,10 +20,27 @@ typedef struct
 	uint32_t height;
 }rect_config_t;
 
+// Compile-time initializer with the values rect_init would compute (const/ROM objects)
+#define RECT_STATIC_INIT(w, h)                          \
+    {                                                   \
+        .width = (w),                                   \
+        .height = (h),                                  \
+        .area = (uint32_t)(w) * (uint32_t)(h),          \
+        .perimeter = SHAPE_MATH_RECT_PERIMETER(w, h),   \
+        .generation = 0                                 \
+    }
+
 void rect_init(rectangle_t *self, rect_config_t * conf);
 
 uint32_t rect_get_area(rectangle_t *self);
 
+uint32_t rect_get_perimeter(rectangle_t *self);
+
 void rect_updateWidth(rectangle_t *self, uint32_t newWidth);
 
+void rect_updateHeight(rectangle_t *self, uint32_t newHeight);
+
+// Both sides in one update: readers never see the new width with the old height
+void rect_updateDimensions(rectangle_t *self, uint32_t newWidth, uint32_t newHeight);
+
 #endif // RECTANGLE_H
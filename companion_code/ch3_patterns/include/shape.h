@@ -29,6 +29,10 @@ typedef struct
    bool visible;
 }shape_config_t;
 
+// Compile-time equivalent of shape_init
+#define SHAPE_STATIC_INIT(type_, color_, visible_) \
+   { .type = (type_), .color = (color_), .visible = (visible_) }
+
 void shape_init(shape_t *self, shape_config_t *config);
 
 #endif // SHAPE_BASE_H
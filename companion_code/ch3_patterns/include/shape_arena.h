@@ -0,0 +1,58 @@
+#ifndef SHAPE_ARENA_H
+#define SHAPE_ARENA_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "factory_shape.h"
+#include "canvas.h"
+
+/*
+ * Scene arena: a bump allocator over one caller-provided block. Shapes,
+ * observer nodes and any other per-scene data are carved from it in O(1)
+ * and shapeArena_reset() discards all of them at once; there is no
+ * per-object free.
+ *
+ * Scene mode (config->canvas != NULL): the arena owns the scene. init and
+ * reset also reinitialize the canvas and registry singletons, so no
+ * canvas item, observer or registry entry can outlive the memory it
+ * points into. Without scene mode the caller must remove arena objects
+ * from the canvas/registry before resetting.
+ */
+
+typedef struct {
+    uint8_t *base;
+    size_t size;
+    size_t used;
+    size_t high_water;      // Largest 'used' seen since init
+    bool owns_scene;
+    canvas_config_t canvas; // Reapplied on every reset in scene mode
+} shape_arena_t;
+
+// Configuration Struct (CS-06)
+typedef struct {
+    void *memory;                   // Caller provided storage
+    size_t memory_size;             // Size in bytes of memory
+    const canvas_config_t *canvas;  // Optional: enables scene mode
+} shape_arena_config_t;
+
+bool shapeArena_init(shape_arena_t *self, const shape_arena_config_t *config);
+
+// 'align' must be a power of two. NULL when the arena is full.
+void *shapeArena_alloc(shape_arena_t *self, size_t size, size_t align);
+
+// Allocates exactly the storage of the type and runs the factory
+api_shape_t *shapeArena_create(shape_arena_t *self, factory_config_t *config);
+
+// Allocates an observer node and registers it with the canvas
+canvas_move_observer_t *shapeArena_addMoveObserver(shape_arena_t *self, canvas_moveCallback_t callback,
+                                                   void *context);
+
+// Discards every allocation (and the scene in scene mode) in O(1)
+void shapeArena_reset(shape_arena_t *self);
+
+size_t shapeArena_getUsed(const shape_arena_t *self);
+size_t shapeArena_getHighWater(const shape_arena_t *self);
+
+#endif // SHAPE_ARENA_H
@@ -0,0 +1,35 @@
+#ifndef SHAPE_BATCH_H
+#define SHAPE_BATCH_H
+
+#include <stdint.h>
+
+#include "shape.h"
+
+/*
+ * Batch geometry kernels.
+ * Compute area/perimeter for whole arrays of one shape type at once
+ * (e.g. the lanes of a shape_store_t) and rescale dimension arrays.
+ * Results are bit-identical to the per-object formulas in shape_math.h.
+ *
+ * Backend is selected at compile time: AVX2 when the compiler targets it,
+ * SSE2 on any other x86-64 build, portable scalar code elsewhere.
+ * Define SHAPE_BATCH_USE_SIMD=0 to force the scalar fallback (implied by
+ * SHAPE_MATH_FIXED_POINT=1).
+ */
+
+#ifndef SHAPE_BATCH_USE_SIMD
+#define SHAPE_BATCH_USE_SIMD 1
+#endif
+
+// dim_a: width | radius | base, dim_b: height | unused (may be NULL) | height
+void shape_get_area_n(shape_type_t type, const uint32_t *dim_a, const uint32_t *dim_b, float *out, uint32_t n);
+
+void shape_get_perimeter_n(shape_type_t type, const uint32_t *dim_a, const uint32_t *dim_b, uint32_t *out, uint32_t n);
+
+// Scales dimensions in place, bit-identical to shapeMath_scaleDim()
+void shape_scale_n(uint32_t *dim, float scale, uint32_t n);
+
+// Name of the compiled backend ("avx2", "sse2" or "scalar")
+const char *shapeBatch_getBackend(void);
+
+#endif // SHAPE_BATCH_H
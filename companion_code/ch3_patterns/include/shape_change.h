@@ -0,0 +1,48 @@
+#ifndef SHAPE_CHANGE_H
+#define SHAPE_CHANGE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Change hook (opt-in).
+ *
+ * Build option SHAPE_CHANGE_HOOK=1: every mutator reports its object when
+ * the update is done (from shapeSeqlock_writeEnd). The key is the address
+ * of the object's generation counter; shape_get_change_key() returns the
+ * same address for an api_shape, so a consumer such as a registry can
+ * queue just the modified shapes instead of polling all of them. Store
+ * handles all return their store's counter: one batch update is one
+ * notify for every handle.
+ *
+ * Up to SHAPE_CHANGE_MAX_HOOKS (hook, context) pairs, called in the order
+ * they were added, so several registries can track changes at once (one
+ * shapeRegistry_ChangeHook per registry). Hooks run in the mutating
+ * thread, inside the update call, and must be short. Add and remove them
+ * while no mutator runs.
+ *
+ * SHAPE_CHANGE_HOOK=0 (default): mutators make no call at all.
+ */
+
+#ifndef SHAPE_CHANGE_HOOK
+#define SHAPE_CHANGE_HOOK 0
+#endif
+
+#ifndef SHAPE_CHANGE_MAX_HOOKS
+#define SHAPE_CHANGE_MAX_HOOKS 4u
+#endif
+
+typedef void (*shape_change_hook_t)(void *context, const void *key);
+
+// False when the list is full or the same pair is already installed
+bool shapeChange_addHook(shape_change_hook_t hook, void *context);
+
+// False when the pair is not installed
+bool shapeChange_removeHook(shape_change_hook_t hook, void *context);
+
+void shapeChange_removeAll(void);
+
+// Called by the mutators; forwards to every installed hook
+void shapeChange_notify(const void *key);
+
+#endif // SHAPE_CHANGE_H
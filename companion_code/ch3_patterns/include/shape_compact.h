@@ -0,0 +1,72 @@
+#ifndef SHAPE_COMPACT_H
+#define SHAPE_COMPACT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "shape.h"
+#include "rectangle.h"
+#include "circle.h"
+#include "triangle.h"
+
+/*
+ * Compact shape encoding (opt-in).
+ * One 8-byte record per shape instead of an api_* object:
+ *   - type and visible flag share one byte
+ *   - 8-bit index into a vtable table instead of a vptr
+ *   - RGB565 (or palette index) color
+ *   - 16-bit dimensions, area/perimeter computed on demand
+ * Use the accessors below: the packing is an implementation detail.
+ *
+ * Build option SHAPE_COMPACT_COLOR_PALETTE=1 stores the color value as a
+ * 16-bit palette index instead of converting 0xRRGGBB to RGB565.
+ */
+
+#ifndef SHAPE_COMPACT_COLOR_PALETTE
+#define SHAPE_COMPACT_COLOR_PALETTE 0
+#endif
+
+#define SHAPE_COMPACT_MAX_DIMENSION 0xFFFFu
+#define SHAPE_COMPACT_MAX_VTABLES 16 // In-tree types included
+#define SHAPE_COMPACT_NO_VTABLE 0    // Index 0 is never a valid vtable
+
+typedef struct {
+    uint8_t _type_flags;   // bits 0-6: shape_type_t, bit 7: visible
+    uint8_t _vtable;       // Index into the compact vtable table
+    uint16_t _color;       // RGB565 or palette index
+    uint16_t _dim_a;       // width | radius | base
+    uint16_t _dim_b;       // height | unused | height
+} shape_compact_t;
+
+// VTable for compact shapes (the record is read-only for these calls)
+typedef struct {
+    void (*draw)(const shape_compact_t *self);
+    float (*get_area)(const shape_compact_t *self);
+    uint32_t (*get_perimeter)(const shape_compact_t *self);
+} shape_compact_vtable_t;
+
+/* Initialization: false if a dimension does not fit in 16 bits */
+bool shapeCompact_initRectangle(shape_compact_t *self, rect_config_t *rect_conf, shape_config_t *shape_conf);
+bool shapeCompact_initCircle(shape_compact_t *self, circle_config_t *circle_conf, shape_config_t *shape_conf);
+bool shapeCompact_initTriangle(shape_compact_t *self, triangle_config_t *tri_conf, shape_config_t *shape_conf);
+
+/* Custom types: returns the new index, SHAPE_COMPACT_NO_VTABLE when the table is full */
+uint8_t shapeCompact_registerVtable(const shape_compact_vtable_t *vtable);
+bool shapeCompact_setVtable(shape_compact_t *self, uint8_t index);
+
+/* Accessors */
+shape_type_t shapeCompact_getType(const shape_compact_t *self);
+bool shapeCompact_isVisible(const shape_compact_t *self);
+void shapeCompact_setVisible(shape_compact_t *self, bool visible);
+uint32_t shapeCompact_getColor(const shape_compact_t *self); // 0xRRGGBB (or palette index)
+void shapeCompact_setColor(shape_compact_t *self, uint32_t color);
+uint32_t shapeCompact_getDimA(const shape_compact_t *self);
+uint32_t shapeCompact_getDimB(const shape_compact_t *self);
+bool shapeCompact_setDimensions(shape_compact_t *self, uint32_t dim_a, uint32_t dim_b);
+
+/* Polymorphic calls through the vtable index */
+void shapeCompact_draw(const shape_compact_t *self);
+float shapeCompact_getArea(const shape_compact_t *self);
+uint32_t shapeCompact_getPerimeter(const shape_compact_t *self);
+
+#endif // SHAPE_COMPACT_H
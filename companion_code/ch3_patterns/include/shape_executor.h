@@ -0,0 +1,25 @@
+#ifndef SHAPE_EXECUTOR_H
+#define SHAPE_EXECUTOR_H
+
+#include <stdint.h>
+
+/*
+ * Thread pool hook shared by factory_shape_create_many() and the registry
+ * rescans. The library never creates threads: the caller's pool runs the
+ * jobs, and each module splits its work into ranges of 'grain' items
+ * (0 picks the module's own default).
+ */
+
+typedef void (*factory_job_t)(void *job_context, uint32_t job);
+
+// Must run job(job_context, j) for every j in [0, job_count), in any order
+// or in parallel, and return when all of them have finished
+typedef void (*factory_run_jobs_t)(void *context, factory_job_t job, void *job_context, uint32_t job_count);
+
+typedef struct {
+    factory_run_jobs_t run_jobs;    // Caller's thread pool
+    void *context;
+    uint32_t grain;                 // Items per job (0: the module default)
+} factory_executor_t;
+
+#endif // SHAPE_EXECUTOR_H
@@ -0,0 +1,86 @@
+#ifndef SHAPE_FLYWEIGHT_H
+#define SHAPE_FLYWEIGHT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "api_shape.h"
+#include "rectangle.h"
+#include "circle.h"
+#include "triangle.h"
+
+/*
+ * Flyweight interning of shape geometry.
+ * Identical (type, dimensions) are stored and computed once in a
+ * shape_geometry_t owned by the table; every shape_flyweight_t with that
+ * geometry only keeps a pointer to it plus its own color/visibility.
+ *
+ * Shared geometry is never written: resizing an instance interns the new
+ * dimensions and drops the reference to the old ones (copy-on-write), so
+ * the other instances keep their size.
+ */
+
+typedef struct {
+    shape_type_t type;
+    uint32_t dim_a;             // width | radius | base (next free slot while unused)
+    uint32_t dim_b;             // height | 0 | height
+    float area;                 // Computed once per geometry
+    uint32_t perimeter;
+    uint32_t refs;              // Instances sharing it, 0 = free slot
+} shape_geometry_t;
+
+// Instance handed to the API (behaves as an api_shape_t)
+typedef struct {
+    api_shape_t super;                  // MUST be first (inheritance)
+    const shape_geometry_t *geometry;   // Shared, owned by the table
+    uint32_t generation;                // Bumped when this instance is resized
+} shape_flyweight_t;
+
+typedef struct {
+    shape_geometry_t *geometries;   // Stable slots: instances point here
+    uint32_t *buckets;              // Open addressing, geometry index + 1 (0 = empty)
+    uint32_t capacity;
+    uint32_t bucket_mask;
+    uint32_t unique;                // Geometries in use
+    uint32_t free_head;             // First free slot (capacity = none)
+} shape_flyweight_table_t;
+
+// Configuration Struct (CS-06)
+typedef struct {
+    void *memory;               // Caller provided storage
+    size_t memory_size;         // Size in bytes of memory
+    uint32_t capacity;          // Distinct geometries, power of two
+} shape_flyweight_config_t;
+
+// Worst case memory for a table (twice as many buckets as geometries)
+#define SHAPE_FLYWEIGHT_MEMORY_SIZE(capacity) \
+    ((capacity) * (sizeof(shape_geometry_t) + 2u * sizeof(uint32_t)) + 2u * sizeof(void *))
+
+bool shapeFlyweight_init(shape_flyweight_table_t *self, const shape_flyweight_config_t *config);
+
+/* Interns the geometry (or takes a reference to an identical one) and
+ * initializes the instance. False when the table is full. */
+bool shapeFlyweight_initRectangle(shape_flyweight_table_t *self, shape_flyweight_t *shape, rect_config_t *rect_conf,
+                                  shape_config_t *shape_conf);
+bool shapeFlyweight_initCircle(shape_flyweight_table_t *self, shape_flyweight_t *shape,
+                               circle_config_t *circle_conf, shape_config_t *shape_conf);
+bool shapeFlyweight_initTriangle(shape_flyweight_table_t *self, shape_flyweight_t *shape,
+                                 triangle_config_t *tri_conf, shape_config_t *shape_conf);
+
+// Copy-on-write resize (dim_b is ignored for circles); unchanged on failure
+bool shapeFlyweight_resize(shape_flyweight_table_t *self, api_shape_t *shape, uint32_t dim_a, uint32_t dim_b);
+
+// Drops the instance's reference; the geometry is freed with its last user
+void shapeFlyweight_release(shape_flyweight_table_t *self, api_shape_t *shape);
+
+// NULL if the shape is not a flyweight instance
+const shape_geometry_t *shapeFlyweight_getGeometry(const api_shape_t *shape);
+
+uint32_t shapeFlyweight_getUniqueCount(const shape_flyweight_table_t *self);
+
+// Scans the distinct geometries only (not every instance); ties keep the first
+void shapeFlyweight_findBiggest(const shape_flyweight_table_t *self, const shape_geometry_t **biggestArea,
+                                const shape_geometry_t **biggestPerimeter);
+
+#endif // SHAPE_FLYWEIGHT_H
@@ -0,0 +1,57 @@
+#ifndef SHAPE_HASH_H
+#define SHAPE_HASH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Open addressing shared by the flyweight table and the registry dirty set
+ * (internal). Buckets hold an entry index + 1 (0 = empty) in a power of
+ * two table with linear probing. Deletion shifts the following entries
+ * back instead of leaving tombstones, so lookups never slow down with
+ * churn. The caller keeps the keys; the helpers only see entry indexes.
+ */
+
+// True when the entry holds 'key'
+typedef bool (*shape_hash_match_t)(const void *context, uint32_t entry, const void *key);
+
+// Full hash of the entry's key (the helpers apply the mask)
+typedef uint32_t (*shape_hash_of_t)(const void *context, uint32_t entry);
+
+// Bucket holding the key, or the empty bucket where it would go
+static inline uint32_t shapeHash_find(const uint32_t *buckets, uint32_t mask, uint32_t hash,
+                                      shape_hash_match_t match, const void *context, const void *key)
+{
+    uint32_t i = hash & mask;
+
+    while (buckets[i] != 0 && !match(context, buckets[i] - 1u, key)) {
+        i = (i + 1u) & mask;
+    }
+    return i;
+}
+
+// Empties 'hole' and shifts back the entries of its probe run
+static inline void shapeHash_remove(uint32_t *buckets, uint32_t mask, uint32_t hole,
+                                    shape_hash_of_t hash_of, const void *context)
+{
+    uint32_t next = hole;
+
+    buckets[hole] = 0;
+    for (;;) {
+        next = (next + 1u) & mask;
+        if (buckets[next] == 0) {
+            return;
+        }
+
+        uint32_t home = hash_of(context, buckets[next] - 1u) & mask;
+        // Move the entry back unless its home lies cyclically in (hole, next]
+        bool stays = (hole < next) ? (home > hole && home <= next) : (home > hole || home <= next);
+        if (!stays) {
+            buckets[hole] = buckets[next];
+            buckets[next] = 0;
+            hole = next;
+        }
+    }
+}
+
+#endif // SHAPE_HASH_H
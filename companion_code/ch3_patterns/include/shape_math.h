@@ -0,0 +1,186 @@
+#ifndef SHAPE_MATH_H
+#define SHAPE_MATH_H
+
+#include <stdint.h>
+
+/*
+ * Shared geometry formulas.
+ * Every module that derives area/perimeter uses these helpers, so the
+ * per-object, stored and batch paths all produce bit-identical results.
+ *
+ * Build option SHAPE_MATH_FIXED_POINT=1 selects the integer backend for
+ * FPU-less targets: circle/triangle values are computed in unsigned
+ * Q(64-F).F fixed point (F = SHAPE_MATH_Q_BITS) and perimeters never touch
+ * float. Float-returning helpers convert once, when the value is cached.
+ * Q areas that do not fit in 64 bits (radius above SHAPE_Q_MAX_RADIUS,
+ * base * height or width * height above the matching product bound)
+ * saturate to SHAPE_Q_SATURATED; the float-returning helpers then convert
+ * the exact 64-bit product instead, so they never wrap. Q perimeters
+ * saturate the same way past SHAPE_Q_MAX_PERIMETER_RADIUS, and integer
+ * results that do not fit in 32 bits saturate to UINT32_MAX.
+ */
+
+#ifndef SHAPE_MATH_FIXED_POINT
+#define SHAPE_MATH_FIXED_POINT 0
+#endif
+
+#ifndef SHAPE_MATH_Q_BITS
+#define SHAPE_MATH_Q_BITS 16
+#endif
+
+// Below 6 bits the Q pi is too coarse for perimeters to match the float path
+#if (SHAPE_MATH_Q_BITS < 6) || (SHAPE_MATH_Q_BITS > 30)
+#error "SHAPE_MATH_Q_BITS must be in [6, 30]"
+#endif
+
+#define SHAPE_MATH_PI 3.14159f
+
+// Fixed point value with SHAPE_MATH_Q_BITS fractional bits
+typedef uint64_t shape_q_t;
+
+#define SHAPE_Q_ONE ((shape_q_t)1 << SHAPE_MATH_Q_BITS)
+
+// 3.14159 in Q format, rounded to nearest (integer-only expression)
+#define SHAPE_Q_PI ((((shape_q_t)314159 << SHAPE_MATH_Q_BITS) + 50000u) / 100000u)
+
+// Returned by the Q area helpers past their bounds
+#define SHAPE_Q_SATURATED (~(shape_q_t)0)
+
+// Largest radius whose Q area still fits in 64 bits (2^23 for Q16)
+#define SHAPE_Q_MAX_RADIUS ((uint32_t)(0xFFFFFFFFu >> ((SHAPE_MATH_Q_BITS + 3) / 2)))
+
+// Largest radius whose Q perimeter still fits in 64 bits (every uint32 below Q30)
+#define SHAPE_Q_MAX_PERIMETER_RADIUS                                        \
+    (SHAPE_Q_SATURATED / (2 * SHAPE_Q_PI) > 0xFFFFFFFFu ? 0xFFFFFFFFu       \
+                                                        : (uint32_t)(SHAPE_Q_SATURATED / (2 * SHAPE_Q_PI)))
+
+// Largest width * height (base * height) whose Q area still fits in 64 bits
+#define SHAPE_Q_MAX_RECT_PRODUCT (SHAPE_Q_SATURATED >> SHAPE_MATH_Q_BITS)
+#define SHAPE_Q_MAX_TRIANGLE_PRODUCT (SHAPE_Q_SATURATED >> (SHAPE_MATH_Q_BITS - 1))
+
+/*
+ * Constant-expression forms of every formula. They are usable in static
+ * initializers (see the *_STATIC_INIT macros) and the inline helpers below
+ * are defined in terms of them, so both paths give bit-identical values.
+ */
+#define SHAPE_MATH_PRODUCT(a, b)            ((shape_q_t)(a) * (b)) // Exact: 32 x 32 bits
+#define SHAPE_MATH_RECT_AREA_Q(w, h)                                        \
+    (SHAPE_MATH_PRODUCT(w, h) > SHAPE_Q_MAX_RECT_PRODUCT ? SHAPE_Q_SATURATED \
+                                                         : SHAPE_MATH_PRODUCT(w, h) << SHAPE_MATH_Q_BITS)
+#define SHAPE_MATH_CIRCLE_AREA_Q(r)                                         \
+    ((uint32_t)(r) > SHAPE_Q_MAX_RADIUS ? SHAPE_Q_SATURATED : SHAPE_MATH_PRODUCT(r, r) * SHAPE_Q_PI)
+#define SHAPE_MATH_CIRCLE_PERIMETER_Q(r)                                    \
+    ((uint32_t)(r) > SHAPE_Q_MAX_PERIMETER_RADIUS ? SHAPE_Q_SATURATED : 2 * (shape_q_t)(r) * SHAPE_Q_PI)
+#define SHAPE_MATH_TRIANGLE_AREA_Q(b, h)                                        \
+    (SHAPE_MATH_PRODUCT(b, h) > SHAPE_Q_MAX_TRIANGLE_PRODUCT ? SHAPE_Q_SATURATED \
+                                                             : SHAPE_MATH_PRODUCT(b, h) << (SHAPE_MATH_Q_BITS - 1))
+#define SHAPE_MATH_Q_TO_UINT(q)                                             \
+    (((q) >> SHAPE_MATH_Q_BITS) > 0xFFFFFFFFu ? 0xFFFFFFFFu : (uint32_t)((q) >> SHAPE_MATH_Q_BITS))
+#define SHAPE_MATH_Q_TO_FLOAT(q)            ((float)(q) / (float)SHAPE_Q_ONE)
+
+#define SHAPE_MATH_RECT_AREA(w, h)          ((float)((uint32_t)(w) * (uint32_t)(h)))
+#define SHAPE_MATH_RECT_PERIMETER(w, h)     (2 * ((uint32_t)(w) + (uint32_t)(h)))
+
+#if SHAPE_MATH_FIXED_POINT
+// Past the Q bounds: the 64-bit product converted once, times the same Q pi
+#define SHAPE_MATH_CIRCLE_AREA(r)                                                   \
+    ((uint32_t)(r) <= SHAPE_Q_MAX_RADIUS                                            \
+         ? SHAPE_MATH_Q_TO_FLOAT(SHAPE_MATH_CIRCLE_AREA_Q(r))                       \
+         : (float)SHAPE_MATH_PRODUCT(r, r) * SHAPE_MATH_Q_TO_FLOAT(SHAPE_Q_PI))
+#define SHAPE_MATH_CIRCLE_PERIMETER(r)      SHAPE_MATH_Q_TO_UINT(SHAPE_MATH_CIRCLE_PERIMETER_Q(r))
+#define SHAPE_MATH_TRIANGLE_AREA(b, h)                                              \
+    (SHAPE_MATH_PRODUCT(b, h) <= SHAPE_Q_MAX_TRIANGLE_PRODUCT                       \
+         ? SHAPE_MATH_Q_TO_FLOAT(SHAPE_MATH_TRIANGLE_AREA_Q(b, h))                  \
+         : (float)SHAPE_MATH_PRODUCT(b, h) * 0.5f)
+#else
+// Radius squared in float: exact for radius < 2^16 and no uint32 wrap above it
+#define SHAPE_MATH_CIRCLE_AREA(r)           ((float)(r) * (float)(r) * SHAPE_MATH_PI)
+// Perimeter (Circumference) = 2 * pi * r, saturated where it leaves uint32
+#define SHAPE_MATH_CIRCLE_PERIMETER(r)                                      \
+    (2 * SHAPE_MATH_PI * (float)(r) >= 4294967296.0f ? 0xFFFFFFFFu          \
+                                                      : (uint32_t)(2 * SHAPE_MATH_PI * (float)(r)))
+#define SHAPE_MATH_TRIANGLE_AREA(b, h)      ((float)(b) * (float)(h) / 2.0f)
+#endif
+
+/* --- Fixed point helpers (always available) --- */
+
+static inline shape_q_t shapeMath_rectAreaQ(uint32_t width, uint32_t height)
+{
+    return SHAPE_MATH_RECT_AREA_Q(width, height);
+}
+
+static inline shape_q_t shapeMath_circleAreaQ(uint32_t radius)
+{
+    // 64-bit square: saturates instead of wrapping past SHAPE_Q_MAX_RADIUS
+    return SHAPE_MATH_CIRCLE_AREA_Q(radius);
+}
+
+static inline shape_q_t shapeMath_circlePerimeterQ(uint32_t radius)
+{
+    // Saturates instead of wrapping past SHAPE_Q_MAX_PERIMETER_RADIUS
+    return SHAPE_MATH_CIRCLE_PERIMETER_Q(radius);
+}
+
+static inline shape_q_t shapeMath_triangleAreaQ(uint32_t base, uint32_t height)
+{
+    return SHAPE_MATH_TRIANGLE_AREA_Q(base, height);
+}
+
+static inline uint32_t shapeMath_qToUint(shape_q_t value)
+{
+    return SHAPE_MATH_Q_TO_UINT(value);
+}
+
+static inline float shapeMath_qToFloat(shape_q_t value)
+{
+    // Dividing by a power of two is exact: a single rounding
+    return SHAPE_MATH_Q_TO_FLOAT(value);
+}
+
+/* --- Formulas used by the shape modules --- */
+
+static inline float shapeMath_rectArea(uint32_t width, uint32_t height)
+{
+    return SHAPE_MATH_RECT_AREA(width, height);
+}
+
+static inline uint32_t shapeMath_rectPerimeter(uint32_t width, uint32_t height)
+{
+    return SHAPE_MATH_RECT_PERIMETER(width, height);
+}
+
+static inline float shapeMath_circleArea(uint32_t radius)
+{
+    return SHAPE_MATH_CIRCLE_AREA(radius);
+}
+
+static inline uint32_t shapeMath_circlePerimeter(uint32_t radius)
+{
+    return SHAPE_MATH_CIRCLE_PERIMETER(radius);
+}
+
+static inline float shapeMath_triangleArea(uint32_t base, uint32_t height)
+{
+    return SHAPE_MATH_TRIANGLE_AREA(base, height);
+}
+
+/* --- Transforms --- */
+
+// Largest float below 2^32: scaled dimensions saturate here
+#define SHAPE_MATH_SCALE_MAX 4294967040.0f
+
+// dim * scale truncated, clamped to [0, SHAPE_MATH_SCALE_MAX] (NaN gives 0)
+static inline uint32_t shapeMath_scaleDim(uint32_t dim, float scale)
+{
+    float value = (float)dim * scale;
+
+    if (!(value > 0.0f)) {
+        return 0;
+    }
+    if (value >= SHAPE_MATH_SCALE_MAX) {
+        return (uint32_t)SHAPE_MATH_SCALE_MAX;
+    }
+    return (uint32_t)value;
+}
+
+#endif // SHAPE_MATH_H
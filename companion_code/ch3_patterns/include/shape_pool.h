@@ -0,0 +1,94 @@
+#ifndef SHAPE_POOL_H
+#define SHAPE_POOL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "factory_shape.h"
+
+/*
+ * Per-type slab pool for api_rectangle_t / api_circle_t / api_triangle_t.
+ * Each type gets a slab of fixed-size blocks carved from caller memory.
+ * Free blocks are chained through their own first bytes (intrusive free
+ * list), so alloc and free are O(1) and never touch the heap. A free block
+ * also carries a marker, so freeing it again fails instead of corrupting
+ * the list.
+ *
+ * The pool is not thread-safe by itself. Threads that share it pass
+ * lock/unlock callbacks in the config, and each thread can put a
+ * shape_pool_cache_t in front of the pool: the cache serves most calls
+ * without locking and moves blocks to/from the pool in batches.
+ */
+
+#define SHAPE_POOL_TYPE_COUNT 3 // rectangle, circle, triangle
+#define SHAPE_POOL_CACHE_SIZE 8 // Blocks per type kept by a thread cache
+
+// Worst case memory for a pool (includes the alignment padding of each slab)
+#define SHAPE_POOL_MEMORY_SIZE(n_rect, n_circle, n_tri)                                   \
+    ((n_rect) * sizeof(api_rectangle_t) + (n_circle) * sizeof(api_circle_t) +             \
+     (n_tri) * sizeof(api_triangle_t) + SHAPE_POOL_TYPE_COUNT * sizeof(api_shape_storage_t))
+
+typedef void (*shape_pool_lock_t)(void *context);
+
+typedef struct {
+    uint32_t capacity;
+    uint32_t in_use;        // Blocks not in the pool free list (thread caches included)
+    uint32_t high_water;    // Largest in_use seen
+    uint32_t failed;        // Allocations that returned NULL because the slab was empty
+} shape_pool_stats_t;
+
+typedef struct {
+    uint8_t *base;
+    size_t block_size;
+    void *free_list;
+    shape_pool_stats_t stats;
+} shape_pool_slab_t;
+
+typedef struct {
+    shape_pool_slab_t slabs[SHAPE_POOL_TYPE_COUNT];
+    shape_pool_lock_t lock;
+    shape_pool_lock_t unlock;
+    void *lock_context;
+} shape_pool_t;
+
+// Configuration Struct (CS-06)
+typedef struct {
+    void *memory;                               // Caller provided storage
+    size_t memory_size;                         // Size in bytes of memory
+    uint32_t capacity[SHAPE_POOL_TYPE_COUNT];   // Shapes per type
+    shape_pool_lock_t lock;                     // Optional: only when threads share the pool
+    shape_pool_lock_t unlock;
+    void *lock_context;
+} shape_pool_config_t;
+
+// Per-thread front end: owned and used by a single thread
+typedef struct {
+    shape_pool_t *pool;
+    uint32_t count[SHAPE_POOL_TYPE_COUNT];
+    void *blocks[SHAPE_POOL_TYPE_COUNT][SHAPE_POOL_CACHE_SIZE];
+} shape_pool_cache_t;
+
+bool shapePool_init(shape_pool_t *self, const shape_pool_config_t *config);
+
+// Uninitialized block for one shape of the given type, NULL when exhausted
+api_shape_t *shapePool_alloc(shape_pool_t *self, shape_type_t type);
+
+// False if the shape was not allocated from this pool or is already free
+bool shapePool_free(shape_pool_t *self, api_shape_t *shape);
+
+// Allocates and initializes through factory_shape_create in one call
+api_shape_t *shapePool_create(shape_pool_t *self, factory_config_t *config);
+
+bool shapePool_getStats(const shape_pool_t *self, shape_type_t type, shape_pool_stats_t *stats);
+
+/* Thread cache: same calls, the pool lock is taken once per batch */
+void shapePool_cacheInit(shape_pool_cache_t *cache, shape_pool_t *pool);
+api_shape_t *shapePool_cacheAlloc(shape_pool_cache_t *cache, shape_type_t type);
+bool shapePool_cacheFree(shape_pool_cache_t *cache, api_shape_t *shape);
+api_shape_t *shapePool_cacheCreate(shape_pool_cache_t *cache, factory_config_t *config);
+
+// Returns every cached block to the pool (call before the thread exits)
+void shapePool_cacheFlush(shape_pool_cache_t *cache);
+
+#endif // SHAPE_POOL_H
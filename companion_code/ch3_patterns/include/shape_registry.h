@@ -1,6 +1,9 @@
 #ifndef SHAPE_REGISTRY_H
 #define SHAPE_REGISTRY_H
 
+#include <stddef.h>
+#include "shape_executor.h"
+
 // region: registry_header
 #include <stdint.h>
 #include <stdbool.h>
@@ -8,12 +11,12 @@
 
 #define MAX_SHAPES 12
 
-typedef struct 
+typedef struct
 {
     uint32_t count;
     api_shape_t * api_shapes[MAX_SHAPES];
     api_shape_t * biggestArea;
-    api_shape_t * biggestPerimeter;    
+    api_shape_t * biggestPerimeter;
 }shape_registry_data_t;
 
 /* Initialize/Get the singleton instance */
@@ -28,4 +31,194 @@ bool shapeRegistry_Register(api_shape_t * shape);
 bool shapeRegistry_Unregister(api_shape_t * shape);
 // endregion
 
+/* Registers a whole table (e.g. statically initialized const shapes) in one
+ * step: no per-shape init calls. Fails without change if it does not fit. */
+bool shapeRegistry_RegisterStatic(api_shape_t * const *shapes, uint32_t count);
+
+/*
+ * Instance registries: same operations on caller-provided storage of any
+ * capacity, so a system can keep several independent registries (one per
+ * subsystem or worker thread). The singleton above is a thin wrapper over a
+ * default instance of MAX_SHAPES.
+ * The public fields may be read directly; only the functions modify them.
+ *
+ * Every registration gets a token (stable while registered). Unregistering
+ * by token finds the shape through a back-index instead of a search; with
+ * the 'unordered' option the hole is filled with the last shape, so the
+ * removal is O(1) but api_shapes[] order is unspecified.
+ *
+ * With the 'indexed' option the shapes are also kept in two balanced
+ * search trees, one ordered by area and one by perimeter: register,
+ * unregister and InstanceUpdate adjust them in O(log n) and biggest* is
+ * current right away, so Tasks has nothing to scan. Generations are not
+ * polled: report a modified shape with InstanceUpdate. Ties go to the
+ * earlier shape as in the full scan (the lower token when unordered).
+ * The trees also answer top-K and range queries (see below).
+ *
+ * With the 'track_changes' option the registry keeps a dirty set instead of
+ * polling generations: shapeRegistry_ChangeHook (installed with
+ * shapeChange_addHook for each tracking registry, build option
+ * SHAPE_CHANGE_HOOK=1) queues each modified shape once, and Tasks only
+ * looks at the queued shapes. A full rescan is left for registration
+ * changes and for a queued shape that was, or may now be, the biggest;
+ * indexed registries re-key just the queue.
+ * Shapes that share a change key (every handle of one shape_store_t, or a
+ * shape registered twice) are chained under it, so one notify queues them
+ * all. Shapes without a change key (shape_get_change_key() is NULL) are not
+ * tracked: report them with InstanceUpdate.
+ */
+typedef uint32_t shape_registry_token_t;
+
+#define SHAPE_REGISTRY_INVALID_TOKEN UINT32_MAX
+
+/*
+ * Parallel rescans: with an executor (the same thread pool hook as
+ * factory_shape_create_many) and workers > 1, a full rescan is split into up
+ * to 'workers' contiguous ranges of at least executor->grain shapes
+ * (SHAPE_REGISTRY_RESCAN_GRAIN when 0). Each job finds both maxima of its
+ * range in one pass; the ranges are combined in order with the serial rule
+ * (first strictly greater), so the result is the same as on one thread.
+ */
+#ifndef SHAPE_REGISTRY_MAX_WORKERS
+#define SHAPE_REGISTRY_MAX_WORKERS 16u // Partial results kept on the stack
+#endif
+
+// A rescan visits a shape in about the time create_many builds one (~20 ns)
+#ifndef SHAPE_REGISTRY_RESCAN_GRAIN
+#define SHAPE_REGISTRY_RESCAN_GRAIN 4096u // Default shapes per rescan job (executor->grain == 0)
+#endif
+
+// Order-statistic tree (treap) over tokens, ascending by key
+typedef struct {
+    uint32_t root;              // SHAPE_REGISTRY_INVALID_TOKEN when empty
+    uint32_t *left;
+    uint32_t *right;
+    uint32_t *parent;
+    uint32_t *size;             // Nodes in the subtree
+} shape_registry_tree_t;
+
+typedef enum {
+    SHAPE_REGISTRY_KEY_AREA,
+    SHAPE_REGISTRY_KEY_PERIMETER
+} shape_registry_key_t;
+
+typedef struct {
+    // Public view
+    uint32_t count;
+    uint32_t capacity;
+    api_shape_t **api_shapes;
+    api_shape_t *biggestArea;
+    api_shape_t *biggestPerimeter;
+    // Private state
+    float max_area;
+    uint32_t max_perimeter;
+    uint32_t *generations;      // Shape generations seen by the last pass
+    uint32_t *token_of;         // api_shapes[i] -> its token
+    uint32_t *slot_of;          // token -> index in api_shapes (next free token + 1 while unused)
+    uint32_t free_token;        // Released token list head + 1 (0 = empty)
+    uint32_t fresh_token;       // Tokens from here on were never handed out
+    float *area_of;             // token -> area (indexed only)
+    uint32_t *perimeter_of;     // token -> perimeter (indexed only)
+    shape_registry_tree_t area_tree;
+    shape_registry_tree_t perimeter_tree;
+    const void **key_of;        // token -> change key (tracked only)
+    uint32_t *buckets;          // change key -> first token + 1 (0 = empty)
+    uint32_t *next_same_key;    // token -> next token with its key (INVALID_TOKEN ends the chain)
+    uint32_t *prev_same_key;    // token -> previous token with its key (INVALID_TOKEN at the head)
+    uint32_t bucket_mask;
+    uint32_t *dirty;            // Queued tokens, each at most once
+    uint8_t *is_dirty;          // token -> queued flag
+    uint32_t dirty_count;
+    const factory_executor_t *executor;
+    uint32_t workers;
+    bool unordered;
+    bool indexed;
+    bool track_changes;
+    bool changed;               // Registered/unregistered since the last pass
+} shape_registry_t;
+
+// Configuration Struct (CS-06)
+typedef struct {
+    void *memory;               // Caller provided storage
+    size_t memory_size;         // Size in bytes of memory
+    uint32_t capacity;          // Shapes
+    bool unordered;             // O(1) unregister, api_shapes[] order unspecified
+    bool indexed;               // Keep shapes ordered by area and perimeter instead of rescanning
+    bool track_changes;         // Dirty set fed by shapeRegistry_ChangeHook instead of polling
+    const factory_executor_t *executor; // Optional: thread pool for full rescans
+    uint32_t workers;           // Jobs per rescan (up to SHAPE_REGISTRY_MAX_WORKERS)
+} shape_registry_config_t;
+
+// Bytes needed per registered shape
+#define SHAPE_REGISTRY_BYTES_PER_SHAPE (sizeof(api_shape_t *) + 3u * sizeof(uint32_t))
+
+// Worst case memory for a registry (includes alignment slack)
+#define SHAPE_REGISTRY_MEMORY_SIZE(capacity) ((capacity) * SHAPE_REGISTRY_BYTES_PER_SHAPE + 2u * sizeof(void *))
+
+// Extra bytes per shape for the 'indexed' option
+#define SHAPE_REGISTRY_INDEX_BYTES_PER_SHAPE (sizeof(float) + 9u * sizeof(uint32_t))
+
+#define SHAPE_REGISTRY_INDEXED_MEMORY_SIZE(capacity) \
+    (SHAPE_REGISTRY_MEMORY_SIZE(capacity) + (capacity) * SHAPE_REGISTRY_INDEX_BYTES_PER_SHAPE)
+
+// Extra bytes per shape for the 'track_changes' option (hash buckets: up to 4 per shape)
+#define SHAPE_REGISTRY_CHANGE_BYTES_PER_SHAPE (sizeof(void *) + 7u * sizeof(uint32_t) + 1u)
+
+// Enough for any combination of options
+#define SHAPE_REGISTRY_FULL_MEMORY_SIZE(capacity) \
+    (SHAPE_REGISTRY_INDEXED_MEMORY_SIZE(capacity) + (capacity) * SHAPE_REGISTRY_CHANGE_BYTES_PER_SHAPE + 2u * sizeof(void *))
+
+// Statistics combined over several registries
+typedef struct {
+    uint32_t count;
+    api_shape_t *biggestArea;
+    api_shape_t *biggestPerimeter;
+    float max_area;
+    uint32_t max_perimeter;
+} shape_registry_stats_t;
+
+bool shapeRegistry_InstanceInit(shape_registry_t *self, const shape_registry_config_t *config);
+void shapeRegistry_InstanceTasks(shape_registry_t *self);
+// token may be NULL when the caller always unregisters by pointer
+bool shapeRegistry_InstanceRegister(shape_registry_t *self, api_shape_t *shape, shape_registry_token_t *token);
+// Searches for the shape: O(n)
+bool shapeRegistry_InstanceUnregister(shape_registry_t *self, api_shape_t *shape);
+// O(1) when unordered, otherwise O(n) for the shift
+bool shapeRegistry_InstanceUnregisterToken(shape_registry_t *self, shape_registry_token_t token);
+bool shapeRegistry_InstanceRegisterStatic(shape_registry_t *self, api_shape_t * const *shapes, uint32_t count);
+// Reports a modified shape: O(log n) when indexed, otherwise the next Tasks rescans
+bool shapeRegistry_InstanceUpdate(shape_registry_t *self, shape_registry_token_t token);
+// shape_change_hook_t for a tracking registry (context = the registry): O(1)
+void shapeRegistry_ChangeHook(void *context, const void *key);
+
+/*
+ * Queries on an indexed registry (nothing is found otherwise), expected
+ * O(log n + k) for k results. Equal keys list the earlier shape first in
+ * TopK and last in a range.
+ */
+// Largest first; returns how many were written (at most k)
+uint32_t shapeRegistry_TopK(const shape_registry_t *self, shape_registry_key_t key, uint32_t k, api_shape_t **shapes);
+// Shapes with lo <= key <= hi
+uint32_t shapeRegistry_CountInRange(const shape_registry_t *self, shape_registry_key_t key, double lo, double hi);
+
+// Range iterator: valid until the registry is modified
+typedef struct {
+    const shape_registry_t *registry;
+    shape_registry_key_t key;
+    double hi;
+    uint32_t node;
+} shape_registry_range_t;
+
+// Ascending from lo to hi: RangeNext returns NULL past the end
+void shapeRegistry_RangeBegin(shape_registry_range_t *range, const shape_registry_t *self, shape_registry_key_t key,
+                              double lo, double hi);
+api_shape_t *shapeRegistry_RangeNext(shape_registry_range_t *range);
+
+// The default instance behind the singleton API (e.g. to publish views of it)
+const shape_registry_t *shapeRegistry_GetInstance(void);
+
+/* Combines the results of the last Tasks pass of every shard in O(shards):
+ * no shape is touched. Ties keep the earlier shard. */
+void shapeRegistry_Merge(const shape_registry_t * const *shards, uint32_t count, shape_registry_stats_t *stats);
+
 #endif /* SHAPE_REGISTRY_H */
@@ -0,0 +1,71 @@
+#ifndef SHAPE_REGISTRY_VIEW_H
+#define SHAPE_REGISTRY_VIEW_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "shape_registry.h"
+
+/*
+ * Read-copy-update views of a registry for reader threads.
+ *
+ * The registry itself is not safe to read while it changes: Unregister
+ * shifts api_shapes[] under the reader. Instead the writer publishes an
+ * immutable copy (count, biggest*, maxima and the shape list) into one of
+ * several buffers and switches the current index atomically. Readers pin
+ * the current buffer with acquire/release: no locks, and a reader never
+ * waits for the writer. A buffer is only rewritten once no reader holds it
+ * (deferred reclamation), so publish fails instead of overwriting a view in
+ * use; with N readers holding one view each, N + 2 buffers always suffice.
+ *
+ * Rules: one writer (the thread that modifies the registry) calls publish.
+ * The view pins the list, not the shapes: read their values with
+ * shape_get_snapshot() if they change concurrently (see shape_seqlock.h).
+ * Requires the GCC/Clang __atomic builtins.
+ */
+
+typedef struct {
+    uint32_t version;           // Bumped by every publish
+    uint32_t count;
+    api_shape_t *biggestArea;
+    api_shape_t *biggestPerimeter;
+    float max_area;
+    uint32_t max_perimeter;
+    api_shape_t **api_shapes;   // count entries
+} shape_registry_view_t;
+
+typedef struct {
+    shape_registry_view_t *buffers;
+    uint32_t *readers;          // Pins per buffer
+    uint32_t buffer_count;
+    uint32_t capacity;          // Shapes per buffer
+    uint32_t current;           // Index of the published buffer
+    uint32_t version;
+} shape_registry_views_t;
+
+// Configuration Struct (CS-06)
+typedef struct {
+    void *memory;               // Caller provided storage
+    size_t memory_size;         // Size in bytes of memory
+    uint32_t capacity;          // Shapes per view (the registry capacity)
+    uint32_t buffer_count;      // At least 2
+} shape_registry_views_config_t;
+
+// Worst case memory (includes alignment slack)
+#define SHAPE_REGISTRY_VIEW_MEMORY_SIZE(capacity, buffer_count)                                 \
+    ((buffer_count) * (sizeof(shape_registry_view_t) + sizeof(uint32_t) +                       \
+                       (capacity) * sizeof(api_shape_t *)) + 2u * sizeof(void *))
+
+// Starts with an empty view published (version 0)
+bool shapeRegistryView_init(shape_registry_views_t *self, const shape_registry_views_config_t *config);
+
+// Writer: copies the registry's last Tasks result. False (nothing published)
+// if the registry does not fit or every other buffer is still pinned.
+bool shapeRegistryView_publish(shape_registry_views_t *self, const shape_registry_t *registry);
+
+// Reader: the current view, valid until released. Never NULL after init.
+const shape_registry_view_t *shapeRegistryView_acquire(shape_registry_views_t *self);
+void shapeRegistryView_release(shape_registry_views_t *self, const shape_registry_view_t *view);
+
+#endif // SHAPE_REGISTRY_VIEW_H
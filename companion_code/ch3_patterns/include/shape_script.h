@@ -0,0 +1,105 @@
+#ifndef SHAPE_SCRIPT_H
+#define SHAPE_SCRIPT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "api_shape_types.h"
+
+/*
+ * Shape command bytecode.
+ * A scene script is a byte stream of commands: one opcode byte followed by
+ * fixed-size little-endian operands. shapeScript_run() executes a whole
+ * stream in one loop (computed goto on GCC/Clang, switch elsewhere), so a
+ * scene setup or a replay is a single call instead of one API call per step.
+ *
+ * Shapes live in caller-provided api_shape_storage_t slots and are addressed
+ * by slot index. Build streams with the shapeScript_emit* helpers.
+ *
+ * Build option SHAPE_SCRIPT_COMPUTED_GOTO=0 forces the switch dispatch.
+ */
+
+#ifndef SHAPE_SCRIPT_COMPUTED_GOTO
+#if defined(__GNUC__)
+#define SHAPE_SCRIPT_COMPUTED_GOTO 1
+#else
+#define SHAPE_SCRIPT_COMPUTED_GOTO 0
+#endif
+#endif
+
+// Opcodes and operands (after the opcode byte)
+typedef enum {
+    SHAPE_OP_END = 0,        // -                           stops the script
+    SHAPE_OP_RECTANGLE,      // slot, color, visible, width, height
+    SHAPE_OP_CIRCLE,         // slot, color, visible, radius
+    SHAPE_OP_TRIANGLE,       // slot, color, visible, base, height
+    SHAPE_OP_RESIZE,         // slot, a, b                  width/height | radius/- | base/height
+    SHAPE_OP_SET_COLOR,      // slot, color
+    SHAPE_OP_SET_VISIBLE,    // slot, visible
+    SHAPE_OP_CANVAS_ADD,     // slot, x, y
+    SHAPE_OP_CANVAS_MOVE,    // slot, x, y
+    SHAPE_OP_CANVAS_REMOVE,  // slot
+    SHAPE_OP_CANVAS_TASK,    // repeat                      canvas_task() 'repeat' times
+    SHAPE_OP_REGISTER,       // slot                        shapeRegistry_Register()
+    SHAPE_OP_COUNT
+} shape_op_t;
+// Operand sizes: slot, visible u8 | x, y int16 | repeat u16 | others u32
+
+// Configuration Struct (CS-06)
+typedef struct {
+    api_shape_storage_t *slots; // Caller provided shape storage
+    uint32_t slot_count;        // At most 256 (8-bit slot operand)
+} shape_script_config_t;
+
+typedef struct {
+    api_shape_storage_t *slots;
+    uint32_t slot_count;
+    size_t error_offset;                    // Offset of the command that failed
+    uint32_t op_counts[SHAPE_OP_COUNT];     // Executed commands per opcode (profiling)
+} shape_script_t;
+
+// Emits commands into a caller buffer; overflow is sticky
+typedef struct {
+    uint8_t *buffer;
+    size_t capacity;
+    size_t size;
+    bool overflow;
+} shape_script_writer_t;
+
+// Clears the slots: every slot starts empty
+bool shapeScript_init(shape_script_t *self, const shape_script_config_t *config);
+
+/*
+ * Executes the commands until SHAPE_OP_END or the end of the buffer.
+ * Returns false at the first invalid command (unknown opcode, truncated
+ * operands, bad or empty slot, create on an occupied slot, rejected by the
+ * canvas/registry) and records its offset; earlier commands stay applied.
+ * Replaying a setup stream therefore needs shapeScript_init() first.
+ */
+bool shapeScript_run(shape_script_t *self, const uint8_t *code, size_t size);
+
+void shapeScript_resetCounters(shape_script_t *self);
+
+// Shape in a slot, NULL if the slot is empty or out of range
+api_shape_t *shapeScript_getShape(shape_script_t *self, uint32_t slot);
+
+/* Stream builder: false (and overflow set) when the command does not fit */
+void shapeScript_writerInit(shape_script_writer_t *writer, uint8_t *buffer, size_t capacity);
+bool shapeScript_emitRectangle(shape_script_writer_t *writer, uint8_t slot, const rect_config_t *rect_conf,
+                               const shape_config_t *shape_conf);
+bool shapeScript_emitCircle(shape_script_writer_t *writer, uint8_t slot, const circle_config_t *circle_conf,
+                            const shape_config_t *shape_conf);
+bool shapeScript_emitTriangle(shape_script_writer_t *writer, uint8_t slot, const triangle_config_t *tri_conf,
+                              const shape_config_t *shape_conf);
+bool shapeScript_emitResize(shape_script_writer_t *writer, uint8_t slot, uint32_t dim_a, uint32_t dim_b);
+bool shapeScript_emitSetColor(shape_script_writer_t *writer, uint8_t slot, uint32_t color);
+bool shapeScript_emitSetVisible(shape_script_writer_t *writer, uint8_t slot, bool visible);
+bool shapeScript_emitCanvasAdd(shape_script_writer_t *writer, uint8_t slot, int16_t x, int16_t y);
+bool shapeScript_emitCanvasMove(shape_script_writer_t *writer, uint8_t slot, int16_t x, int16_t y);
+bool shapeScript_emitCanvasRemove(shape_script_writer_t *writer, uint8_t slot);
+bool shapeScript_emitCanvasTask(shape_script_writer_t *writer, uint16_t repeat);
+bool shapeScript_emitRegister(shape_script_writer_t *writer, uint8_t slot);
+bool shapeScript_emitEnd(shape_script_writer_t *writer);
+
+#endif // SHAPE_SCRIPT_H
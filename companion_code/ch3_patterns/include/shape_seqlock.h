@@ -0,0 +1,139 @@
+#ifndef SHAPE_SEQLOCK_H
+#define SHAPE_SEQLOCK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "shape_change.h"
+
+/*
+ * Sequence lock over the per-object generation counter (opt-in).
+ *
+ * Build option SHAPE_SEQLOCK=1: a writer makes the counter odd before it
+ * touches an object and even again when done. Readers copy the values
+ * they need and start over if the counter was odd or moved meanwhile, so
+ * writers never wait and readers never take a lock. An uncontended read
+ * costs two counter loads and a fence.
+ *
+ * The fields a writer changes inside the bracket, and the reads a
+ * snapshot retries, go through the store/load helpers below: relaxed
+ * atomics when enabled, so the concurrent accesses are not a data race,
+ * and plain accesses otherwise. shape_store's bulk refresh and scale write
+ * whole lanes with the batch kernels instead: do not read a store while
+ * they run.
+ *
+ * Rules: one writer per object at a time, and a reader must not preempt
+ * the writer of the same object on a single core (e.g. from an ISR): it
+ * would spin until the writer resumes.
+ *
+ * SHAPE_SEQLOCK=0 (default): the counter is a plain generation, bumped by
+ * one per update, and reads never retry.
+ */
+
+#ifndef SHAPE_SEQLOCK
+#define SHAPE_SEQLOCK 0
+#endif
+
+#if SHAPE_SEQLOCK && !defined(__GNUC__)
+#error "SHAPE_SEQLOCK requires the GCC/Clang __atomic builtins"
+#endif
+
+/* Writer side: bracket every update of the object (writeEnd also reports
+ * the object to the change hook when SHAPE_CHANGE_HOOK=1) */
+
+static inline void shapeSeqlock_writeBegin(uint32_t *seq)
+{
+#if SHAPE_SEQLOCK
+    __atomic_store_n(seq, *seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE); // Odd value visible before the data
+#else
+    (void)seq;
+#endif
+}
+
+static inline void shapeSeqlock_writeEnd(uint32_t *seq)
+{
+#if SHAPE_SEQLOCK
+    __atomic_store_n(seq, *seq + 1, __ATOMIC_RELEASE);
+#else
+    *seq += 1;
+#endif
+#if SHAPE_CHANGE_HOOK
+    shapeChange_notify(seq);
+#endif
+}
+
+/* Reader side: load, copy the data, readFence, load again and compare */
+
+static inline uint32_t shapeSeqlock_load(const uint32_t *seq)
+{
+#if SHAPE_SEQLOCK
+    return __atomic_load_n(seq, __ATOMIC_ACQUIRE);
+#else
+    return *seq;
+#endif
+}
+
+/* Protected fields: written inside the writer bracket, read by snapshots */
+
+static inline void shapeSeqlock_storeU32(uint32_t *field, uint32_t value)
+{
+#if SHAPE_SEQLOCK
+    __atomic_store_n(field, value, __ATOMIC_RELAXED);
+#else
+    *field = value;
+#endif
+}
+
+static inline uint32_t shapeSeqlock_loadU32(const uint32_t *field)
+{
+#if SHAPE_SEQLOCK
+    return __atomic_load_n(field, __ATOMIC_RELAXED);
+#else
+    return *field;
+#endif
+}
+
+static inline void shapeSeqlock_storeFloat(float *field, float value)
+{
+#if SHAPE_SEQLOCK
+    __atomic_store(field, &value, __ATOMIC_RELAXED);
+#else
+    *field = value;
+#endif
+}
+
+static inline float shapeSeqlock_loadFloat(const float *field)
+{
+#if SHAPE_SEQLOCK
+    float value;
+    __atomic_load(field, &value, __ATOMIC_RELAXED);
+    return value;
+#else
+    return *field;
+#endif
+}
+
+// Pointer fields of any type (e.g. a flyweight's shared geometry)
+#if SHAPE_SEQLOCK
+#define SHAPE_SEQLOCK_STORE_PTR(field, value) __atomic_store_n(&(field), (value), __ATOMIC_RELAXED)
+#define SHAPE_SEQLOCK_LOAD_PTR(field)         __atomic_load_n(&(field), __ATOMIC_RELAXED)
+#else
+#define SHAPE_SEQLOCK_STORE_PTR(field, value) ((field) = (value))
+#define SHAPE_SEQLOCK_LOAD_PTR(field)         (field)
+#endif
+
+// True while a writer is inside its update (never when disabled)
+static inline bool shapeSeqlock_isWriting(uint32_t seq)
+{
+    return SHAPE_SEQLOCK && (seq & 1u);
+}
+
+// Orders the data reads before the closing counter load
+static inline void shapeSeqlock_readFence(void)
+{
+#if SHAPE_SEQLOCK
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+#endif
+}
+
+#endif // SHAPE_SEQLOCK_H
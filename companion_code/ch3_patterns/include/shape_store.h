@@ -0,0 +1,98 @@
+#ifndef SHAPE_STORE_H
+#define SHAPE_STORE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "api_shape.h"
+#include "rectangle.h"
+#include "circle.h"
+#include "triangle.h"
+
+/*
+ * Structure-of-Arrays shape store.
+ * Shapes of the same type live in contiguous arrays (one lane per type),
+ * so scans over dimensions, color, visibility and cached area/perimeter
+ * stream through dense memory instead of chasing api_shape_t pointers.
+ *
+ * Every stored shape still gets an api_shape_t handle, so it works with
+ * shape_draw(), shape_get_area() and shape_get_perimeter().
+ */
+
+#define SHAPE_STORE_LANE_COUNT 3 // rectangle, circle, triangle
+
+struct shape_store;
+
+// Handle handed out by the store (behaves as an api_shape_t)
+typedef struct {
+    api_shape_t super;          // MUST be first (inheritance)
+    struct shape_store *store;  // Owning store
+    uint32_t index;             // Slot inside the type lane
+} shape_store_handle_t;
+
+// One lane per shape type. Arrays are carved from the caller memory.
+typedef struct {
+    uint32_t count;
+    uint32_t capacity;
+    shape_store_handle_t *handles;
+    uint32_t *dim_a;            // width  | radius | base
+    uint32_t *dim_b;            // height | unused | height
+    uint32_t *color;
+    bool *visible;
+    float *area;                // Dependent state (cached)
+    uint32_t *perimeter;        // Dependent state (cached)
+} shape_store_lane_t;
+
+typedef struct shape_store {
+    uint32_t generation;        // Bumped whenever any stored value changes
+    shape_store_lane_t lanes[SHAPE_STORE_LANE_COUNT];
+} shape_store_t;
+
+// Configuration Struct (CS-06)
+typedef struct {
+    void *memory;               // Caller provided storage
+    size_t memory_size;         // Size in bytes of memory
+    uint32_t capacity[SHAPE_STORE_LANE_COUNT]; // Shapes per type
+} shape_store_config_t;
+
+// Bytes needed per stored shape (all lane arrays for one slot)
+#define SHAPE_STORE_BYTES_PER_SHAPE \
+    (sizeof(shape_store_handle_t) + 4u * sizeof(uint32_t) + sizeof(float) + sizeof(bool))
+
+// Worst case memory for a store (includes alignment slack of every array)
+#define SHAPE_STORE_MEMORY_SIZE(n_rect, n_circle, n_tri) \
+    (((n_rect) + (n_circle) + (n_tri)) * SHAPE_STORE_BYTES_PER_SHAPE + \
+     SHAPE_STORE_LANE_COUNT * 8u * sizeof(void *))
+
+bool shapeStore_init(shape_store_t *self, const shape_store_config_t *config);
+
+void shapeStore_clear(shape_store_t *self);
+
+api_shape_t *shapeStore_addRectangle(shape_store_t *self, rect_config_t *rect_conf, shape_config_t *shape_conf);
+
+api_shape_t *shapeStore_addCircle(shape_store_t *self, circle_config_t *circle_conf, shape_config_t *shape_conf);
+
+api_shape_t *shapeStore_addTriangle(shape_store_t *self, triangle_config_t *tri_conf, shape_config_t *shape_conf);
+
+// Updates the dimensions of a stored shape (dim_b is ignored for circles)
+bool shapeStore_updateDimensions(api_shape_t *shape, uint32_t dim_a, uint32_t dim_b);
+
+void shapeStore_setVisible(api_shape_t *shape, bool visible);
+
+// Recomputes the cached area/perimeter of every lane with the batch kernels
+void shapeStore_refresh(shape_store_t *self);
+
+// Scales every stored dimension and refreshes the caches in the same pass.
+// The generation is bumped once for the whole batch.
+void shapeStore_scale(shape_store_t *self, float scale);
+
+uint32_t shapeStore_getCount(const shape_store_t *self, shape_type_t type);
+
+// Read-only access to the dense arrays of one type
+const shape_store_lane_t *shapeStore_getLane(const shape_store_t *self, shape_type_t type);
+
+// Single dense pass over all lanes; ties keep the first shape found
+void shapeStore_findBiggest(const shape_store_t *self, api_shape_t **biggestArea, api_shape_t **biggestPerimeter);
+
+#endif // SHAPE_STORE_H
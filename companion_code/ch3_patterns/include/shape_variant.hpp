@@ -0,0 +1,154 @@
+#ifndef SHAPE_VARIANT_HPP
+#define SHAPE_VARIANT_HPP
+
+/*
+ * Header-only C++17 layer over the api_shape family.
+ *
+ * cdp::rectangle / cdp::circle / cdp::triangle are CRTP adapters that wrap
+ * exactly one C object (api_rectangle_t, ...) and nothing else, so a pointer
+ * to the adapter is a valid pointer to the C struct: api() can be passed to
+ * canvas_addShape, shapeRegistry_Register or any other C API.
+ *
+ * cdp::shape_variant holds one of them by value. area/perimeter/draw are
+ * resolved with std::visit (a switch on the variant index) and call the
+ * C implementations directly: no vptr load and no indirect call.
+ *
+ * As with the C objects, do not move a shape after handing its api()
+ * pointer to a C module.
+ */
+
+#if __cplusplus < 201703L
+#error "shape_variant.hpp requires C++17"
+#endif
+
+#include <cstdint>
+#include <type_traits>
+#include <variant>
+
+extern "C" {
+    #include "api_rectangle.h"
+    #include "api_circle.h"
+    #include "api_triangle.h"
+}
+
+namespace cdp {
+
+// CRTP base: static dispatch to Derived::area_impl(), ...
+template <typename Derived, typename CObject>
+class shape_adapter {
+public:
+    using c_type = CObject;
+
+    float area() const { return derived().area_impl(); }
+    uint32_t perimeter() const { return derived().perimeter_impl(); }
+    void draw() { derived().draw_impl(); }
+
+    // Same address as the C object: usable with every C API
+    api_shape_t *api() { return &derived().object.super; }
+    const api_shape_t *api() const { return &derived().object.super; }
+    CObject &c_object() { return derived().object; }
+    const CObject &c_object() const { return derived().object; }
+
+    uint32_t color() const { return api()->base.color; }
+    bool visible() const { return api()->base.visible; }
+
+private:
+    Derived &derived() { return static_cast<Derived &>(*this); }
+    const Derived &derived() const { return static_cast<const Derived &>(*this); }
+};
+
+class rectangle : public shape_adapter<rectangle, api_rectangle_t> {
+public:
+    rectangle(rect_config_t conf, uint32_t color = 0, bool visible = true) : object{}
+    {
+        shape_config_t shape = {SHAPE_TYPE_RECTANGLE, color, visible};
+        api_rectangle_init(&object, &conf, &shape);
+    }
+
+    // Cached public fields: no call needed
+    float area_impl() const { return (float)object.rect.area; }
+    uint32_t perimeter_impl() const { return object.rect.perimeter; }
+    void draw_impl() { api_rectangle_draw(&object.super); }
+
+    api_rectangle_t object;
+};
+
+class circle : public shape_adapter<circle, api_circle_t> {
+public:
+    circle(circle_config_t conf, uint32_t color = 0, bool visible = true) : object{}
+    {
+        shape_config_t shape = {SHAPE_TYPE_CIRCLE, color, visible};
+        api_circle_init(&object, &conf, &shape);
+    }
+
+    // The opaque handle points into object.mem: rebind it on copy
+    circle(const circle &other) : object(other.object) { rebind(); }
+    circle &operator=(const circle &other)
+    {
+        object = other.object;
+        rebind();
+        return *this;
+    }
+
+    // Opaque type: go through the circle module accessors
+    float area_impl() const { return circle_getArea(object.circle); }
+    uint32_t perimeter_impl() const { return circle_getPerimeter(object.circle); }
+    void draw_impl() { api_circle_draw(&object.super); }
+
+    api_circle_t object;
+
+private:
+    void rebind() { object.circle = (hCircle_t)&object.mem; }
+};
+
+class triangle : public shape_adapter<triangle, api_triangle_t> {
+public:
+    triangle(triangle_config_t conf, uint32_t color = 0, bool visible = true) : object{}
+    {
+        shape_config_t shape = {SHAPE_TYPE_TRIANGLE, color, visible};
+        api_triangle_init(&object, &conf, &shape);
+    }
+
+    float area_impl() const { return object.triangle.area; }
+    uint32_t perimeter_impl() const { return 0; } // As api_triangle_get_perimeter
+    void draw_impl() { api_triangle_draw(&object.super); }
+
+    api_triangle_t object;
+};
+
+// Layout compatibility with the C structs is what makes api() legal
+#define CDP_CHECK_LAYOUT(adapter)                                                       \
+    static_assert(std::is_standard_layout<adapter>::value, #adapter " not standard layout"); \
+    static_assert(sizeof(adapter) == sizeof(adapter::c_type), #adapter " adds state")
+
+CDP_CHECK_LAYOUT(rectangle);
+CDP_CHECK_LAYOUT(circle);
+CDP_CHECK_LAYOUT(triangle);
+
+#undef CDP_CHECK_LAYOUT
+
+using shape_variant = std::variant<rectangle, circle, triangle>;
+
+inline float area(const shape_variant &shape)
+{
+    return std::visit([](const auto &s) { return s.area(); }, shape);
+}
+
+inline uint32_t perimeter(const shape_variant &shape)
+{
+    return std::visit([](const auto &s) { return s.perimeter(); }, shape);
+}
+
+inline void draw(shape_variant &shape)
+{
+    std::visit([](auto &s) { s.draw(); }, shape);
+}
+
+inline api_shape_t *api(shape_variant &shape)
+{
+    return std::visit([](auto &s) { return s.api(); }, shape);
+}
+
+} // namespace cdp
+
+#endif // SHAPE_VARIANT_HPP
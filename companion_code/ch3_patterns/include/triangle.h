@@ -2,6 +2,7 @@
 #define TRIANGLE_H
 
 #include <stdint.h>
+#include "shape_math.h"
 
 struct triangle;
 
@@ -12,6 +13,7 @@ typedef struct triangle * hTriangle_t;
 typedef struct triangle
 {
     const float area;
+    const uint32_t generation; // Bumped by every mutator (see shape_seqlock.h)
     
     _triangle_private_t _private;
 } triangle_t;
@@ -22,6 +24,14 @@ typedef struct
     uint32_t height;
 } triangle_config_t;
 
+// Compile-time initializer with the values triangle_init would compute (const/ROM objects)
+#define TRIANGLE_STATIC_INIT(b, h)                              \
+    {                                                           \
+        .area = SHAPE_MATH_TRIANGLE_AREA(b, h),                 \
+        .generation = 0,                                        \
+        ._private = { .base = (b), .height = (h) }              \
+    }
+
 void triangle_init(hTriangle_t self, triangle_config_t *config);
 
 void triangle_updateDimensions(hTriangle_t self, uint32_t base, uint32_t height);
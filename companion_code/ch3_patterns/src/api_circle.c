@@ -3,32 +3,61 @@
 
 // --- Interface Implementations ---
 
-static void draw(api_shape_t *self)
+void api_circle_draw(api_shape_t *self)
 {
     api_circle_t * this = (api_circle_t *)self;
     printf("Drawing Circle: Radius=%d, Color=%X\n", 
            circle_getRadius(this->circle), this->super.base.color);
 }
 
-static float get_area(api_shape_t *self)
+float api_circle_get_area(api_shape_t *self)
 {
     api_circle_t * this = (api_circle_t *)self;
     return circle_getArea(this->circle);
 }
 
-static uint32_t get_perimeter(api_shape_t *self)
+uint32_t api_circle_get_perimeter(api_shape_t *self)
 {
-    // Perimeter (Circumference) = 2 * pi * r
-    // Approximation for demo
     api_circle_t * this = (api_circle_t *)self;
-    return (uint32_t)(2 * 3.14159f * (float)circle_getRadius(this->circle));
+    return circle_getPerimeter(this->circle);
+}
+
+uint32_t api_circle_get_generation(api_shape_t *self)
+{
+    api_circle_t * this = (api_circle_t *)self;
+    return circle_getGeneration(this->circle);
+}
+
+static const void *get_change_key(api_shape_t *self)
+{
+    api_circle_t * this = (api_circle_t *)self;
+    return circle_getChangeKey(this->circle);
+}
+
+// Batch slots
+static void get_area_many(api_shape_t **shapes, uint32_t n, float *out)
+{
+    for (uint32_t i = 0; i < n; i++) {
+        out[i] = api_circle_get_area(shapes[i]);
+    }
+}
+
+static void get_perimeter_many(api_shape_t **shapes, uint32_t n, uint32_t *out)
+{
+    for (uint32_t i = 0; i < n; i++) {
+        out[i] = api_circle_get_perimeter(shapes[i]);
+    }
 }
 
 // --- VTable Definition ---
-static const shape_vtable_t circle_vtable = {
-    .draw = draw,
-    .get_area = get_area,
-    .get_perimeter = get_perimeter
+const shape_vtable_t api_circle_vtable = {
+    .draw = api_circle_draw,
+    .get_area = api_circle_get_area,
+    .get_perimeter = api_circle_get_perimeter,
+    .get_area_many = get_area_many,
+    .get_perimeter_many = get_perimeter_many,
+    .get_generation = api_circle_get_generation,
+    .get_change_key = get_change_key
 };
 
 // --- Initialization ---
@@ -36,7 +65,7 @@ static const shape_vtable_t circle_vtable = {
 void api_circle_init(api_circle_t *self, circle_config_t *circle_conf, shape_config_t *shape_conf)
 {
     // 1. Init API Base
-    api_shape_init(&self->super, shape_conf, &circle_vtable);
+    api_shape_init(&self->super, shape_conf, &api_circle_vtable);
 
     // 2. Init internal object
     // Pass address of memory block
@@ -1,9 +1,10 @@
 #include "api_rectangle.h"
+#include "shape_seqlock.h"
 #include <stdio.h> // For printf in draw
 
 // --- Interface Implementations ---
 
-static void draw(api_shape_t *self)
+void api_rectangle_draw(api_shape_t *self)
 {
     // Downcast to access specific data
     api_rectangle_t * this = (api_rectangle_t *)self;
@@ -11,24 +12,55 @@ static void draw(api_shape_t *self)
            this->rect.width, this->rect.height, this->super.base.color);
 }
 
-static float get_area(api_shape_t *self)
+float api_rectangle_get_area(api_shape_t *self)
 {
     api_rectangle_t * this = (api_rectangle_t *)self;
     return (float)rect_get_area(&this->rect);
 }
 
-static uint32_t get_perimeter(api_shape_t *self)
+uint32_t api_rectangle_get_perimeter(api_shape_t *self)
 {
     api_rectangle_t * this = (api_rectangle_t *)self;
-    return 2 * (this->rect.width + this->rect.height);
+    return rect_get_perimeter(&this->rect);
+}
+
+uint32_t api_rectangle_get_generation(api_shape_t *self)
+{
+    api_rectangle_t * this = (api_rectangle_t *)self;
+    return shapeSeqlock_load(&this->rect.generation);
+}
+
+static const void *get_change_key(api_shape_t *self)
+{
+    api_rectangle_t * this = (api_rectangle_t *)self;
+    return &this->rect.generation;
+}
+
+// Batch slots: direct (inlinable) calls instead of one indirect call per shape
+static void get_area_many(api_shape_t **shapes, uint32_t n, float *out)
+{
+    for (uint32_t i = 0; i < n; i++) {
+        out[i] = api_rectangle_get_area(shapes[i]);
+    }
+}
+
+static void get_perimeter_many(api_shape_t **shapes, uint32_t n, uint32_t *out)
+{
+    for (uint32_t i = 0; i < n; i++) {
+        out[i] = api_rectangle_get_perimeter(shapes[i]);
+    }
 }
 
 // --- VTable Definition ---
 // Defined specific to this class
-static const shape_vtable_t rectangle_vtable = {
-    .draw = draw,
-    .get_area = get_area,
-    .get_perimeter = get_perimeter
+const shape_vtable_t api_rectangle_vtable = {
+    .draw = api_rectangle_draw,
+    .get_area = api_rectangle_get_area,
+    .get_perimeter = api_rectangle_get_perimeter,
+    .get_area_many = get_area_many,
+    .get_perimeter_many = get_perimeter_many,
+    .get_generation = api_rectangle_get_generation,
+    .get_change_key = get_change_key
 };
 
 // --- Initialization ---
@@ -36,7 +68,7 @@ static const shape_vtable_t rectangle_vtable = {
 void api_rectangle_init(api_rectangle_t *self, rect_config_t *rect_conf, shape_config_t *shape_conf)
 {
     // 1. Initialize the API Base (sets vptr)
-    api_shape_init(&self->super, shape_conf, &rectangle_vtable);
+    api_shape_init(&self->super, shape_conf, &api_rectangle_vtable);
 
     // 2. Initialize the internal object
     rect_init(&self->rect, rect_conf);
@@ -1,4 +1,5 @@
 #include "api_shape.h"
+#include "shape_seqlock.h"
 #include <stddef.h>
 
 void api_shape_init(api_shape_t *self, shape_config_t *config, const shape_vtable_t *vptr)
@@ -14,6 +15,110 @@ void api_shape_init(api_shape_t *self, shape_config_t *config, const shape_vtabl
     self->vptr = vptr;
 }
 
+#if API_SHAPE_DEVIRTUALIZE
+#include "api_shape_types.h"
+
+/*
+ * Devirtualized dispatch: one switch generated from API_SHAPE_TYPE_LIST.
+ * The vptr compare keeps custom implementations that reuse a known type
+ * tag (e.g. shape_store handles) on their own vtable.
+ */
+#define DRAW_CASE(type, prefix, object)                     \
+    case type:                                              \
+        if (self->vptr == &prefix##_vtable) {               \
+            prefix##_draw(self);                            \
+            return;                                         \
+        }                                                   \
+        break;
+
+#define AREA_CASE(type, prefix, object)                     \
+    case type:                                              \
+        if (self->vptr == &prefix##_vtable) {               \
+            return prefix##_get_area(self);                 \
+        }                                                   \
+        break;
+
+#define PERIMETER_CASE(type, prefix, object)                \
+    case type:                                              \
+        if (self->vptr == &prefix##_vtable) {               \
+            return prefix##_get_perimeter(self);            \
+        }                                                   \
+        break;
+
+#define GENERATION_CASE(type, prefix, object)               \
+    case type:                                              \
+        if (self->vptr == &prefix##_vtable) {               \
+            *generation = prefix##_get_generation(self);    \
+            return true;                                    \
+        }                                                   \
+        break;
+
+void shape_draw(api_shape_t *self)
+{
+    if (self == NULL) {
+        return;
+    }
+    switch (self->base.type) {
+        API_SHAPE_TYPE_LIST(DRAW_CASE)
+        default:
+            break;
+    }
+    if (self->vptr && self->vptr->draw) {
+        self->vptr->draw(self);
+    }
+}
+
+float shape_get_area(api_shape_t *self)
+{
+    if (self == NULL) {
+        return 0.0f;
+    }
+    switch (self->base.type) {
+        API_SHAPE_TYPE_LIST(AREA_CASE)
+        default:
+            break;
+    }
+    if (self->vptr && self->vptr->get_area) {
+        return self->vptr->get_area(self);
+    }
+    return 0.0f;
+}
+
+uint32_t shape_get_perimeter(api_shape_t *self)
+{
+    if (self == NULL) {
+        return 0;
+    }
+    switch (self->base.type) {
+        API_SHAPE_TYPE_LIST(PERIMETER_CASE)
+        default:
+            break;
+    }
+    if (self->vptr && self->vptr->get_perimeter) {
+        return self->vptr->get_perimeter(self);
+    }
+    return 0;
+}
+
+bool shape_get_generation(api_shape_t *self, uint32_t *generation)
+{
+    if (self == NULL || generation == NULL) {
+        return false;
+    }
+    switch (self->base.type) {
+        API_SHAPE_TYPE_LIST(GENERATION_CASE)
+        default:
+            break;
+    }
+    if (self->vptr && self->vptr->get_generation) {
+        *generation = self->vptr->get_generation(self);
+        return true;
+    }
+    return false;
+}
+
+#else // Default: VTable dispatch
+
 void shape_draw(api_shape_t *self)
 {
     if (self && self->vptr && self->vptr->draw) {
@@ -36,3 +141,152 @@ uint32_t shape_get_perimeter(api_shape_t *self)
     }
     return 0;
 }
+
+bool shape_get_generation(api_shape_t *self, uint32_t *generation)
+{
+    if (self && generation && self->vptr && self->vptr->get_generation) {
+        *generation = self->vptr->get_generation(self);
+        return true;
+    }
+    return false;
+}
+
+#endif // API_SHAPE_DEVIRTUALIZE
+
+const void *shape_get_change_key(api_shape_t *self)
+{
+    if (self && self->vptr && self->vptr->get_change_key) {
+        return self->vptr->get_change_key(self);
+    }
+    return NULL;
+}
+
+bool shape_get_snapshot(api_shape_t *self, shape_snapshot_t *snapshot)
+{
+    uint32_t start = 0;
+    uint32_t end = 0;
+
+    if (self == NULL || snapshot == NULL) {
+        return false;
+    }
+    if (!shape_get_generation(self, &start)) {
+        snapshot->area = shape_get_area(self);
+        snapshot->perimeter = shape_get_perimeter(self);
+        snapshot->generation = 0;
+        return false;
+    }
+
+    for (;;) {
+        if (!shapeSeqlock_isWriting(start)) {
+            snapshot->area = shape_get_area(self);
+            snapshot->perimeter = shape_get_perimeter(self);
+            shapeSeqlock_readFence();
+            shape_get_generation(self, &end);
+            if (end == start) {
+                snapshot->generation = start;
+                return true;
+            }
+        }
+        shape_get_generation(self, &start);
+    }
+}
+
+/* Batch dispatch */
+
+#define SHAPE_DISPATCH_CHUNK 32     // Shapes gathered per batch slot call
+#define SHAPE_DISPATCH_MAX_TYPES 8  // Distinct vtables grouped per dispatch
+
+static bool has_batch_slot(const shape_vtable_t *vptr, float *area_out)
+{
+    if (vptr == NULL) {
+        return false;
+    }
+    return (area_out != NULL) ? (vptr->get_area_many != NULL) : (vptr->get_perimeter_many != NULL);
+}
+
+static void per_object(api_shape_t *shape, uint32_t index, float *area_out, uint32_t *perimeter_out)
+{
+    if (area_out != NULL) {
+        area_out[index] = shape_get_area(shape);
+    } else {
+        perimeter_out[index] = shape_get_perimeter(shape);
+    }
+}
+
+static void flush_group(const shape_vtable_t *vptr, api_shape_t **group, const uint32_t *index, uint32_t count,
+                        float *area_out, uint32_t *perimeter_out)
+{
+    float areas[SHAPE_DISPATCH_CHUNK];
+    uint32_t perimeters[SHAPE_DISPATCH_CHUNK];
+
+    if (area_out != NULL) {
+        vptr->get_area_many(group, count, areas);
+        for (uint32_t k = 0; k < count; k++) {
+            area_out[index[k]] = areas[k];
+        }
+    } else {
+        vptr->get_perimeter_many(group, count, perimeters);
+        for (uint32_t k = 0; k < count; k++) {
+            perimeter_out[index[k]] = perimeters[k];
+        }
+    }
+}
+
+// Exactly one of area_out / perimeter_out is used
+static void dispatch_many(api_shape_t **shapes, uint32_t n, float *area_out, uint32_t *perimeter_out)
+{
+    const shape_vtable_t *seen[SHAPE_DISPATCH_MAX_TYPES];
+    uint32_t seen_count = 0;
+    api_shape_t *group[SHAPE_DISPATCH_CHUNK];
+    uint32_t index[SHAPE_DISPATCH_CHUNK];
+
+    for (uint32_t i = 0; i < n; i++) {
+        const shape_vtable_t *vptr = (shapes[i] != NULL) ? shapes[i]->vptr : NULL;
+        bool grouped = false;
+
+        for (uint32_t s = 0; s < seen_count; s++) {
+            grouped |= (seen[s] == vptr);
+        }
+        if (grouped) {
+            continue; // Already handled with the first shape of its group
+        }
+        if (!has_batch_slot(vptr, area_out) || seen_count == SHAPE_DISPATCH_MAX_TYPES) {
+            per_object(shapes[i], i, area_out, perimeter_out);
+            continue;
+        }
+
+        // Gather every remaining shape of this vtable and call its batch slot per chunk
+        seen[seen_count++] = vptr;
+        uint32_t count = 0;
+        for (uint32_t j = i; j < n; j++) {
+            if (shapes[j] != NULL && shapes[j]->vptr == vptr) {
+                group[count] = shapes[j];
+                index[count] = j;
+                count++;
+                if (count == SHAPE_DISPATCH_CHUNK) {
+                    flush_group(vptr, group, index, count, area_out, perimeter_out);
+                    count = 0;
+                }
+            }
+        }
+        if (count > 0) {
+            flush_group(vptr, group, index, count, area_out, perimeter_out);
+        }
+    }
+}
+
+void shape_get_area_many(api_shape_t **shapes, uint32_t n, float *out)
+{
+    if (shapes == NULL || out == NULL) {
+        return;
+    }
+    dispatch_many(shapes, n, out, NULL);
+}
+
+void shape_get_perimeter_many(api_shape_t **shapes, uint32_t n, uint32_t *out)
+{
+    if (shapes == NULL || out == NULL) {
+        return;
+    }
+    dispatch_many(shapes, n, NULL, out);
+}
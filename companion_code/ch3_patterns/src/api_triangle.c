@@ -1,32 +1,64 @@
 #include "api_triangle.h"
+#include "shape_seqlock.h"
 #include <stdio.h>
 
 // --- Interface Implementations ---
 
-static void draw(api_shape_t *self)
+void api_triangle_draw(api_shape_t *self)
 {
     printf("Drawing Triangle: Color=%X\n", self->base.color);
 }
 
-static float get_area(api_shape_t *self)
+float api_triangle_get_area(api_shape_t *self)
 {
     api_triangle_t * this = (api_triangle_t *)self;
     // Direct access to public const field
-    return this->triangle.area;
+    return shapeSeqlock_loadFloat(&this->triangle.area);
 }
 
-static uint32_t get_perimeter(api_shape_t *self)
+uint32_t api_triangle_get_perimeter(api_shape_t *self)
 {
-    // Dummy implementation as triangle module doesn't expose perimeter logic nicely yet
+    // Base and height do not fix the other two sides: no perimeter
     (void)self;
     return 0;
 }
 
+uint32_t api_triangle_get_generation(api_shape_t *self)
+{
+    api_triangle_t * this = (api_triangle_t *)self;
+    return shapeSeqlock_load(&this->triangle.generation);
+}
+
+static const void *get_change_key(api_shape_t *self)
+{
+    api_triangle_t * this = (api_triangle_t *)self;
+    return &this->triangle.generation;
+}
+
+// Batch slots
+static void get_area_many(api_shape_t **shapes, uint32_t n, float *out)
+{
+    for (uint32_t i = 0; i < n; i++) {
+        out[i] = api_triangle_get_area(shapes[i]);
+    }
+}
+
+static void get_perimeter_many(api_shape_t **shapes, uint32_t n, uint32_t *out)
+{
+    for (uint32_t i = 0; i < n; i++) {
+        out[i] = api_triangle_get_perimeter(shapes[i]);
+    }
+}
+
 // --- VTable Definition ---
-static const shape_vtable_t triangle_vtable = {
-    .draw = draw,
-    .get_area = get_area,
-    .get_perimeter = get_perimeter
+const shape_vtable_t api_triangle_vtable = {
+    .draw = api_triangle_draw,
+    .get_area = api_triangle_get_area,
+    .get_perimeter = api_triangle_get_perimeter,
+    .get_area_many = get_area_many,
+    .get_perimeter_many = get_perimeter_many,
+    .get_generation = api_triangle_get_generation,
+    .get_change_key = get_change_key
 };
 
 // --- Initialization ---
@@ -34,7 +66,7 @@ static const shape_vtable_t triangle_vtable = {
 void api_triangle_init(api_triangle_t *self, triangle_config_t *tri_conf, shape_config_t *shape_conf)
 {
     // 1. Init API Base
-    api_shape_init(&self->super, shape_conf, &triangle_vtable);
+    api_shape_init(&self->super, shape_conf, &api_triangle_vtable);
 
     // 2. Init internal object
     triangle_init(&self->triangle, tri_conf);
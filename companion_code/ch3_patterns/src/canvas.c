@@ -1,4 +1,5 @@
 #include "canvas.h"
+#include "common.h"
 
 #include <string.h>
 
@@ -12,6 +13,10 @@ typedef struct canvas_move_observer_internal_s {
     void *context;
 } canvas_move_observer_internal_t;
 
+// The user-allocated canvas_move_observer_t must be able to hold the internal node
+STATIC_ASSERT(sizeof(canvas_move_observer_internal_t) <= sizeof(canvas_move_observer_t), observer_fits_CANVAS_OBSERVER_SIZE);
+STATIC_ASSERT(ALIGNOF(canvas_move_observer_internal_t) <= ALIGNOF(canvas_move_observer_t), observer_alignment);
+
 /* Shape item tracked by canvas */
 typedef struct {
     api_shape_t *shape;
@@ -38,6 +43,7 @@ static canvas_private_t priv_canvas = {0};
 
 static int32_t find_item_index(api_shape_t *shape);
 static void update_position(canvas_item_t *item);
+static int16_t transform_coordinate(int16_t value, float scale, int16_t offset);
 
 void canvas_init(const canvas_config_t *config)
 {
@@ -160,6 +166,20 @@ bool canvas_isMoving(api_shape_t *shape)
     return false;
 }
 
+void canvas_transform(float scale, int16_t dx, int16_t dy)
+{
+    for (int32_t i = 0; i < CANVAS_MAX_SHAPES; i++) {
+        canvas_item_t *item = &priv_canvas.items[i];
+        if (item->shape == NULL) {
+            continue;
+        }
+        item->current_x = transform_coordinate(item->current_x, scale, dx);
+        item->current_y = transform_coordinate(item->current_y, scale, dy);
+        item->target_x = transform_coordinate(item->target_x, scale, dx);
+        item->target_y = transform_coordinate(item->target_y, scale, dy);
+    }
+}
+
 static int32_t find_item_index(api_shape_t *shape)
 {
     for (int32_t i = 0; i < CANVAS_MAX_SHAPES; i++) {
@@ -211,3 +231,16 @@ static void update_position(canvas_item_t *item)
         item->is_moving = false;
     }
 }
+
+static int16_t transform_coordinate(int16_t value, float scale, int16_t offset)
+{
+    float result = (float)value * scale + (float)offset;
+
+    if (result >= (float)INT16_MAX) {
+        return INT16_MAX;
+    }
+    if (!(result > (float)INT16_MIN)) { // NaN included
+        return INT16_MIN;
+    }
+    return (int16_t)result;
+}
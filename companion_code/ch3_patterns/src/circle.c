@@ -1,44 +1,72 @@
 #include "circle.h"
 #include <stddef.h> // For NULL
-
-// Internal constant
-#define PI 3.14159f
+#include "shape_math.h"
+#include "shape_seqlock.h"
+#include "common.h"
 
 // This is completely hidden from the user size, the size must be manually set in CIRCLE_SIZE
 struct circle {
     uint32_t radius;
-    float    area;     // Dependent state: area = PI * r^2
+    float    area;       // Dependent state: area = PI * r^2
+    uint32_t perimeter;  // Dependent state: perimeter = 2 * PI * r
+    uint32_t generation; // Bumped by every mutator
 };
 
+// The build fails if CIRCLE_SIZE is too small or the storage is under-aligned
+STATIC_ASSERT(sizeof(struct circle) <= sizeof(circle_memory_t), circle_fits_CIRCLE_SIZE);
+STATIC_ASSERT(ALIGNOF(struct circle) <= ALIGNOF(circle_memory_t), circle_memory_alignment);
+
+// CIRCLE_MEMORY_STATIC_INIT writes through circle_memory_t._init: the layouts must match
+STATIC_ASSERT(offsetof(struct circle, radius) == offsetof(circle_memory_t, _init._radius) &&
+              offsetof(struct circle, area) == offsetof(circle_memory_t, _init._area) &&
+              offsetof(struct circle, perimeter) == offsetof(circle_memory_t, _init._perimeter) &&
+              offsetof(struct circle, generation) == offsetof(circle_memory_t, _init._generation),
+              circle_init_view_matches_layout);
+
 hCircle_t circle_init(circle_memory_t *mem, circle_config_t *config)
 {
-    if (sizeof(struct circle) > sizeof(circle_memory_t))
-    {
-        return NULL; // Error: Header size constant is too small!
-    }
-    // CASTING MAGIC:    // We treat the raw memory block provided by the user as our specific struct.
+    // CASTING MAGIC (size and alignment are checked at compile time above):    // We treat the raw memory block provided by the user as our specific struct.
     struct circle *self = (struct circle *)mem;
 
     // Initialize state
     self->radius = config->radius;
-    self->area = (float)(self->radius * self->radius) * PI;
+    self->area = shapeMath_circleArea(self->radius);
+    self->perimeter = shapeMath_circlePerimeter(self->radius);
+    self->generation = 0;
 
     // Return the pointer cast as the opaque handle type
     return (hCircle_t)self;
 }
 
 void circle_updateRadius(hCircle_t self, uint32_t radius) {
+    shapeSeqlock_writeBegin(&self->generation);
+
     // 1. Update the primary state
-    self->radius = radius;
+    shapeSeqlock_storeU32(&self->radius, radius);
     
     // 2. AUTOMATICALLY update the dependent state.
-    self->area = (float)(radius * radius) * PI;
+    shapeSeqlock_storeFloat(&self->area, shapeMath_circleArea(radius));
+    shapeSeqlock_storeU32(&self->perimeter, shapeMath_circlePerimeter(radius));
+
+    shapeSeqlock_writeEnd(&self->generation);
 }
 
 uint32_t circle_getRadius(hCircle_t self) {
-    return self->radius;
+    return shapeSeqlock_loadU32(&self->radius);
 }
 
 float circle_getArea(hCircle_t self) {
-    return self->area;
-}
\ No newline at end of file
+    return shapeSeqlock_loadFloat(&self->area);
+}
+
+uint32_t circle_getPerimeter(hCircle_t self) {
+    return shapeSeqlock_loadU32(&self->perimeter);
+}
+
+uint32_t circle_getGeneration(hCircle_t self) {
+    return shapeSeqlock_load(&self->generation);
+}
+
+const void *circle_getChangeKey(hCircle_t self) {
+    return &self->generation;
+}
@@ -1,4 +1,20 @@
 #include "factory_shape.h"
+#include "common.h"
+#include <stddef.h>
+#include <string.h>
+
+#define TYPE_COUNT 3 // rectangle, circle, triangle
+
+typedef struct {
+    factory_config_t *configs;
+    api_shape_storage_t *storage;
+    uint32_t run_end[TYPE_COUNT];   // Exclusive end slot of each type run
+    uint32_t grain;
+} create_many_t;
+
+static void create_job(void *job_context, uint32_t job);
+static void build_slots(const create_many_t *batch, uint32_t begin, uint32_t end);
+static uint32_t take_config_index(api_shape_storage_t *slot);
 
 api_shape_t* factory_shape_create(api_shape_t * shape, factory_config_t * config)
 {
@@ -28,3 +44,126 @@ api_shape_t* factory_shape_create(api_shape_t * shape, factory_config_t * config
             return NULL;
     }
 }
+
+#define SIZEOF_CASE(type, prefix, object)   case type: return sizeof(object);
+#define ALIGNOF_CASE(type, prefix, object)  case type: return ALIGNOF(object);
+
+size_t factory_shape_sizeof(shape_type_t type)
+{
+    switch (type) {
+        API_SHAPE_TYPE_LIST(SIZEOF_CASE)
+        default:
+            return 0;
+    }
+}
+
+size_t factory_shape_alignof(shape_type_t type)
+{
+    switch (type) {
+        API_SHAPE_TYPE_LIST(ALIGNOF_CASE)
+        default:
+            return 0;
+    }
+}
+
+
+uint32_t factory_shape_create_many(factory_config_t *configs, uint32_t n, api_shape_storage_t *storage,
+                                   api_shape_t **shapes, const factory_executor_t *executor)
+{
+    if (configs == NULL || storage == NULL || shapes == NULL) {
+        return 0;
+    }
+
+    // Counting sort: size of each type run, then its first slot
+    uint32_t next[TYPE_COUNT] = {0};
+    for (uint32_t i = 0; i < n; i++) {
+        uint32_t t = (uint32_t)configs[i].shape_conf.type - SHAPE_TYPE_RECTANGLE;
+        if (t < TYPE_COUNT) {
+            next[t]++;
+        }
+    }
+
+    create_many_t batch = {configs, storage, {0}, FACTORY_CREATE_MANY_GRAIN};
+    uint32_t total = 0;
+    for (uint32_t t = 0; t < TYPE_COUNT; t++) {
+        uint32_t count = next[t];
+        next[t] = total;
+        total += count;
+        batch.run_end[t] = total;
+    }
+
+    // Until it is built, a slot holds the index of its config
+    for (uint32_t i = 0; i < n; i++) {
+        uint32_t t = (uint32_t)configs[i].shape_conf.type - SHAPE_TYPE_RECTANGLE;
+        if (t < TYPE_COUNT) {
+            uint32_t slot = next[t]++;
+            memcpy(&storage[slot], &i, sizeof(i));
+            shapes[i] = &storage[slot].super;
+        } else {
+            shapes[i] = NULL;
+        }
+    }
+
+    if (executor != NULL && executor->run_jobs != NULL) {
+        if (executor->grain > 0) {
+            batch.grain = executor->grain;
+        }
+        if (total > batch.grain) {
+            executor->run_jobs(executor->context, create_job, &batch, (total + batch.grain - 1) / batch.grain);
+            return total;
+        }
+    }
+
+    build_slots(&batch, 0, total);
+    return total;
+}
+
+/* Static helper functions */
+
+static void create_job(void *job_context, uint32_t job)
+{
+    const create_many_t *batch = (const create_many_t *)job_context;
+    uint32_t total = batch->run_end[TYPE_COUNT - 1];
+    uint32_t begin = job * batch->grain;
+    uint32_t end = (total - begin > batch->grain) ? begin + batch->grain : total;
+
+    build_slots(batch, begin, end);
+}
+
+// Constructs slots [lo, hi) of one type run
+#define BUILD_RUN(prefix, member)                                                           \
+    for (uint32_t slot = lo; slot < hi; slot++) {                                           \
+        factory_config_t *config = &batch->configs[take_config_index(&batch->storage[slot])]; \
+        prefix##_init(&batch->storage[slot].prefix, &config->shape.member, &config->shape_conf); \
+    }
+
+// Builds slots [begin, end): one branch per type run, not per shape
+static void build_slots(const create_many_t *batch, uint32_t begin, uint32_t end)
+{
+    uint32_t run_begin = 0;
+
+    for (uint32_t t = 0; t < TYPE_COUNT; t++) {
+        uint32_t lo = (begin > run_begin) ? begin : run_begin;
+        uint32_t hi = (end < batch->run_end[t]) ? end : batch->run_end[t];
+        run_begin = batch->run_end[t];
+
+        switch (t + SHAPE_TYPE_RECTANGLE) {
+            case SHAPE_TYPE_RECTANGLE:
+                BUILD_RUN(api_rectangle, rect);
+                break;
+            case SHAPE_TYPE_CIRCLE:
+                BUILD_RUN(api_circle, circle);
+                break;
+            default:
+                BUILD_RUN(api_triangle, triangle);
+                break;
+        }
+    }
+}
+
+static uint32_t take_config_index(api_shape_storage_t *slot)
+{
+    uint32_t index;
+    memcpy(&index, slot, sizeof(index));
+    return index;
+}
@@ -1,19 +1,52 @@
-
 #include "rectangle.h"
+#include "shape_math.h"
+#include "shape_seqlock.h"
+
+static void update_dependent_state(rectangle_t *self);
 
 void rect_init(rectangle_t *self, rect_config_t * conf) {
     self->width = conf->width;
     self->height = conf->height;
-    rect_get_area(self);
+    *(uint32_t *)&self->generation = 0;
+    update_dependent_state(self);
 }
 
 uint32_t rect_get_area(rectangle_t *self) {
-    *(uint32_t *)&self->area = self->height * self->width;
-    return self->area;
+    return shapeSeqlock_loadU32(&self->area); // Refreshed by the mutators
+}
+
+uint32_t rect_get_perimeter(rectangle_t *self)
+{
+    return shapeSeqlock_loadU32(&self->perimeter);
 }
 
 void rect_updateWidth(rectangle_t *self, uint32_t newWidth)
 {
-    *(uint32_t *)&self->width = newWidth;
-    rect_get_area(self);
-}
\ No newline at end of file
+    shapeSeqlock_writeBegin((uint32_t *)&self->generation);
+    shapeSeqlock_storeU32((uint32_t *)&self->width, newWidth);
+    update_dependent_state(self);
+    shapeSeqlock_writeEnd((uint32_t *)&self->generation);
+}
+
+void rect_updateHeight(rectangle_t *self, uint32_t newHeight)
+{
+    shapeSeqlock_writeBegin((uint32_t *)&self->generation);
+    shapeSeqlock_storeU32(&self->height, newHeight);
+    update_dependent_state(self);
+    shapeSeqlock_writeEnd((uint32_t *)&self->generation);
+}
+
+void rect_updateDimensions(rectangle_t *self, uint32_t newWidth, uint32_t newHeight)
+{
+    shapeSeqlock_writeBegin((uint32_t *)&self->generation);
+    shapeSeqlock_storeU32(&self->width, newWidth);
+    shapeSeqlock_storeU32(&self->height, newHeight);
+    update_dependent_state(self);
+    shapeSeqlock_writeEnd((uint32_t *)&self->generation);
+}
+
+static void update_dependent_state(rectangle_t *self)
+{
+    shapeSeqlock_storeU32((uint32_t *)&self->area, self->height * self->width);
+    shapeSeqlock_storeU32((uint32_t *)&self->perimeter, shapeMath_rectPerimeter(self->width, self->height));
+}
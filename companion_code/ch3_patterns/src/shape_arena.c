@@ -0,0 +1,107 @@
+#include "shape_arena.h"
+#include "shape_registry.h"
+#include "common.h"
+#include <string.h>
+
+static void reset_scene(shape_arena_t *self);
+
+// --- Public API ---
+
+bool shapeArena_init(shape_arena_t *self, const shape_arena_config_t *config)
+{
+    if (self == NULL || config == NULL || config->memory == NULL) {
+        return false;
+    }
+
+    memset(self, 0, sizeof(shape_arena_t));
+    self->base = (uint8_t *)config->memory;
+    self->size = config->memory_size;
+
+    if (config->canvas != NULL) {
+        self->owns_scene = true;
+        self->canvas = *config->canvas;
+        reset_scene(self);
+    }
+    return true;
+}
+
+void *shapeArena_alloc(shape_arena_t *self, size_t size, size_t align)
+{
+    if (self == NULL || align == 0 || (align & (align - 1)) != 0) {
+        return NULL;
+    }
+
+    size_t padding = ALIGN_PADDING(self->base + self->used, align);
+
+    if (padding > self->size - self->used || size > self->size - self->used - padding) {
+        return NULL; // Error: arena is full
+    }
+
+    void *block = self->base + self->used + padding;
+    self->used += padding + size;
+    if (self->used > self->high_water) {
+        self->high_water = self->used;
+    }
+    return block;
+}
+
+api_shape_t *shapeArena_create(shape_arena_t *self, factory_config_t *config)
+{
+    if (config == NULL) {
+        return NULL;
+    }
+
+    size_t size = factory_shape_sizeof(config->shape_conf.type);
+    if (size == 0) {
+        return NULL; // Error: unknown type
+    }
+
+    api_shape_t *shape = (api_shape_t *)shapeArena_alloc(self, size, factory_shape_alignof(config->shape_conf.type));
+    if (shape == NULL) {
+        return NULL;
+    }
+    return factory_shape_create(shape, config);
+}
+
+canvas_move_observer_t *shapeArena_addMoveObserver(shape_arena_t *self, canvas_moveCallback_t callback,
+                                                   void *context)
+{
+    canvas_move_observer_t *observer =
+        (canvas_move_observer_t *)shapeArena_alloc(self, sizeof(canvas_move_observer_t),
+                                                   ALIGNOF(canvas_move_observer_t));
+    if (observer != NULL) {
+        canvas_register_move_observer(observer, callback, context);
+    }
+    return observer;
+}
+
+void shapeArena_reset(shape_arena_t *self)
+{
+    if (self == NULL) {
+        return;
+    }
+
+    self->used = 0;
+    if (self->owns_scene) {
+        reset_scene(self);
+    }
+}
+
+size_t shapeArena_getUsed(const shape_arena_t *self)
+{
+    return (self != NULL) ? self->used : 0;
+}
+
+size_t shapeArena_getHighWater(const shape_arena_t *self)
+{
+    return (self != NULL) ? self->high_water : 0;
+}
+
+/* Static helper functions */
+
+// Both singletons only reference arena memory, so both are cleared together
+static void reset_scene(shape_arena_t *self)
+{
+    canvas_init(&self->canvas);
+    shapeRegistry_Init();
+}
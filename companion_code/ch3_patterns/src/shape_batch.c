@@ -0,0 +1,262 @@
+#include "shape_batch.h"
+#include "shape_math.h"
+#include <stddef.h>
+
+/*
+ * Backend selection. Each backend provides the same small set of vector
+ * helpers so every kernel below is written only once.
+ * The fixed point math backend always uses the scalar formulas.
+ */
+#if SHAPE_MATH_FIXED_POINT
+#undef SHAPE_BATCH_USE_SIMD
+#define SHAPE_BATCH_USE_SIMD 0
+#endif
+
+#if SHAPE_BATCH_USE_SIMD && defined(__AVX2__)
+#include <immintrin.h>
+#define BATCH_WIDTH 8
+#define BATCH_BACKEND "avx2"
+typedef __m256i vec_u32_t;
+typedef __m256 vec_f32_t;
+
+#define vec_load_u32(p)        _mm256_loadu_si256((const __m256i *)(p))
+#define vec_store_u32(p, v)    _mm256_storeu_si256((__m256i *)(p), (v))
+#define vec_store_f32(p, v)    _mm256_storeu_ps((p), (v))
+#define vec_set_u32(x)         _mm256_set1_epi32((int32_t)(x))
+#define vec_set_f32(x)         _mm256_set1_ps(x)
+#define vec_add_u32(a, b)      _mm256_add_epi32((a), (b))
+#define vec_mul_u32(a, b)      _mm256_mullo_epi32((a), (b))
+#define vec_and_u32(a, b)      _mm256_and_si256((a), (b))
+#define vec_xor_u32(a, b)      _mm256_xor_si256((a), (b))
+#define vec_shr_u32(a, n)      _mm256_srli_epi32((a), (n))
+#define vec_add_f32(a, b)      _mm256_add_ps((a), (b))
+#define vec_sub_f32(a, b)      _mm256_sub_ps((a), (b))
+#define vec_mul_f32(a, b)      _mm256_mul_ps((a), (b))
+#define vec_and_f32(a, b)      _mm256_and_ps((a), (b))
+#define vec_min_f32(a, b)      _mm256_min_ps((a), (b))
+#define vec_max_f32(a, b)      _mm256_max_ps((a), (b))
+#define vec_ge_f32(a, b)       _mm256_cmp_ps((a), (b), _CMP_GE_OQ)
+#define vec_i32_to_f32(a)      _mm256_cvtepi32_ps(a)
+#define vec_f32_to_i32(a)      _mm256_cvttps_epi32(a)
+#define vec_f32_as_u32(a)      _mm256_castps_si256(a)
+
+#elif SHAPE_BATCH_USE_SIMD && (defined(__SSE2__) || defined(_M_X64))
+#include <emmintrin.h>
+#define BATCH_WIDTH 4
+#define BATCH_BACKEND "sse2"
+typedef __m128i vec_u32_t;
+typedef __m128 vec_f32_t;
+
+// SSE2 has no 32-bit low multiply: combine two 32x32->64 products
+static inline __m128i mullo_epi32_sse2(__m128i a, __m128i b)
+{
+    __m128i even = _mm_mul_epu32(a, b);
+    __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                              _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+#define vec_load_u32(p)        _mm_loadu_si128((const __m128i *)(p))
+#define vec_store_u32(p, v)    _mm_storeu_si128((__m128i *)(p), (v))
+#define vec_store_f32(p, v)    _mm_storeu_ps((p), (v))
+#define vec_set_u32(x)         _mm_set1_epi32((int32_t)(x))
+#define vec_set_f32(x)         _mm_set1_ps(x)
+#define vec_add_u32(a, b)      _mm_add_epi32((a), (b))
+#define vec_mul_u32(a, b)      mullo_epi32_sse2((a), (b))
+#define vec_and_u32(a, b)      _mm_and_si128((a), (b))
+#define vec_xor_u32(a, b)      _mm_xor_si128((a), (b))
+#define vec_shr_u32(a, n)      _mm_srli_epi32((a), (n))
+#define vec_add_f32(a, b)      _mm_add_ps((a), (b))
+#define vec_sub_f32(a, b)      _mm_sub_ps((a), (b))
+#define vec_mul_f32(a, b)      _mm_mul_ps((a), (b))
+#define vec_and_f32(a, b)      _mm_and_ps((a), (b))
+#define vec_min_f32(a, b)      _mm_min_ps((a), (b))
+#define vec_max_f32(a, b)      _mm_max_ps((a), (b))
+#define vec_ge_f32(a, b)       _mm_cmpge_ps((a), (b))
+#define vec_i32_to_f32(a)      _mm_cvtepi32_ps(a)
+#define vec_f32_to_i32(a)      _mm_cvttps_epi32(a)
+#define vec_f32_as_u32(a)      _mm_castps_si128(a)
+
+#else
+#define BATCH_WIDTH 1
+#define BATCH_BACKEND "scalar"
+#endif
+
+#if BATCH_WIDTH > 1
+/*
+ * Exact uint32 -> float: the hardware only converts signed lanes, so the
+ * value is split in 16-bit halves. hi * 65536 is exact and the final add
+ * rounds once, which matches the scalar (float) cast.
+ */
+static inline vec_f32_t vec_u32_to_f32(vec_u32_t x)
+{
+    vec_f32_t hi = vec_i32_to_f32(vec_shr_u32(x, 16));
+    vec_f32_t lo = vec_i32_to_f32(vec_and_u32(x, vec_set_u32(0xFFFFu)));
+    return vec_add_f32(vec_mul_f32(hi, vec_set_f32(65536.0f)), lo);
+}
+
+// Truncating float -> uint32 for the full [0, 2^32) range, like the scalar cast
+static inline vec_u32_t vec_f32_to_u32(vec_f32_t x)
+{
+    vec_f32_t two31 = vec_set_f32(2147483648.0f);
+    vec_f32_t big = vec_ge_f32(x, two31);
+    vec_u32_t low = vec_f32_to_i32(vec_sub_f32(x, vec_and_f32(big, two31)));
+    return vec_xor_u32(low, vec_and_u32(vec_f32_as_u32(big), vec_set_u32(0x80000000u)));
+}
+#endif
+
+/* Static kernels: SIMD main loop, scalar tail with the reference formula */
+
+static void rect_area_n(const uint32_t *w, const uint32_t *h, float *out, uint32_t n)
+{
+    uint32_t i = 0;
+#if BATCH_WIDTH > 1
+    for (; i + BATCH_WIDTH <= n; i += BATCH_WIDTH) {
+        vec_u32_t prod = vec_mul_u32(vec_load_u32(&w[i]), vec_load_u32(&h[i]));
+        vec_store_f32(&out[i], vec_u32_to_f32(prod));
+    }
+#endif
+    for (; i < n; i++) {
+        out[i] = shapeMath_rectArea(w[i], h[i]);
+    }
+}
+
+static void rect_perimeter_n(const uint32_t *w, const uint32_t *h, uint32_t *out, uint32_t n)
+{
+    uint32_t i = 0;
+#if BATCH_WIDTH > 1
+    for (; i + BATCH_WIDTH <= n; i += BATCH_WIDTH) {
+        vec_u32_t sum = vec_add_u32(vec_load_u32(&w[i]), vec_load_u32(&h[i]));
+        vec_store_u32(&out[i], vec_add_u32(sum, sum));
+    }
+#endif
+    for (; i < n; i++) {
+        out[i] = shapeMath_rectPerimeter(w[i], h[i]);
+    }
+}
+
+static void circle_area_n(const uint32_t *r, float *out, uint32_t n)
+{
+    uint32_t i = 0;
+#if BATCH_WIDTH > 1
+    vec_f32_t pi = vec_set_f32(SHAPE_MATH_PI);
+    for (; i + BATCH_WIDTH <= n; i += BATCH_WIDTH) {
+        vec_f32_t radius = vec_u32_to_f32(vec_load_u32(&r[i]));
+        vec_store_f32(&out[i], vec_mul_f32(vec_mul_f32(radius, radius), pi));
+    }
+#endif
+    for (; i < n; i++) {
+        out[i] = shapeMath_circleArea(r[i]);
+    }
+}
+
+static void circle_perimeter_n(const uint32_t *r, uint32_t *out, uint32_t n)
+{
+    uint32_t i = 0;
+#if BATCH_WIDTH > 1
+    vec_f32_t two_pi = vec_set_f32(2 * SHAPE_MATH_PI);
+    for (; i + BATCH_WIDTH <= n; i += BATCH_WIDTH) {
+        vec_f32_t radius = vec_u32_to_f32(vec_load_u32(&r[i]));
+        vec_store_u32(&out[i], vec_f32_to_u32(vec_mul_f32(two_pi, radius)));
+    }
+#endif
+    for (; i < n; i++) {
+        out[i] = shapeMath_circlePerimeter(r[i]);
+    }
+}
+
+static void triangle_area_n(const uint32_t *b, const uint32_t *h, float *out, uint32_t n)
+{
+    uint32_t i = 0;
+#if BATCH_WIDTH > 1
+    // x * 0.5f is exact and equal to x / 2.0f
+    vec_f32_t half = vec_set_f32(0.5f);
+    for (; i + BATCH_WIDTH <= n; i += BATCH_WIDTH) {
+        vec_f32_t prod = vec_mul_f32(vec_u32_to_f32(vec_load_u32(&b[i])), vec_u32_to_f32(vec_load_u32(&h[i])));
+        vec_store_f32(&out[i], vec_mul_f32(prod, half));
+    }
+#endif
+    for (; i < n; i++) {
+        out[i] = shapeMath_triangleArea(b[i], h[i]);
+    }
+}
+
+// Same as api_triangle_get_perimeter: base and height do not fix the sides
+static void triangle_perimeter_n(uint32_t *out, uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++) {
+        out[i] = 0;
+    }
+}
+
+// --- Public API ---
+
+void shape_get_area_n(shape_type_t type, const uint32_t *dim_a, const uint32_t *dim_b, float *out, uint32_t n)
+{
+    if (dim_a == NULL || out == NULL || (dim_b == NULL && type != SHAPE_TYPE_CIRCLE)) {
+        return;
+    }
+
+    switch (type) {
+        case SHAPE_TYPE_RECTANGLE:
+            rect_area_n(dim_a, dim_b, out, n);
+            break;
+        case SHAPE_TYPE_CIRCLE:
+            circle_area_n(dim_a, out, n);
+            break;
+        case SHAPE_TYPE_TRIANGLE:
+            triangle_area_n(dim_a, dim_b, out, n);
+            break;
+        default:
+            break;
+    }
+}
+
+void shape_get_perimeter_n(shape_type_t type, const uint32_t *dim_a, const uint32_t *dim_b, uint32_t *out, uint32_t n)
+{
+    if (dim_a == NULL || out == NULL || (dim_b == NULL && type != SHAPE_TYPE_CIRCLE)) {
+        return;
+    }
+
+    switch (type) {
+        case SHAPE_TYPE_RECTANGLE:
+            rect_perimeter_n(dim_a, dim_b, out, n);
+            break;
+        case SHAPE_TYPE_CIRCLE:
+            circle_perimeter_n(dim_a, out, n);
+            break;
+        case SHAPE_TYPE_TRIANGLE:
+            triangle_perimeter_n(out, n);
+            break;
+        default:
+            break;
+    }
+}
+
+void shape_scale_n(uint32_t *dim, float scale, uint32_t n)
+{
+    if (dim == NULL) {
+        return;
+    }
+
+    uint32_t i = 0;
+#if BATCH_WIDTH > 1
+    vec_f32_t factor = vec_set_f32(scale);
+    vec_f32_t zero = vec_set_f32(0.0f);
+    vec_f32_t limit = vec_set_f32(SHAPE_MATH_SCALE_MAX);
+    for (; i + BATCH_WIDTH <= n; i += BATCH_WIDTH) {
+        vec_f32_t value = vec_mul_f32(vec_u32_to_f32(vec_load_u32(&dim[i])), factor);
+        // max(value, 0) also maps NaN to 0, like the scalar reference
+        value = vec_min_f32(vec_max_f32(value, zero), limit);
+        vec_store_u32(&dim[i], vec_f32_to_u32(value));
+    }
+#endif
+    for (; i < n; i++) {
+        dim[i] = shapeMath_scaleDim(dim[i], scale);
+    }
+}
+
+const char *shapeBatch_getBackend(void)
+{
+    return BATCH_BACKEND;
+}
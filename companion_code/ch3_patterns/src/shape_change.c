@@ -0,0 +1,53 @@
+#include "shape_change.h"
+#include <stddef.h>
+
+typedef struct {
+    shape_change_hook_t hook;
+    void *context;
+} change_hook_entry_t;
+
+static change_hook_entry_t g_hooks[SHAPE_CHANGE_MAX_HOOKS];
+static uint32_t g_hook_count = 0;
+
+bool shapeChange_addHook(shape_change_hook_t hook, void *context)
+{
+    if (hook == NULL || g_hook_count >= SHAPE_CHANGE_MAX_HOOKS) {
+        return false;
+    }
+    for (uint32_t i = 0; i < g_hook_count; i++) {
+        if (g_hooks[i].hook == hook && g_hooks[i].context == context) {
+            return false; // Already installed: it would see every change twice
+        }
+    }
+    g_hooks[g_hook_count].hook = hook;
+    g_hooks[g_hook_count].context = context;
+    g_hook_count++;
+    return true;
+}
+
+bool shapeChange_removeHook(shape_change_hook_t hook, void *context)
+{
+    for (uint32_t i = 0; i < g_hook_count; i++) {
+        if (g_hooks[i].hook == hook && g_hooks[i].context == context) {
+            // Keep the call order of the others
+            for (uint32_t j = i + 1u; j < g_hook_count; j++) {
+                g_hooks[j - 1u] = g_hooks[j];
+            }
+            g_hook_count--;
+            return true;
+        }
+    }
+    return false;
+}
+
+void shapeChange_removeAll(void)
+{
+    g_hook_count = 0;
+}
+
+void shapeChange_notify(const void *key)
+{
+    for (uint32_t i = 0; i < g_hook_count; i++) {
+        g_hooks[i].hook(g_hooks[i].context, key);
+    }
+}
@@ -0,0 +1,261 @@
+#include "shape_compact.h"
+#include "shape_math.h"
+#include "common.h"
+#include <stddef.h>
+#include <stdio.h>
+
+#define TYPE_MASK    0x7Fu
+#define VISIBLE_FLAG 0x80u
+
+STATIC_ASSERT(sizeof(shape_compact_t) == 8, shape_compact_is_8_bytes);
+STATIC_ASSERT(SHAPE_COMPACT_MAX_VTABLES <= 256, vtable_index_fits_8_bits);
+STATIC_ASSERT(SHAPE_TYPE_TRIANGLE < SHAPE_COMPACT_MAX_VTABLES, in_tree_vtables_fit);
+
+static bool init_shape(shape_compact_t *self, shape_config_t *shape_conf, shape_type_t type,
+                       uint32_t dim_a, uint32_t dim_b);
+static uint16_t pack_color(uint32_t color);
+static uint32_t unpack_color(uint16_t color);
+static const shape_compact_vtable_t *vtable_of(const shape_compact_t *self);
+
+// --- In-tree Implementations ---
+
+static void compact_rect_draw(const shape_compact_t *self)
+{
+    printf("Drawing Compact Rectangle: Width=%u, Height=%u, Color=%X\n",
+           self->_dim_a, self->_dim_b, shapeCompact_getColor(self));
+}
+
+static float compact_rect_get_area(const shape_compact_t *self)
+{
+    return shapeMath_rectArea(self->_dim_a, self->_dim_b);
+}
+
+static uint32_t compact_rect_get_perimeter(const shape_compact_t *self)
+{
+    return shapeMath_rectPerimeter(self->_dim_a, self->_dim_b);
+}
+
+static void compact_circle_draw(const shape_compact_t *self)
+{
+    printf("Drawing Compact Circle: Radius=%u, Color=%X\n", self->_dim_a, shapeCompact_getColor(self));
+}
+
+static float compact_circle_get_area(const shape_compact_t *self)
+{
+    return shapeMath_circleArea(self->_dim_a);
+}
+
+static uint32_t compact_circle_get_perimeter(const shape_compact_t *self)
+{
+    return shapeMath_circlePerimeter(self->_dim_a);
+}
+
+static void compact_triangle_draw(const shape_compact_t *self)
+{
+    printf("Drawing Compact Triangle: Color=%X\n", shapeCompact_getColor(self));
+}
+
+static float compact_triangle_get_area(const shape_compact_t *self)
+{
+    return shapeMath_triangleArea(self->_dim_a, self->_dim_b);
+}
+
+static uint32_t compact_triangle_get_perimeter(const shape_compact_t *self)
+{
+    // As api_triangle_get_perimeter
+    (void)self;
+    return 0;
+}
+
+static const shape_compact_vtable_t rect_vtable = {compact_rect_draw, compact_rect_get_area, compact_rect_get_perimeter};
+static const shape_compact_vtable_t circle_vtable = {compact_circle_draw, compact_circle_get_area, compact_circle_get_perimeter};
+static const shape_compact_vtable_t triangle_vtable = {compact_triangle_draw, compact_triangle_get_area, compact_triangle_get_perimeter};
+
+// --- VTable Table ---
+// The in-tree types sit at their shape_type_t value; custom types follow
+static const shape_compact_vtable_t *g_vtables[SHAPE_COMPACT_MAX_VTABLES] = {
+    [SHAPE_TYPE_RECTANGLE] = &rect_vtable,
+    [SHAPE_TYPE_CIRCLE] = &circle_vtable,
+    [SHAPE_TYPE_TRIANGLE] = &triangle_vtable,
+};
+static uint8_t g_vtable_count = SHAPE_TYPE_TRIANGLE + 1;
+
+// --- Public API ---
+
+bool shapeCompact_initRectangle(shape_compact_t *self, rect_config_t *rect_conf, shape_config_t *shape_conf)
+{
+    if (rect_conf == NULL) {
+        return false;
+    }
+    return init_shape(self, shape_conf, SHAPE_TYPE_RECTANGLE, rect_conf->width, rect_conf->height);
+}
+
+bool shapeCompact_initCircle(shape_compact_t *self, circle_config_t *circle_conf, shape_config_t *shape_conf)
+{
+    if (circle_conf == NULL) {
+        return false;
+    }
+    return init_shape(self, shape_conf, SHAPE_TYPE_CIRCLE, circle_conf->radius, 0);
+}
+
+bool shapeCompact_initTriangle(shape_compact_t *self, triangle_config_t *tri_conf, shape_config_t *shape_conf)
+{
+    if (tri_conf == NULL) {
+        return false;
+    }
+    return init_shape(self, shape_conf, SHAPE_TYPE_TRIANGLE, tri_conf->base, tri_conf->height);
+}
+
+uint8_t shapeCompact_registerVtable(const shape_compact_vtable_t *vtable)
+{
+    if (vtable == NULL || g_vtable_count >= SHAPE_COMPACT_MAX_VTABLES) {
+        return SHAPE_COMPACT_NO_VTABLE;
+    }
+    g_vtables[g_vtable_count] = vtable;
+    return g_vtable_count++;
+}
+
+bool shapeCompact_setVtable(shape_compact_t *self, uint8_t index)
+{
+    if (self == NULL || index >= g_vtable_count || g_vtables[index] == NULL) {
+        return false;
+    }
+    self->_vtable = index;
+    return true;
+}
+
+shape_type_t shapeCompact_getType(const shape_compact_t *self)
+{
+    return (shape_type_t)(self->_type_flags & TYPE_MASK);
+}
+
+bool shapeCompact_isVisible(const shape_compact_t *self)
+{
+    return (self->_type_flags & VISIBLE_FLAG) != 0;
+}
+
+void shapeCompact_setVisible(shape_compact_t *self, bool visible)
+{
+    self->_type_flags = (uint8_t)((self->_type_flags & TYPE_MASK) | (visible ? VISIBLE_FLAG : 0));
+}
+
+uint32_t shapeCompact_getColor(const shape_compact_t *self)
+{
+    return unpack_color(self->_color);
+}
+
+void shapeCompact_setColor(shape_compact_t *self, uint32_t color)
+{
+    self->_color = pack_color(color);
+}
+
+uint32_t shapeCompact_getDimA(const shape_compact_t *self)
+{
+    return self->_dim_a;
+}
+
+uint32_t shapeCompact_getDimB(const shape_compact_t *self)
+{
+    return self->_dim_b;
+}
+
+bool shapeCompact_setDimensions(shape_compact_t *self, uint32_t dim_a, uint32_t dim_b)
+{
+    if (shapeCompact_getType(self) == SHAPE_TYPE_CIRCLE) {
+        dim_b = 0;
+    }
+    if (dim_a > SHAPE_COMPACT_MAX_DIMENSION || dim_b > SHAPE_COMPACT_MAX_DIMENSION) {
+        return false;
+    }
+    self->_dim_a = (uint16_t)dim_a;
+    self->_dim_b = (uint16_t)dim_b;
+    return true;
+}
+
+void shapeCompact_draw(const shape_compact_t *self)
+{
+    const shape_compact_vtable_t *vptr = vtable_of(self);
+    if (vptr && vptr->draw) {
+        vptr->draw(self);
+    }
+}
+
+float shapeCompact_getArea(const shape_compact_t *self)
+{
+    const shape_compact_vtable_t *vptr = vtable_of(self);
+    if (vptr && vptr->get_area) {
+        return vptr->get_area(self);
+    }
+    return 0.0f;
+}
+
+uint32_t shapeCompact_getPerimeter(const shape_compact_t *self)
+{
+    const shape_compact_vtable_t *vptr = vtable_of(self);
+    if (vptr && vptr->get_perimeter) {
+        return vptr->get_perimeter(self);
+    }
+    return 0;
+}
+
+/* Static helper functions */
+
+// NULL for a NULL shape or an index that was never registered (e.g. corrupt data)
+static const shape_compact_vtable_t *vtable_of(const shape_compact_t *self)
+{
+    if (self == NULL || self->_vtable >= g_vtable_count) {
+        return NULL;
+    }
+    return g_vtables[self->_vtable];
+}
+
+static bool init_shape(shape_compact_t *self, shape_config_t *shape_conf, shape_type_t type,
+                       uint32_t dim_a, uint32_t dim_b)
+{
+    if (self == NULL || shape_conf == NULL || shape_conf->type != type) {
+        return false;
+    }
+
+    self->_type_flags = (uint8_t)type;
+    self->_vtable = (uint8_t)type;
+    shapeCompact_setVisible(self, shape_conf->visible);
+    shapeCompact_setColor(self, shape_conf->color);
+    return shapeCompact_setDimensions(self, dim_a, dim_b);
+}
+
+#if SHAPE_COMPACT_COLOR_PALETTE
+
+static uint16_t pack_color(uint32_t color)
+{
+    return (uint16_t)color;
+}
+
+static uint32_t unpack_color(uint16_t color)
+{
+    return color;
+}
+
+#else
+
+// 0xRRGGBB -> RRRRRGGGGGGBBBBB
+static uint16_t pack_color(uint32_t color)
+{
+    uint32_t r = (color >> 16) & 0xFFu;
+    uint32_t g = (color >> 8) & 0xFFu;
+    uint32_t b = color & 0xFFu;
+    return (uint16_t)(((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3));
+}
+
+// Replicates the high bits so 0x1F -> 0xFF and 0 -> 0
+static uint32_t unpack_color(uint16_t color)
+{
+    uint32_t r = (color >> 11) & 0x1Fu;
+    uint32_t g = (color >> 5) & 0x3Fu;
+    uint32_t b = color & 0x1Fu;
+    r = (r << 3) | (r >> 2);
+    g = (g << 2) | (g >> 4);
+    b = (b << 3) | (b >> 2);
+    return (r << 16) | (g << 8) | b;
+}
+
+#endif // SHAPE_COMPACT_COLOR_PALETTE
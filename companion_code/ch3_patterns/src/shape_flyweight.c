@@ -0,0 +1,341 @@
+#include "shape_flyweight.h"
+#include "shape_math.h"
+#include "shape_seqlock.h"
+#include "shape_hash.h"
+#include "common.h"
+#include <stdio.h>
+#include <string.h>
+
+typedef struct {
+    shape_type_t type;
+    uint32_t dim_a;
+    uint32_t dim_b;
+} geometry_key_t;
+
+static uint32_t hash_key(shape_type_t type, uint32_t dim_a, uint32_t dim_b);
+static bool geometry_matches(const void *context, uint32_t entry, const void *key);
+static uint32_t geometry_hash(const void *context, uint32_t entry);
+static uint32_t find_bucket(const shape_flyweight_table_t *self, shape_type_t type, uint32_t dim_a, uint32_t dim_b);
+static shape_geometry_t *intern(shape_flyweight_table_t *self, shape_type_t type, uint32_t dim_a, uint32_t dim_b);
+static void release(shape_flyweight_table_t *self, shape_geometry_t *geometry);
+static bool init_shape(shape_flyweight_table_t *self, shape_flyweight_t *shape, shape_config_t *shape_conf,
+                       shape_type_t type, uint32_t dim_a, uint32_t dim_b);
+static shape_geometry_t *owned_geometry(shape_flyweight_table_t *self, api_shape_t *shape);
+
+// --- Interface Implementations ---
+
+static void draw(api_shape_t *self)
+{
+    shape_flyweight_t *this = (shape_flyweight_t *)self;
+
+    printf("Drawing Flyweight Shape: Type=%d, A=%u, B=%u, Color=%X\n", (int)self->base.type,
+           this->geometry->dim_a, this->geometry->dim_b, self->base.color);
+}
+
+static float get_area(api_shape_t *self)
+{
+    return SHAPE_SEQLOCK_LOAD_PTR(((shape_flyweight_t *)self)->geometry)->area;
+}
+
+static uint32_t get_perimeter(api_shape_t *self)
+{
+    return SHAPE_SEQLOCK_LOAD_PTR(((shape_flyweight_t *)self)->geometry)->perimeter;
+}
+
+static uint32_t get_generation(api_shape_t *self)
+{
+    return shapeSeqlock_load(&((shape_flyweight_t *)self)->generation);
+}
+
+static const void *get_change_key(api_shape_t *self)
+{
+    return &((shape_flyweight_t *)self)->generation;
+}
+
+static void get_area_many(api_shape_t **shapes, uint32_t n, float *out)
+{
+    for (uint32_t i = 0; i < n; i++) {
+        out[i] = get_area(shapes[i]);
+    }
+}
+
+static void get_perimeter_many(api_shape_t **shapes, uint32_t n, uint32_t *out)
+{
+    for (uint32_t i = 0; i < n; i++) {
+        out[i] = get_perimeter(shapes[i]);
+    }
+}
+
+// --- VTable Definition ---
+static const shape_vtable_t flyweight_vtable = {
+    .draw = draw,
+    .get_area = get_area,
+    .get_perimeter = get_perimeter,
+    .get_area_many = get_area_many,
+    .get_perimeter_many = get_perimeter_many,
+    .get_generation = get_generation,
+    .get_change_key = get_change_key
+};
+
+// --- Public API ---
+
+bool shapeFlyweight_init(shape_flyweight_table_t *self, const shape_flyweight_config_t *config)
+{
+    if (self == NULL || config == NULL || config->memory == NULL || config->capacity == 0 ||
+        (config->capacity & (config->capacity - 1)) != 0 || config->capacity > UINT32_MAX / 2) {
+        return false;
+    }
+
+    memset(self, 0, sizeof(shape_flyweight_table_t));
+
+    uint8_t *cursor = (uint8_t *)config->memory;
+    size_t remaining = config->memory_size;
+    uint32_t bucket_count = 2u * config->capacity; // Load factor <= 0.5 keeps probes short
+
+    self->geometries = common_carve(&cursor, &remaining, config->capacity * sizeof(shape_geometry_t), sizeof(uint32_t));
+    self->buckets = common_carve(&cursor, &remaining, bucket_count * sizeof(uint32_t), sizeof(uint32_t));
+    if (self->geometries == NULL || self->buckets == NULL) {
+        memset(self, 0, sizeof(shape_flyweight_table_t));
+        return false; // Error: memory block is too small for the requested capacity
+    }
+
+    memset(self->buckets, 0, bucket_count * sizeof(uint32_t));
+    self->capacity = config->capacity;
+    self->bucket_mask = bucket_count - 1u;
+
+    // Every slot starts on the free list (linked through dim_a)
+    for (uint32_t i = 0; i < self->capacity; i++) {
+        self->geometries[i].refs = 0;
+        self->geometries[i].dim_a = i + 1u;
+    }
+    self->free_head = 0;
+    return true;
+}
+
+bool shapeFlyweight_initRectangle(shape_flyweight_table_t *self, shape_flyweight_t *shape, rect_config_t *rect_conf,
+                                  shape_config_t *shape_conf)
+{
+    if (rect_conf == NULL) {
+        return false;
+    }
+    return init_shape(self, shape, shape_conf, SHAPE_TYPE_RECTANGLE, rect_conf->width, rect_conf->height);
+}
+
+bool shapeFlyweight_initCircle(shape_flyweight_table_t *self, shape_flyweight_t *shape,
+                               circle_config_t *circle_conf, shape_config_t *shape_conf)
+{
+    if (circle_conf == NULL) {
+        return false;
+    }
+    return init_shape(self, shape, shape_conf, SHAPE_TYPE_CIRCLE, circle_conf->radius, 0);
+}
+
+bool shapeFlyweight_initTriangle(shape_flyweight_table_t *self, shape_flyweight_t *shape,
+                                 triangle_config_t *tri_conf, shape_config_t *shape_conf)
+{
+    if (tri_conf == NULL) {
+        return false;
+    }
+    return init_shape(self, shape, shape_conf, SHAPE_TYPE_TRIANGLE, tri_conf->base, tri_conf->height);
+}
+
+bool shapeFlyweight_resize(shape_flyweight_table_t *self, api_shape_t *shape, uint32_t dim_a, uint32_t dim_b)
+{
+    shape_geometry_t *old = owned_geometry(self, shape);
+    if (old == NULL) {
+        return false;
+    }
+    if (old->type == SHAPE_TYPE_CIRCLE) {
+        dim_b = 0;
+    }
+    if (old->dim_a == dim_a && old->dim_b == dim_b) {
+        return true;
+    }
+
+    // Intern first: on failure the instance keeps its old geometry
+    shape_geometry_t *geometry = intern(self, old->type, dim_a, dim_b);
+    if (geometry == NULL) {
+        return false;
+    }
+
+    shape_flyweight_t *this = (shape_flyweight_t *)shape;
+    shapeSeqlock_writeBegin(&this->generation);
+    SHAPE_SEQLOCK_STORE_PTR(this->geometry, geometry);
+    shapeSeqlock_writeEnd(&this->generation);
+
+    release(self, old);
+    return true;
+}
+
+void shapeFlyweight_release(shape_flyweight_table_t *self, api_shape_t *shape)
+{
+    shape_geometry_t *geometry = owned_geometry(self, shape);
+    if (geometry == NULL) {
+        return;
+    }
+
+    ((shape_flyweight_t *)shape)->geometry = NULL;
+    shape->vptr = NULL; // Released instances no longer dispatch
+    release(self, geometry);
+}
+
+const shape_geometry_t *shapeFlyweight_getGeometry(const api_shape_t *shape)
+{
+    if (shape == NULL || shape->vptr != &flyweight_vtable) {
+        return NULL;
+    }
+    return ((const shape_flyweight_t *)shape)->geometry;
+}
+
+uint32_t shapeFlyweight_getUniqueCount(const shape_flyweight_table_t *self)
+{
+    return (self != NULL) ? self->unique : 0;
+}
+
+void shapeFlyweight_findBiggest(const shape_flyweight_table_t *self, const shape_geometry_t **biggestArea,
+                                const shape_geometry_t **biggestPerimeter)
+{
+    const shape_geometry_t *area = NULL;
+    const shape_geometry_t *perimeter = NULL;
+
+    for (uint32_t i = 0; self != NULL && i < self->capacity; i++) {
+        const shape_geometry_t *geometry = &self->geometries[i];
+        if (geometry->refs == 0) {
+            continue;
+        }
+        if (area == NULL || geometry->area > area->area) {
+            area = geometry;
+        }
+        if (perimeter == NULL || geometry->perimeter > perimeter->perimeter) {
+            perimeter = geometry;
+        }
+    }
+
+    if (biggestArea != NULL) {
+        *biggestArea = area;
+    }
+    if (biggestPerimeter != NULL) {
+        *biggestPerimeter = perimeter;
+    }
+}
+
+/* Static helper functions */
+
+static uint32_t hash_key(shape_type_t type, uint32_t dim_a, uint32_t dim_b)
+{
+    uint32_t h = (uint32_t)type * 0x9E3779B1u;
+    h ^= dim_a * 0x85EBCA77u;
+    h = (h << 13) | (h >> 19);
+    h ^= dim_b * 0xC2B2AE3Du;
+    h ^= h >> 16;
+    return h;
+}
+
+static bool geometry_matches(const void *context, uint32_t entry, const void *key)
+{
+    const shape_geometry_t *geometry = &((const shape_flyweight_table_t *)context)->geometries[entry];
+    const geometry_key_t *k = (const geometry_key_t *)key;
+    return geometry->type == k->type && geometry->dim_a == k->dim_a && geometry->dim_b == k->dim_b;
+}
+
+static uint32_t geometry_hash(const void *context, uint32_t entry)
+{
+    const shape_geometry_t *geometry = &((const shape_flyweight_table_t *)context)->geometries[entry];
+    return hash_key(geometry->type, geometry->dim_a, geometry->dim_b);
+}
+
+// Bucket holding the key, or the empty bucket where it would go
+static uint32_t find_bucket(const shape_flyweight_table_t *self, shape_type_t type, uint32_t dim_a, uint32_t dim_b)
+{
+    geometry_key_t key = {type, dim_a, dim_b};
+    return shapeHash_find(self->buckets, self->bucket_mask, hash_key(type, dim_a, dim_b), geometry_matches, self, &key);
+}
+
+static shape_geometry_t *intern(shape_flyweight_table_t *self, shape_type_t type, uint32_t dim_a, uint32_t dim_b)
+{
+    uint32_t bucket = find_bucket(self, type, dim_a, dim_b);
+
+    if (self->buckets[bucket] != 0) {
+        shape_geometry_t *geometry = &self->geometries[self->buckets[bucket] - 1u];
+        geometry->refs++;
+        return geometry;
+    }
+
+    if (self->free_head == self->capacity) {
+        return NULL; // Error: every slot holds a distinct geometry
+    }
+
+    uint32_t index = self->free_head;
+    shape_geometry_t *geometry = &self->geometries[index];
+    self->free_head = geometry->dim_a;
+
+    geometry->type = type;
+    geometry->dim_a = dim_a;
+    geometry->dim_b = dim_b;
+    geometry->refs = 1;
+    switch (type) {
+        case SHAPE_TYPE_RECTANGLE:
+            geometry->area = shapeMath_rectArea(dim_a, dim_b);
+            geometry->perimeter = shapeMath_rectPerimeter(dim_a, dim_b);
+            break;
+        case SHAPE_TYPE_CIRCLE:
+            geometry->area = shapeMath_circleArea(dim_a);
+            geometry->perimeter = shapeMath_circlePerimeter(dim_a);
+            break;
+        default:
+            geometry->area = shapeMath_triangleArea(dim_a, dim_b);
+            geometry->perimeter = 0; // As api_triangle_get_perimeter
+            break;
+    }
+
+    self->buckets[bucket] = index + 1u;
+    self->unique++;
+    return geometry;
+}
+
+// Last reference: unlink the bucket (see shape_hash.h) and free the slot
+static void release(shape_flyweight_table_t *self, shape_geometry_t *geometry)
+{
+    if (--geometry->refs > 0) {
+        return;
+    }
+
+    uint32_t hole = find_bucket(self, geometry->type, geometry->dim_a, geometry->dim_b);
+    shapeHash_remove(self->buckets, self->bucket_mask, hole, geometry_hash, self);
+
+    geometry->dim_a = self->free_head;
+    self->free_head = (uint32_t)(geometry - self->geometries);
+    self->unique--;
+}
+
+static bool init_shape(shape_flyweight_table_t *self, shape_flyweight_t *shape, shape_config_t *shape_conf,
+                       shape_type_t type, uint32_t dim_a, uint32_t dim_b)
+{
+    if (self == NULL || shape == NULL || shape_conf == NULL || shape_conf->type != type) {
+        return false;
+    }
+
+    shape_geometry_t *geometry = intern(self, type, dim_a, dim_b);
+    if (geometry == NULL) {
+        return false;
+    }
+
+    api_shape_init(&shape->super, shape_conf, &flyweight_vtable);
+    shape->geometry = geometry;
+    shape->generation = 0;
+    return true;
+}
+
+// The instance's geometry, if the instance was interned by this table
+static shape_geometry_t *owned_geometry(shape_flyweight_table_t *self, api_shape_t *shape)
+{
+    if (self == NULL || shape == NULL || shape->vptr != &flyweight_vtable) {
+        return NULL;
+    }
+
+    const shape_geometry_t *geometry = ((shape_flyweight_t *)shape)->geometry;
+    if (geometry < self->geometries || geometry >= self->geometries + self->capacity) {
+        return NULL;
+    }
+    return (shape_geometry_t *)geometry;
+}
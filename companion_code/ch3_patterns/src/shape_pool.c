@@ -0,0 +1,300 @@
+#include "shape_pool.h"
+#include "common.h"
+#include <string.h>
+
+// A free block stores the link to the next free block in its first bytes
+typedef struct pool_node {
+    struct pool_node *next;
+    uintptr_t marker;       // free_marker(node) while free, cleared when handed out
+} pool_node_t;
+
+// Address-dependent, so a live shape's bytes are unlikely to look free
+#define POOL_FREE_MARKER 0x5EEDF00Du
+
+#define NODE_FITS(type, name) \
+    STATIC_ASSERT(sizeof(type) >= sizeof(pool_node_t) && ALIGNOF(type) >= ALIGNOF(pool_node_t), name)
+
+NODE_FITS(api_rectangle_t, rectangle_block_holds_node);
+NODE_FITS(api_circle_t, circle_block_holds_node);
+NODE_FITS(api_triangle_t, triangle_block_holds_node);
+
+static shape_pool_slab_t *slab_of_type(shape_pool_t *self, shape_type_t type);
+static shape_pool_slab_t *slab_of_block(shape_pool_t *self, const void *block);
+static void *take(shape_pool_slab_t *slab);
+static void give(shape_pool_slab_t *slab, void *block);
+static uintptr_t free_marker(const void *block);
+static bool is_free(const void *block);
+static void lock(shape_pool_t *self);
+static void unlock(shape_pool_t *self);
+
+// --- Public API ---
+
+bool shapePool_init(shape_pool_t *self, const shape_pool_config_t *config)
+{
+    if (self == NULL || config == NULL || config->memory == NULL ||
+        (config->lock == NULL) != (config->unlock == NULL)) {
+        return false;
+    }
+
+    memset(self, 0, sizeof(shape_pool_t));
+
+    uint8_t *cursor = (uint8_t *)config->memory;
+    size_t remaining = config->memory_size;
+
+    for (uint32_t i = 0; i < SHAPE_POOL_TYPE_COUNT; i++) {
+        shape_type_t type = (shape_type_t)(SHAPE_TYPE_RECTANGLE + i);
+        shape_pool_slab_t *slab = &self->slabs[i];
+
+        slab->block_size = factory_shape_sizeof(type);
+        // Division first: capacity * block_size cannot overflow once it fits
+        slab->base = (remaining / slab->block_size < config->capacity[i])
+                         ? NULL
+                         : common_carve(&cursor, &remaining, config->capacity[i] * slab->block_size,
+                                        factory_shape_alignof(type));
+        if (slab->base == NULL) {
+            memset(self, 0, sizeof(shape_pool_t));
+            return false; // Error: memory block is too small for the requested capacity
+        }
+        slab->stats.capacity = config->capacity[i];
+
+        // Chain the blocks in address order: the first alloc gets the first block
+        for (uint32_t b = config->capacity[i]; b > 0; b--) {
+            pool_node_t *node = (pool_node_t *)(slab->base + (b - 1) * slab->block_size);
+            node->next = slab->free_list;
+            node->marker = free_marker(node);
+            slab->free_list = node;
+        }
+    }
+
+    self->lock = config->lock;
+    self->unlock = config->unlock;
+    self->lock_context = config->lock_context;
+    return true;
+}
+
+api_shape_t *shapePool_alloc(shape_pool_t *self, shape_type_t type)
+{
+    shape_pool_slab_t *slab = slab_of_type(self, type);
+    if (slab == NULL) {
+        return NULL;
+    }
+
+    lock(self);
+    void *block = take(slab);
+    if (block == NULL) {
+        slab->stats.failed++;
+    }
+    unlock(self);
+    return (api_shape_t *)block;
+}
+
+bool shapePool_free(shape_pool_t *self, api_shape_t *shape)
+{
+    shape_pool_slab_t *slab = slab_of_block(self, shape);
+    if (slab == NULL) {
+        return false;
+    }
+
+    lock(self);
+    bool was_free = is_free(shape);
+    if (!was_free) {
+        give(slab, shape);
+    }
+    unlock(self);
+    return !was_free; // A double free leaves the free list and in_use untouched
+}
+
+api_shape_t *shapePool_create(shape_pool_t *self, factory_config_t *config)
+{
+    if (config == NULL) {
+        return NULL;
+    }
+
+    api_shape_t *shape = shapePool_alloc(self, config->shape_conf.type);
+    if (shape != NULL && factory_shape_create(shape, config) == NULL) {
+        shapePool_free(self, shape);
+        shape = NULL;
+    }
+    return shape;
+}
+
+bool shapePool_getStats(const shape_pool_t *self, shape_type_t type, shape_pool_stats_t *stats)
+{
+    const shape_pool_slab_t *slab = slab_of_type((shape_pool_t *)self, type);
+    if (slab == NULL || stats == NULL) {
+        return false;
+    }
+    *stats = slab->stats;
+    return true;
+}
+
+// --- Thread cache ---
+
+void shapePool_cacheInit(shape_pool_cache_t *cache, shape_pool_t *pool)
+{
+    memset(cache, 0, sizeof(shape_pool_cache_t));
+    cache->pool = pool;
+}
+
+api_shape_t *shapePool_cacheAlloc(shape_pool_cache_t *cache, shape_type_t type)
+{
+    shape_pool_slab_t *slab = slab_of_type(cache->pool, type);
+    if (slab == NULL) {
+        return NULL;
+    }
+
+    uint32_t t = type - SHAPE_TYPE_RECTANGLE;
+    if (cache->count[t] == 0) {
+        // Refill half the cache under a single lock
+        lock(cache->pool);
+        while (cache->count[t] < SHAPE_POOL_CACHE_SIZE / 2) {
+            void *block = take(slab);
+            if (block == NULL) {
+                break;
+            }
+            cache->blocks[t][cache->count[t]++] = block;
+        }
+        if (cache->count[t] == 0) {
+            slab->stats.failed++; // A partial refill still serves this call
+        }
+        unlock(cache->pool);
+
+        if (cache->count[t] == 0) {
+            return NULL;
+        }
+    }
+    pool_node_t *node = (pool_node_t *)cache->blocks[t][--cache->count[t]];
+    node->marker = 0;
+    return (api_shape_t *)node;
+}
+
+bool shapePool_cacheFree(shape_pool_cache_t *cache, api_shape_t *shape)
+{
+    shape_pool_slab_t *slab = slab_of_block(cache->pool, shape);
+    if (slab == NULL || is_free(shape)) {
+        return false;
+    }
+
+    uint32_t t = (uint32_t)(slab - cache->pool->slabs);
+    if (cache->count[t] == SHAPE_POOL_CACHE_SIZE) {
+        // Return the older half under a single lock
+        lock(cache->pool);
+        for (uint32_t i = 0; i < SHAPE_POOL_CACHE_SIZE / 2; i++) {
+            give(slab, cache->blocks[t][i]);
+        }
+        unlock(cache->pool);
+
+        memmove(&cache->blocks[t][0], &cache->blocks[t][SHAPE_POOL_CACHE_SIZE / 2],
+                (SHAPE_POOL_CACHE_SIZE - SHAPE_POOL_CACHE_SIZE / 2) * sizeof(void *));
+        cache->count[t] -= SHAPE_POOL_CACHE_SIZE / 2;
+    }
+    ((pool_node_t *)shape)->marker = free_marker(shape); // Cached blocks count as free
+    cache->blocks[t][cache->count[t]++] = shape;
+    return true;
+}
+
+api_shape_t *shapePool_cacheCreate(shape_pool_cache_t *cache, factory_config_t *config)
+{
+    if (config == NULL) {
+        return NULL;
+    }
+
+    api_shape_t *shape = shapePool_cacheAlloc(cache, config->shape_conf.type);
+    if (shape != NULL && factory_shape_create(shape, config) == NULL) {
+        shapePool_cacheFree(cache, shape);
+        shape = NULL;
+    }
+    return shape;
+}
+
+void shapePool_cacheFlush(shape_pool_cache_t *cache)
+{
+    lock(cache->pool);
+    for (uint32_t t = 0; t < SHAPE_POOL_TYPE_COUNT; t++) {
+        while (cache->count[t] > 0) {
+            give(&cache->pool->slabs[t], cache->blocks[t][--cache->count[t]]);
+        }
+    }
+    unlock(cache->pool);
+}
+
+/* Static helper functions */
+
+static shape_pool_slab_t *slab_of_type(shape_pool_t *self, shape_type_t type)
+{
+    if (self == NULL || type < SHAPE_TYPE_RECTANGLE || type > SHAPE_TYPE_TRIANGLE) {
+        return NULL;
+    }
+    return &self->slabs[type - SHAPE_TYPE_RECTANGLE];
+}
+
+// Address range check: a block belongs to at most one slab
+static shape_pool_slab_t *slab_of_block(shape_pool_t *self, const void *block)
+{
+    if (self == NULL || block == NULL) {
+        return NULL;
+    }
+
+    for (uint32_t i = 0; i < SHAPE_POOL_TYPE_COUNT; i++) {
+        shape_pool_slab_t *slab = &self->slabs[i];
+        const uint8_t *p = (const uint8_t *)block;
+        size_t span = slab->stats.capacity * slab->block_size;
+
+        if (p >= slab->base && p < slab->base + span && (size_t)(p - slab->base) % slab->block_size == 0) {
+            return slab;
+        }
+    }
+    return NULL;
+}
+
+// Caller holds the lock
+static void *take(shape_pool_slab_t *slab)
+{
+    pool_node_t *node = (pool_node_t *)slab->free_list;
+    if (node == NULL) {
+        return NULL;
+    }
+
+    slab->free_list = node->next;
+    node->marker = 0;
+    slab->stats.in_use++;
+    if (slab->stats.in_use > slab->stats.high_water) {
+        slab->stats.high_water = slab->stats.in_use;
+    }
+    return node;
+}
+
+// Caller holds the lock
+static void give(shape_pool_slab_t *slab, void *block)
+{
+    pool_node_t *node = (pool_node_t *)block;
+    node->next = (pool_node_t *)slab->free_list;
+    node->marker = free_marker(node);
+    slab->free_list = node;
+    slab->stats.in_use--;
+}
+
+static uintptr_t free_marker(const void *block)
+{
+    return (uintptr_t)block ^ POOL_FREE_MARKER;
+}
+
+// Cheap double free check: only a free (or cached) block carries its marker
+static bool is_free(const void *block)
+{
+    return ((const pool_node_t *)block)->marker == free_marker(block);
+}
+
+static void lock(shape_pool_t *self)
+{
+    if (self->lock != NULL) {
+        self->lock(self->lock_context);
+    }
+}
+
+static void unlock(shape_pool_t *self)
+{
+    if (self->unlock != NULL) {
+        self->unlock(self->lock_context);
+    }
+}
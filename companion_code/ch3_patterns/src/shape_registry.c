@@ -1,117 +1,942 @@
 #include "shape_registry.h"
+#include "shape_hash.h"
+#include "common.h"
 #include <string.h>
 
+// Shapes per batch call: keeps the stack buffers small for any capacity
+#define SCAN_BLOCK 64u
+
+static bool carve_tree(shape_registry_tree_t *tree, uint8_t **cursor, size_t *remaining, size_t n);
+typedef struct {
+    float max_area;
+    uint32_t max_perimeter;
+    api_shape_t *biggest_area;
+    api_shape_t *biggest_perimeter;
+} scan_result_t;
+
+typedef struct {
+    api_shape_t **api_shapes;
+    uint32_t count;
+    uint32_t chunk;             // Shapes per job (the last one may be short)
+    scan_result_t partial[SHAPE_REGISTRY_MAX_WORKERS];
+} scan_jobs_t;
+
+static void update_biggest(shape_registry_t *self);
+static void scan_range(api_shape_t **shapes, uint32_t n, scan_result_t *result);
+static void scan_job(void *job_context, uint32_t job);
+static bool shapes_changed(const shape_registry_t *self);
+static void snapshot_generations(shape_registry_t *self);
+static void append(shape_registry_t *self, api_shape_t *shape, shape_registry_token_t *token);
+static void remove_at(shape_registry_t *self, uint32_t index);
+static bool token_is_live(const shape_registry_t *self, shape_registry_token_t token);
+static void index_shape(shape_registry_t *self, uint32_t token, bool is_new);
+static void index_publish(shape_registry_t *self);
+static bool ranks_above(const shape_registry_t *self, bool by_area, uint32_t a, uint32_t b);
+static double key_of(const shape_registry_t *self, bool by_area, uint32_t token);
+static const shape_registry_tree_t *tree_of(const shape_registry_t *self, bool by_area);
+static uint32_t tree_size(const shape_registry_tree_t *tree, uint32_t node);
+static uint32_t tree_priority(uint32_t token);
+static void tree_rotate_up(shape_registry_tree_t *tree, uint32_t node);
+static void tree_insert(shape_registry_t *self, bool by_area, uint32_t token);
+static void tree_remove(shape_registry_t *self, bool by_area, uint32_t token);
+static uint32_t tree_last(const shape_registry_tree_t *tree);
+static uint32_t tree_next(const shape_registry_tree_t *tree, uint32_t node);
+static uint32_t tree_previous(const shape_registry_tree_t *tree, uint32_t node);
+static uint32_t tree_count_below(const shape_registry_t *self, bool by_area, double key, bool inclusive);
+static uint32_t mix32(uint32_t h);
+static uint32_t hash_key(const void *key);
+static bool key_matches(const void *context, uint32_t token, const void *key);
+static uint32_t key_hash(const void *context, uint32_t token);
+static uint32_t find_bucket(const shape_registry_t *self, const void *key);
+static void track_shape(shape_registry_t *self, uint32_t token);
+static void untrack_shape(shape_registry_t *self, uint32_t token);
+static bool dirty_needs_rescan(shape_registry_t *self);
+static void process_dirty(shape_registry_t *self);
+
 // region: registry_impl
-static void update_biggest_area(void);
-static void update_biggest_perimeter(void);
+static void sync_public_view(void);
 
 typedef struct {
-    uint32_t is_new_shape;
-    float cached_max_area;
-    uint32_t cached_max_perimeter;
-    uint8_t cache_valid;
+    shape_registry_t instance;          // Default instance behind the singleton API
+    uint32_t generations[MAX_SHAPES];
+    uint32_t token_of[MAX_SHAPES];
+    uint32_t slot_of[MAX_SHAPES];
 }_shape_registry_data_t; // private state
 
 static shape_registry_data_t g_registry_data = {0};
-static _shape_registry_data_t priv_registry_data = {0};
+
+// The default instance keeps its shapes directly in the public view
+#define DEFAULT_INSTANCE                                    \
+    { .capacity = MAX_SHAPES,                               \
+      .api_shapes = g_registry_data.api_shapes,             \
+      .generations = priv_registry_data.generations,         \
+      .token_of = priv_registry_data.token_of,               \
+      .slot_of = priv_registry_data.slot_of }
+
+static _shape_registry_data_t priv_registry_data = { .instance = DEFAULT_INSTANCE };
 
 const shape_registry_data_t * shapeRegistry_Init()
 {
-    memset(&g_registry_data, 0, sizeof(shape_registry_data_t));   
+    memset(&g_registry_data, 0, sizeof(shape_registry_data_t));
     memset(&priv_registry_data, 0, sizeof(_shape_registry_data_t));
-    priv_registry_data.cache_valid = 0;
+    priv_registry_data.instance = (shape_registry_t)DEFAULT_INSTANCE;
     return &g_registry_data;
 }
 
 void shapeRegistry_Tasks()
 {
-    // Only update if new shapes have been registered/unregistered
-    if (priv_registry_data.is_new_shape) {
-        update_biggest_area();
-        update_biggest_perimeter();
-        priv_registry_data.is_new_shape = 0;
-    }
+    shapeRegistry_InstanceTasks(&priv_registry_data.instance);
+    sync_public_view();
 }
 
 bool shapeRegistry_Register(api_shape_t * api_shape)
 {
-    if (g_registry_data.count >= MAX_SHAPES) {
+    bool registered = shapeRegistry_InstanceRegister(&priv_registry_data.instance, api_shape, NULL);
+    sync_public_view();
+    return registered;
+}
+
+bool shapeRegistry_Unregister(api_shape_t * api_shape)
+{
+    bool unregistered = shapeRegistry_InstanceUnregister(&priv_registry_data.instance, api_shape);
+    sync_public_view();
+    return unregistered;
+}
+
+static void sync_public_view(void)
+{
+    g_registry_data.count = priv_registry_data.instance.count;
+    g_registry_data.biggestArea = priv_registry_data.instance.biggestArea;
+    g_registry_data.biggestPerimeter = priv_registry_data.instance.biggestPerimeter;
+}
+// endregion
+
+bool shapeRegistry_RegisterStatic(api_shape_t * const *shapes, uint32_t count)
+{
+    bool registered = shapeRegistry_InstanceRegisterStatic(&priv_registry_data.instance, shapes, count);
+    sync_public_view();
+    return registered;
+}
+
+const shape_registry_t *shapeRegistry_GetInstance(void)
+{
+    return &priv_registry_data.instance;
+}
+
+/* Instance registries */
+
+bool shapeRegistry_InstanceInit(shape_registry_t *self, const shape_registry_config_t *config)
+{
+    if (self == NULL || config == NULL || config->memory == NULL) {
         return false;
     }
 
-    g_registry_data.api_shapes[g_registry_data.count] = api_shape;
-    g_registry_data.count++;
-    priv_registry_data.is_new_shape = 1;
-    priv_registry_data.cache_valid = 0;
+    memset(self, 0, sizeof(shape_registry_t));
+
+    uint8_t *cursor = (uint8_t *)config->memory;
+    size_t remaining = config->memory_size;
+    size_t n = config->capacity;
+
+    self->api_shapes = common_carve(&cursor, &remaining, n * sizeof(api_shape_t *), sizeof(void *));
+    self->generations = common_carve(&cursor, &remaining, n * sizeof(uint32_t), sizeof(uint32_t));
+    self->token_of = common_carve(&cursor, &remaining, n * sizeof(uint32_t), sizeof(uint32_t));
+    self->slot_of = common_carve(&cursor, &remaining, n * sizeof(uint32_t), sizeof(uint32_t));
+    if (self->api_shapes == NULL || self->generations == NULL || self->token_of == NULL || self->slot_of == NULL) {
+        memset(self, 0, sizeof(shape_registry_t));
+        return false; // Error: memory block is too small for the requested capacity
+    }
+
+    if (config->indexed) {
+        self->area_of = common_carve(&cursor, &remaining, n * sizeof(float), sizeof(float));
+        self->perimeter_of = common_carve(&cursor, &remaining, n * sizeof(uint32_t), sizeof(uint32_t));
+        if (self->area_of == NULL || self->perimeter_of == NULL ||
+            !carve_tree(&self->area_tree, &cursor, &remaining, n) ||
+            !carve_tree(&self->perimeter_tree, &cursor, &remaining, n)) {
+            memset(self, 0, sizeof(shape_registry_t));
+            return false; // Error: no room for the trees
+        }
+        self->indexed = true;
+    }
+
+    if (config->track_changes) {
+        uint32_t bucket_count = 2u;
+        while (bucket_count < 2u * config->capacity) {
+            bucket_count <<= 1; // Load factor <= 0.5 keeps probes short
+        }
+        self->key_of = common_carve(&cursor, &remaining, n * sizeof(void *), sizeof(void *));
+        self->buckets = common_carve(&cursor, &remaining, bucket_count * sizeof(uint32_t), sizeof(uint32_t));
+        self->next_same_key = common_carve(&cursor, &remaining, n * sizeof(uint32_t), sizeof(uint32_t));
+        self->prev_same_key = common_carve(&cursor, &remaining, n * sizeof(uint32_t), sizeof(uint32_t));
+        self->dirty = common_carve(&cursor, &remaining, n * sizeof(uint32_t), sizeof(uint32_t));
+        self->is_dirty = common_carve(&cursor, &remaining, n, 1);
+        if (self->key_of == NULL || self->buckets == NULL || self->next_same_key == NULL ||
+            self->prev_same_key == NULL || self->dirty == NULL || self->is_dirty == NULL) {
+            memset(self, 0, sizeof(shape_registry_t));
+            return false; // Error: no room for the dirty set
+        }
+        memset(self->buckets, 0, bucket_count * sizeof(uint32_t));
+        memset(self->is_dirty, 0, n);
+        self->bucket_mask = bucket_count - 1u;
+        self->track_changes = true;
+    }
+
+    self->capacity = config->capacity;
+    self->unordered = config->unordered;
+    self->executor = config->executor;
+    self->workers = (config->workers < SHAPE_REGISTRY_MAX_WORKERS) ? config->workers : SHAPE_REGISTRY_MAX_WORKERS;
     return true;
 }
 
-bool shapeRegistry_Unregister(api_shape_t * api_shape)
+void shapeRegistry_InstanceTasks(shape_registry_t *self)
 {
-    if (g_registry_data.count == 0) {
+    // The trees are kept current by every call: nothing to scan
+    if (self->indexed) {
+        process_dirty(self);
+        self->changed = false;
+        return;
+    }
+
+    // Queued shapes stand in for the generation poll
+    if (self->track_changes) {
+        if (dirty_needs_rescan(self) || self->changed) {
+            update_biggest(self);
+        }
+        process_dirty(self);
+        self->changed = false;
+        return;
+    }
+
+    // Only update if shapes have been registered/unregistered or modified
+    if (self->changed || shapes_changed(self)) {
+        update_biggest(self);
+        snapshot_generations(self);
+        self->changed = false;
+    }
+}
+
+bool shapeRegistry_InstanceRegister(shape_registry_t *self, api_shape_t *shape, shape_registry_token_t *token)
+{
+    if (self->count >= self->capacity) {
         return false;
     }
 
-    for (uint32_t i = 0; i < g_registry_data.count; i++) {
-        if (g_registry_data.api_shapes[i] == api_shape) {
-            for (uint32_t j = i; j < g_registry_data.count - 1; j++) {
-                g_registry_data.api_shapes[j] = g_registry_data.api_shapes[j + 1];
-            }
-            g_registry_data.count--;
-            priv_registry_data.is_new_shape = 1;
-            priv_registry_data.cache_valid = 0;
+    append(self, shape, token);
+    self->changed = true;
+    return true;
+}
+
+bool shapeRegistry_InstanceUnregister(shape_registry_t *self, api_shape_t *shape)
+{
+    for (uint32_t i = 0; i < self->count; i++) {
+        if (self->api_shapes[i] == shape) {
+            remove_at(self, i);
             return true;
         }
     }
 
     return false;
 }
-// endregion
 
-/* Static helper functions for updating statistics */
+bool shapeRegistry_InstanceUnregisterToken(shape_registry_t *self, shape_registry_token_t token)
+{
+    if (!token_is_live(self, token)) {
+        return false;
+    }
+
+    remove_at(self, self->slot_of[token]);
+    return true;
+}
+
+bool shapeRegistry_InstanceUpdate(shape_registry_t *self, shape_registry_token_t token)
+{
+    if (!token_is_live(self, token)) {
+        return false;
+    }
+
+    if (self->indexed) {
+        index_shape(self, token, false);
+        index_publish(self);
+    } else {
+        self->changed = true;
+    }
+    return true;
+}
 
-static void update_biggest_area(void)
+bool shapeRegistry_InstanceRegisterStatic(shape_registry_t *self, api_shape_t * const *shapes, uint32_t count)
 {
-    if (g_registry_data.count == 0) {
-        g_registry_data.biggestArea = NULL;
-        priv_registry_data.cached_max_area = 0.0f;
+    if (shapes == NULL || count > self->capacity - self->count) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        append(self, shapes[i], NULL);
+    }
+    self->changed = true;
+    return true;
+}
+
+void shapeRegistry_Merge(const shape_registry_t * const *shards, uint32_t count, shape_registry_stats_t *stats)
+{
+    memset(stats, 0, sizeof(shape_registry_stats_t));
+
+    for (uint32_t i = 0; i < count; i++) {
+        const shape_registry_t *shard = shards[i];
+
+        stats->count += shard->count;
+        if (shard->biggestArea != NULL && shard->max_area > stats->max_area) {
+            stats->max_area = shard->max_area;
+            stats->biggestArea = shard->biggestArea;
+        }
+        if (shard->biggestPerimeter != NULL && shard->max_perimeter > stats->max_perimeter) {
+            stats->max_perimeter = shard->max_perimeter;
+            stats->biggestPerimeter = shard->biggestPerimeter;
+        }
+    }
+}
+
+void shapeRegistry_ChangeHook(void *context, const void *key)
+{
+    shape_registry_t *self = context;
+
+    if (self == NULL || !self->track_changes || key == NULL) {
+        return;
+    }
+
+    uint32_t bucket = find_bucket(self, key);
+    if (self->buckets[bucket] == 0) {
         return;
     }
-    
-    float max_area = 0.0f;
-    api_shape_t *shape_with_max_area = NULL;
-    
-    for (uint32_t i = 0; i < g_registry_data.count; i++) {
-        float area = shape_get_area(g_registry_data.api_shapes[i]);
-        if (area > max_area) {
-            max_area = area;
-            shape_with_max_area = g_registry_data.api_shapes[i];
+
+    // Every shape with this key: a whole store batch is one notify
+    for (uint32_t token = self->buckets[bucket] - 1u; token != SHAPE_REGISTRY_INVALID_TOKEN;
+         token = self->next_same_key[token]) {
+        if (!self->is_dirty[token]) {
+            self->is_dirty[token] = 1;
+            self->dirty[self->dirty_count++] = token;
         }
     }
-    
-    g_registry_data.biggestArea = shape_with_max_area;
-    priv_registry_data.cached_max_area = max_area;
 }
 
-static void update_biggest_perimeter(void)
+/* Ordered queries */
+
+uint32_t shapeRegistry_TopK(const shape_registry_t *self, shape_registry_key_t key, uint32_t k, api_shape_t **shapes)
+{
+    if (!self->indexed) {
+        return 0;
+    }
+
+    const shape_registry_tree_t *tree = tree_of(self, key == SHAPE_REGISTRY_KEY_AREA);
+    uint32_t node = tree_last(tree);
+    uint32_t found = 0;
+
+    while (found < k && node != SHAPE_REGISTRY_INVALID_TOKEN) {
+        shapes[found++] = self->api_shapes[self->slot_of[node]];
+        node = tree_previous(tree, node);
+    }
+    return found;
+}
+
+uint32_t shapeRegistry_CountInRange(const shape_registry_t *self, shape_registry_key_t key, double lo, double hi)
+{
+    bool by_area = (key == SHAPE_REGISTRY_KEY_AREA);
+
+    if (!self->indexed || lo > hi) {
+        return 0;
+    }
+    return tree_count_below(self, by_area, hi, true) - tree_count_below(self, by_area, lo, false);
+}
+
+void shapeRegistry_RangeBegin(shape_registry_range_t *range, const shape_registry_t *self, shape_registry_key_t key,
+                              double lo, double hi)
 {
-    if (g_registry_data.count == 0) {
-        g_registry_data.biggestPerimeter = NULL;
-        priv_registry_data.cached_max_perimeter = 0;
+    bool by_area = (key == SHAPE_REGISTRY_KEY_AREA);
+
+    range->registry = self;
+    range->key = key;
+    range->hi = hi;
+    range->node = SHAPE_REGISTRY_INVALID_TOKEN;
+    if (!self->indexed) {
         return;
     }
-    
-    uint32_t max_perimeter = 0;
-    api_shape_t *shape_with_max_perimeter = NULL;
-    
-    for (uint32_t i = 0; i < g_registry_data.count; i++) {
-        uint32_t perimeter = shape_get_perimeter(g_registry_data.api_shapes[i]);
-        if (perimeter > max_perimeter) {
-            max_perimeter = perimeter;
-            shape_with_max_perimeter = g_registry_data.api_shapes[i];
+
+    // Lower bound: the first node with a key >= lo
+    const shape_registry_tree_t *tree = tree_of(self, by_area);
+    uint32_t node = tree->root;
+    while (node != SHAPE_REGISTRY_INVALID_TOKEN) {
+        if (key_of(self, by_area, node) >= lo) {
+            range->node = node;
+            node = tree->left[node];
+        } else {
+            node = tree->right[node];
+        }
+    }
+}
+
+api_shape_t *shapeRegistry_RangeNext(shape_registry_range_t *range)
+{
+    const shape_registry_t *self = range->registry;
+    bool by_area = (range->key == SHAPE_REGISTRY_KEY_AREA);
+    uint32_t node = range->node;
+
+    if (node == SHAPE_REGISTRY_INVALID_TOKEN || key_of(self, by_area, node) > range->hi) {
+        return NULL;
+    }
+    range->node = tree_next(tree_of(self, by_area), node);
+    return self->api_shapes[self->slot_of[node]];
+}
+
+/* Static helper functions */
+
+static void append(shape_registry_t *self, api_shape_t *shape, shape_registry_token_t *token)
+{
+    uint32_t id;
+
+    if (self->free_token != 0) {
+        id = self->free_token - 1u;
+        self->free_token = self->slot_of[id];
+    } else {
+        id = self->fresh_token++;
+    }
+
+    self->api_shapes[self->count] = shape;
+    self->generations[self->count] = 0;
+    self->token_of[self->count] = id;
+    self->slot_of[id] = self->count;
+    self->count++;
+
+    if (self->indexed) {
+        index_shape(self, id, true);
+        index_publish(self);
+    }
+    if (self->track_changes) {
+        track_shape(self, id);
+    }
+
+    if (token != NULL) {
+        *token = id;
+    }
+}
+
+static void remove_at(shape_registry_t *self, uint32_t index)
+{
+    uint32_t id = self->token_of[index];
+    uint32_t last = self->count - 1u;
+
+    // Leave the trees while the ordered tie-break (slot_of) is still valid
+    if (self->indexed) {
+        tree_remove(self, true, id);
+        tree_remove(self, false, id);
+    }
+    if (self->track_changes) {
+        untrack_shape(self, id);
+    }
+
+    if (self->unordered) {
+        // Fill the hole with the last shape
+        self->api_shapes[index] = self->api_shapes[last];
+        self->generations[index] = self->generations[last];
+        self->token_of[index] = self->token_of[last];
+        self->slot_of[self->token_of[index]] = index;
+    } else {
+        for (uint32_t j = index; j < last; j++) {
+            self->api_shapes[j] = self->api_shapes[j + 1];
+            self->generations[j] = self->generations[j + 1];
+            self->token_of[j] = self->token_of[j + 1];
+            self->slot_of[self->token_of[j]] = j;
+        }
+    }
+    self->count--;
+
+    self->slot_of[id] = self->free_token;
+    self->free_token = id + 1u;
+    self->changed = true;
+
+    if (self->indexed) {
+        index_publish(self);
+    }
+}
+
+// Released tokens never match: no live slot points back to them
+static bool token_is_live(const shape_registry_t *self, shape_registry_token_t token)
+{
+    return token < self->fresh_token && self->slot_of[token] < self->count &&
+           self->token_of[self->slot_of[token]] == token;
+}
+
+/* Static helper functions for the indexed trees */
+
+// Recomputes the keys of one shape and puts it back in both trees
+static void index_shape(shape_registry_t *self, uint32_t token, bool is_new)
+{
+    api_shape_t *shape = self->api_shapes[self->slot_of[token]];
+
+    if (!is_new) {
+        tree_remove(self, true, token);
+        tree_remove(self, false, token);
+    }
+    self->area_of[token] = shape_get_area(shape);
+    self->perimeter_of[token] = shape_get_perimeter(shape);
+    tree_insert(self, true, token);
+    tree_insert(self, false, token);
+}
+
+// Same rule as the scan: only strictly positive values make a biggest shape
+static void index_publish(shape_registry_t *self)
+{
+    uint32_t top = tree_last(&self->area_tree);
+
+    self->biggestArea = NULL;
+    self->max_area = 0.0f;
+    if (top != SHAPE_REGISTRY_INVALID_TOKEN && self->area_of[top] > 0.0f) {
+        self->max_area = self->area_of[top];
+        self->biggestArea = self->api_shapes[self->slot_of[top]];
+    }
+
+    top = tree_last(&self->perimeter_tree);
+    self->biggestPerimeter = NULL;
+    self->max_perimeter = 0;
+    if (top != SHAPE_REGISTRY_INVALID_TOKEN && self->perimeter_of[top] > 0) {
+        self->max_perimeter = self->perimeter_of[top];
+        self->biggestPerimeter = self->api_shapes[self->slot_of[top]];
+    }
+}
+
+// Larger value first; ties go to the earlier shape (its position only ever
+// shifts together with the others) or, when unordered, to the lower token
+static bool ranks_above(const shape_registry_t *self, bool by_area, uint32_t a, uint32_t b)
+{
+    if (by_area) {
+        if (self->area_of[a] != self->area_of[b]) {
+            return self->area_of[a] > self->area_of[b];
         }
+    } else if (self->perimeter_of[a] != self->perimeter_of[b]) {
+        return self->perimeter_of[a] > self->perimeter_of[b];
     }
-    
-    g_registry_data.biggestPerimeter = shape_with_max_perimeter;
-    priv_registry_data.cached_max_perimeter = max_perimeter;
+    return self->unordered ? a < b : self->slot_of[a] < self->slot_of[b];
+}
+
+static double key_of(const shape_registry_t *self, bool by_area, uint32_t token)
+{
+    return by_area ? (double)self->area_of[token] : (double)self->perimeter_of[token];
+}
+
+static const shape_registry_tree_t *tree_of(const shape_registry_t *self, bool by_area)
+{
+    return by_area ? &self->area_tree : &self->perimeter_tree;
+}
+
+static uint32_t tree_size(const shape_registry_tree_t *tree, uint32_t node)
+{
+    return (node == SHAPE_REGISTRY_INVALID_TOKEN) ? 0 : tree->size[node];
+}
+
+// Fixed pseudo random priority per token: no storage, same shape of tree for the same history
+static uint32_t tree_priority(uint32_t token)
+{
+    return mix32(token + 1u);
+}
+
+// Swaps node with its parent, keeping the in-order sequence
+static void tree_rotate_up(shape_registry_tree_t *tree, uint32_t node)
+{
+    uint32_t parent = tree->parent[node];
+    uint32_t grandparent = tree->parent[parent];
+
+    if (tree->left[parent] == node) {
+        tree->left[parent] = tree->right[node];
+        if (tree->right[node] != SHAPE_REGISTRY_INVALID_TOKEN) {
+            tree->parent[tree->right[node]] = parent;
+        }
+        tree->right[node] = parent;
+    } else {
+        tree->right[parent] = tree->left[node];
+        if (tree->left[node] != SHAPE_REGISTRY_INVALID_TOKEN) {
+            tree->parent[tree->left[node]] = parent;
+        }
+        tree->left[node] = parent;
+    }
+    tree->parent[parent] = node;
+    tree->parent[node] = grandparent;
+
+    if (grandparent == SHAPE_REGISTRY_INVALID_TOKEN) {
+        tree->root = node;
+    } else if (tree->left[grandparent] == parent) {
+        tree->left[grandparent] = node;
+    } else {
+        tree->right[grandparent] = node;
+    }
+
+    tree->size[parent] = 1u + tree_size(tree, tree->left[parent]) + tree_size(tree, tree->right[parent]);
+    tree->size[node] = 1u + tree_size(tree, tree->left[node]) + tree_size(tree, tree->right[node]);
+}
+
+// Leaf insert by key, then rotate up while the priority is higher than the parent's
+static void tree_insert(shape_registry_t *self, bool by_area, uint32_t token)
+{
+    shape_registry_tree_t *tree = by_area ? &self->area_tree : &self->perimeter_tree;
+    uint32_t parent = SHAPE_REGISTRY_INVALID_TOKEN;
+    uint32_t node = tree->root;
+
+    tree->left[token] = SHAPE_REGISTRY_INVALID_TOKEN;
+    tree->right[token] = SHAPE_REGISTRY_INVALID_TOKEN;
+    tree->size[token] = 1;
+
+    // Ascending order: shapes that rank above go right
+    while (node != SHAPE_REGISTRY_INVALID_TOKEN) {
+        tree->size[node]++;
+        parent = node;
+        node = ranks_above(self, by_area, token, node) ? tree->right[node] : tree->left[node];
+    }
+
+    tree->parent[token] = parent;
+    if (parent == SHAPE_REGISTRY_INVALID_TOKEN) {
+        tree->root = token;
+    } else if (ranks_above(self, by_area, token, parent)) {
+        tree->right[parent] = token;
+    } else {
+        tree->left[parent] = token;
+    }
+
+    while (tree->parent[token] != SHAPE_REGISTRY_INVALID_TOKEN &&
+           tree_priority(token) > tree_priority(tree->parent[token])) {
+        tree_rotate_up(tree, token);
+    }
+}
+
+// Rotates the node down to a leaf, then cuts it off: no key comparisons
+static void tree_remove(shape_registry_t *self, bool by_area, uint32_t token)
+{
+    shape_registry_tree_t *tree = by_area ? &self->area_tree : &self->perimeter_tree;
+
+    for (;;) {
+        uint32_t left = tree->left[token];
+        uint32_t right = tree->right[token];
+
+        if (left == SHAPE_REGISTRY_INVALID_TOKEN && right == SHAPE_REGISTRY_INVALID_TOKEN) {
+            break;
+        }
+        if (right == SHAPE_REGISTRY_INVALID_TOKEN ||
+            (left != SHAPE_REGISTRY_INVALID_TOKEN && tree_priority(left) > tree_priority(right))) {
+            tree_rotate_up(tree, left);
+        } else {
+            tree_rotate_up(tree, right);
+        }
+    }
+
+    uint32_t parent = tree->parent[token];
+    if (parent == SHAPE_REGISTRY_INVALID_TOKEN) {
+        tree->root = SHAPE_REGISTRY_INVALID_TOKEN;
+        return;
+    }
+    if (tree->left[parent] == token) {
+        tree->left[parent] = SHAPE_REGISTRY_INVALID_TOKEN;
+    } else {
+        tree->right[parent] = SHAPE_REGISTRY_INVALID_TOKEN;
+    }
+    for (; parent != SHAPE_REGISTRY_INVALID_TOKEN; parent = tree->parent[parent]) {
+        tree->size[parent]--;
+    }
+}
+
+// The shape that ranks highest
+static uint32_t tree_last(const shape_registry_tree_t *tree)
+{
+    uint32_t node = tree->root;
+
+    if (node == SHAPE_REGISTRY_INVALID_TOKEN) {
+        return node;
+    }
+    while (tree->right[node] != SHAPE_REGISTRY_INVALID_TOKEN) {
+        node = tree->right[node];
+    }
+    return node;
+}
+
+static uint32_t tree_next(const shape_registry_tree_t *tree, uint32_t node)
+{
+    if (tree->right[node] != SHAPE_REGISTRY_INVALID_TOKEN) {
+        node = tree->right[node];
+        while (tree->left[node] != SHAPE_REGISTRY_INVALID_TOKEN) {
+            node = tree->left[node];
+        }
+        return node;
+    }
+
+    uint32_t parent = tree->parent[node];
+    while (parent != SHAPE_REGISTRY_INVALID_TOKEN && tree->right[parent] == node) {
+        node = parent;
+        parent = tree->parent[node];
+    }
+    return parent;
+}
+
+static uint32_t tree_previous(const shape_registry_tree_t *tree, uint32_t node)
+{
+    if (tree->left[node] != SHAPE_REGISTRY_INVALID_TOKEN) {
+        node = tree->left[node];
+        while (tree->right[node] != SHAPE_REGISTRY_INVALID_TOKEN) {
+            node = tree->right[node];
+        }
+        return node;
+    }
+
+    uint32_t parent = tree->parent[node];
+    while (parent != SHAPE_REGISTRY_INVALID_TOKEN && tree->left[parent] == node) {
+        node = parent;
+        parent = tree->parent[node];
+    }
+    return parent;
+}
+
+// Shapes with a key below (or equal to, if inclusive) the given one
+static uint32_t tree_count_below(const shape_registry_t *self, bool by_area, double key, bool inclusive)
+{
+    const shape_registry_tree_t *tree = tree_of(self, by_area);
+    uint32_t node = tree->root;
+    uint32_t count = 0;
+
+    while (node != SHAPE_REGISTRY_INVALID_TOKEN) {
+        double value = key_of(self, by_area, node);
+        if (value < key || (inclusive && value == key)) {
+            count += tree_size(tree, tree->left[node]) + 1u;
+            node = tree->right[node];
+        } else {
+            node = tree->left[node];
+        }
+    }
+    return count;
+}
+
+/* Static helper functions for the dirty set */
+
+static uint32_t mix32(uint32_t h)
+{
+    h ^= h >> 16;
+    h *= 0x7feb352du;
+    h ^= h >> 15;
+    h *= 0x846ca68bu;
+    h ^= h >> 16;
+    return h;
+}
+
+static uint32_t hash_key(const void *key)
+{
+    uint64_t address = (uint64_t)(uintptr_t)key;
+    return mix32((uint32_t)(address >> 2) ^ (uint32_t)(address >> 34));
+}
+
+static bool key_matches(const void *context, uint32_t token, const void *key)
+{
+    return ((const shape_registry_t *)context)->key_of[token] == key;
+}
+
+static uint32_t key_hash(const void *context, uint32_t token)
+{
+    return hash_key(((const shape_registry_t *)context)->key_of[token]);
+}
+
+// Bucket holding the key, or the empty bucket where it would go
+static uint32_t find_bucket(const shape_registry_t *self, const void *key)
+{
+    return shapeHash_find(self->buckets, self->bucket_mask, hash_key(key), key_matches, self, key);
+}
+
+// Shapes without a key stay untracked; a shared key chains its tokens
+static void track_shape(shape_registry_t *self, uint32_t token)
+{
+    const void *key = shape_get_change_key(self->api_shapes[self->slot_of[token]]);
+
+    self->key_of[token] = key;
+    if (key == NULL) {
+        return;
+    }
+
+    // The new token becomes the head of its key's chain
+    uint32_t bucket = find_bucket(self, key);
+    uint32_t head = (self->buckets[bucket] != 0) ? self->buckets[bucket] - 1u : SHAPE_REGISTRY_INVALID_TOKEN;
+    self->next_same_key[token] = head;
+    self->prev_same_key[token] = SHAPE_REGISTRY_INVALID_TOKEN;
+    if (head != SHAPE_REGISTRY_INVALID_TOKEN) {
+        self->prev_same_key[head] = token;
+    }
+    self->buckets[bucket] = token + 1u;
+}
+
+// O(1) unlink from the chain; the last token of a key empties its bucket
+// (see shape_hash.h). A queued token stays queued: Tasks skips it if it
+// is dead, and reuse keeps it queued only once.
+static void untrack_shape(shape_registry_t *self, uint32_t token)
+{
+    const void *key = self->key_of[token];
+
+    if (key == NULL) {
+        return;
+    }
+
+    uint32_t next = self->next_same_key[token];
+    uint32_t prev = self->prev_same_key[token];
+    if (next != SHAPE_REGISTRY_INVALID_TOKEN) {
+        self->prev_same_key[next] = prev;
+    }
+    if (prev != SHAPE_REGISTRY_INVALID_TOKEN) {
+        self->next_same_key[prev] = next;
+    } else if (next != SHAPE_REGISTRY_INVALID_TOKEN) {
+        self->buckets[find_bucket(self, key)] = next + 1u; // Same key: the bucket does not move
+    } else {
+        shapeHash_remove(self->buckets, self->bucket_mask, find_bucket(self, key), key_hash, self);
+    }
+    self->key_of[token] = NULL;
+}
+
+// Scan mode: only a queued shape that was the biggest, or now reaches the
+// maximum, can change biggest*; anything else leaves the last result valid
+static bool dirty_needs_rescan(shape_registry_t *self)
+{
+    for (uint32_t i = 0; i < self->dirty_count; i++) {
+        uint32_t token = self->dirty[i];
+        if (!token_is_live(self, token)) {
+            continue;
+        }
+
+        api_shape_t *shape = self->api_shapes[self->slot_of[token]];
+        float area = shape_get_area(shape);
+        uint32_t perimeter = shape_get_perimeter(shape);
+        if (shape == self->biggestArea || shape == self->biggestPerimeter ||
+            (area > 0.0f && area >= self->max_area) || (perimeter > 0 && perimeter >= self->max_perimeter)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Empties the queue; indexed registries re-key every live queued shape
+static void process_dirty(shape_registry_t *self)
+{
+    bool rekeyed = false;
+
+    for (uint32_t i = 0; i < self->dirty_count; i++) {
+        uint32_t token = self->dirty[i];
+        self->is_dirty[token] = 0;
+        if (self->indexed && token_is_live(self, token)) {
+            index_shape(self, token, false);
+            rekeyed = true;
+        }
+    }
+    self->dirty_count = 0;
+
+    if (rekeyed) {
+        index_publish(self);
+    }
+}
+
+/* Static helper functions for updating statistics */
+
+static bool carve_tree(shape_registry_tree_t *tree, uint8_t **cursor, size_t *remaining, size_t n)
+{
+    tree->root = SHAPE_REGISTRY_INVALID_TOKEN;
+    tree->left = common_carve(cursor, remaining, n * sizeof(uint32_t), sizeof(uint32_t));
+    tree->right = common_carve(cursor, remaining, n * sizeof(uint32_t), sizeof(uint32_t));
+    tree->parent = common_carve(cursor, remaining, n * sizeof(uint32_t), sizeof(uint32_t));
+    tree->size = common_carve(cursor, remaining, n * sizeof(uint32_t), sizeof(uint32_t));
+    return tree->left != NULL && tree->right != NULL && tree->parent != NULL && tree->size != NULL;
+}
+
+// Shapes without generation tracking are always treated as changed
+static bool shapes_changed(const shape_registry_t *self)
+{
+    uint32_t generation;
+
+    for (uint32_t i = 0; i < self->count; i++) {
+        if (!shape_get_generation(self->api_shapes[i], &generation) ||
+            generation != self->generations[i]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void snapshot_generations(shape_registry_t *self)
+{
+    for (uint32_t i = 0; i < self->count; i++) {
+        uint32_t generation = 0;
+        shape_get_generation(self->api_shapes[i], &generation);
+        self->generations[i] = generation;
+    }
+}
+
+// Serial, or split over the executor when the registry is large enough
+static void update_biggest(shape_registry_t *self)
+{
+    scan_result_t result;
+    uint32_t jobs = 1;
+
+    if (self->executor != NULL && self->workers > 1) {
+        uint32_t grain = self->executor->grain ? self->executor->grain : SHAPE_REGISTRY_RESCAN_GRAIN;
+        jobs = self->count / grain;
+        jobs = (jobs < self->workers) ? jobs : self->workers;
+    }
+
+    if (jobs <= 1) {
+        scan_range(self->api_shapes, self->count, &result);
+    } else {
+        scan_jobs_t context = { .api_shapes = self->api_shapes, .count = self->count,
+                                .chunk = (self->count + jobs - 1u) / jobs };
+        jobs = (self->count + context.chunk - 1u) / context.chunk; // No empty trailing job
+        self->executor->run_jobs(self->executor->context, scan_job, &context, jobs);
+
+        // In range order: a later range must be strictly greater to win, as in the serial loop
+        result = context.partial[0];
+        for (uint32_t j = 1; j < jobs; j++) {
+            const scan_result_t *partial = &context.partial[j];
+            if (partial->max_area > result.max_area) {
+                result.max_area = partial->max_area;
+                result.biggest_area = partial->biggest_area;
+            }
+            if (partial->max_perimeter > result.max_perimeter) {
+                result.max_perimeter = partial->max_perimeter;
+                result.biggest_perimeter = partial->biggest_perimeter;
+            }
+        }
+    }
+
+    self->biggestArea = result.biggest_area;
+    self->max_area = result.max_area;
+    self->biggestPerimeter = result.biggest_perimeter;
+    self->max_perimeter = result.max_perimeter;
+}
+
+// Both maxima in one pass: each block is read once for area and perimeter
+static void scan_range(api_shape_t **shapes, uint32_t n, scan_result_t *result)
+{
+    float areas[SCAN_BLOCK];
+    uint32_t perimeters[SCAN_BLOCK];
+
+    memset(result, 0, sizeof(scan_result_t));
+
+    // One batch call per shape type and block instead of one vtable call per shape
+    for (uint32_t base = 0; base < n; base += SCAN_BLOCK) {
+        uint32_t block = (n - base < SCAN_BLOCK) ? n - base : SCAN_BLOCK;
+        shape_get_area_many(&shapes[base], block, areas);
+        shape_get_perimeter_many(&shapes[base], block, perimeters);
+
+        for (uint32_t i = 0; i < block; i++) {
+            if (areas[i] > result->max_area) {
+                result->max_area = areas[i];
+                result->biggest_area = shapes[base + i];
+            }
+            if (perimeters[i] > result->max_perimeter) {
+                result->max_perimeter = perimeters[i];
+                result->biggest_perimeter = shapes[base + i];
+            }
+        }
+    }
+}
+
+static void scan_job(void *job_context, uint32_t job)
+{
+    scan_jobs_t *context = job_context;
+    uint32_t first = job * context->chunk;
+    uint32_t n = (context->count - first < context->chunk) ? context->count - first : context->chunk;
+
+    scan_range(&context->api_shapes[first], n, &context->partial[job]);
 }
@@ -0,0 +1,97 @@
+#include "shape_registry_view.h"
+#include "common.h"
+#include <string.h>
+
+#if !defined(__GNUC__)
+#error "shape_registry_view requires the GCC/Clang __atomic builtins"
+#endif
+
+
+bool shapeRegistryView_init(shape_registry_views_t *self, const shape_registry_views_config_t *config)
+{
+    if (self == NULL || config == NULL || config->memory == NULL || config->buffer_count < 2) {
+        return false;
+    }
+
+    memset(self, 0, sizeof(shape_registry_views_t));
+
+    uint8_t *cursor = (uint8_t *)config->memory;
+    size_t remaining = config->memory_size;
+    size_t n = config->buffer_count;
+
+    self->buffers = common_carve(&cursor, &remaining, n * sizeof(shape_registry_view_t), sizeof(void *));
+    self->readers = common_carve(&cursor, &remaining, n * sizeof(uint32_t), sizeof(uint32_t));
+    api_shape_t **lists = common_carve(&cursor, &remaining, n * config->capacity * sizeof(api_shape_t *), sizeof(void *));
+    if (self->buffers == NULL || self->readers == NULL || lists == NULL) {
+        memset(self, 0, sizeof(shape_registry_views_t));
+        return false; // Error: memory block is too small
+    }
+
+    memset(self->buffers, 0, n * sizeof(shape_registry_view_t));
+    memset(self->readers, 0, n * sizeof(uint32_t));
+    for (uint32_t i = 0; i < n; i++) {
+        self->buffers[i].api_shapes = &lists[i * config->capacity];
+    }
+    self->buffer_count = config->buffer_count;
+    self->capacity = config->capacity;
+    return true;
+}
+
+bool shapeRegistryView_publish(shape_registry_views_t *self, const shape_registry_t *registry)
+{
+    uint32_t current = __atomic_load_n(&self->current, __ATOMIC_RELAXED); // Only this thread stores it
+    uint32_t target = self->buffer_count;
+
+    if (registry->count > self->capacity) {
+        return false;
+    }
+
+    // Any unpinned buffer except the published one. A reader that pins it
+    // after this check sees a newer current on its recheck and backs off.
+    for (uint32_t i = 0; i < self->buffer_count; i++) {
+        if (i != current && __atomic_load_n(&self->readers[i], __ATOMIC_SEQ_CST) == 0) {
+            target = i;
+            break;
+        }
+    }
+    if (target == self->buffer_count) {
+        return false;
+    }
+
+    shape_registry_view_t *view = &self->buffers[target];
+    view->version = ++self->version;
+    view->count = registry->count;
+    view->biggestArea = registry->biggestArea;
+    view->biggestPerimeter = registry->biggestPerimeter;
+    view->max_area = registry->max_area;
+    view->max_perimeter = registry->max_perimeter;
+    memcpy(view->api_shapes, registry->api_shapes, registry->count * sizeof(api_shape_t *));
+
+    // The copy is complete before any reader can load the new index
+    __atomic_store_n(&self->current, target, __ATOMIC_SEQ_CST);
+    return true;
+}
+
+const shape_registry_view_t *shapeRegistryView_acquire(shape_registry_views_t *self)
+{
+    for (;;) {
+        uint32_t current = __atomic_load_n(&self->current, __ATOMIC_SEQ_CST);
+        __atomic_fetch_add(&self->readers[current], 1u, __ATOMIC_SEQ_CST);
+
+        // Still published after the pin: the writer cannot pick it any more
+        if (__atomic_load_n(&self->current, __ATOMIC_SEQ_CST) == current) {
+            return &self->buffers[current];
+        }
+        __atomic_fetch_sub(&self->readers[current], 1u, __ATOMIC_SEQ_CST);
+    }
+}
+
+void shapeRegistryView_release(shape_registry_views_t *self, const shape_registry_view_t *view)
+{
+    uint32_t index = (uint32_t)(view - self->buffers);
+
+    __atomic_fetch_sub(&self->readers[index], 1u, __ATOMIC_RELEASE);
+}
+
+/* Static helper functions */
+
@@ -0,0 +1,418 @@
+#include "shape_script.h"
+#include "factory_shape.h"
+#include "canvas.h"
+#include "shape_registry.h"
+#include <string.h>
+
+#define MAX_SLOTS 256u // 8-bit slot operand
+
+// Command sizes in bytes, opcode included
+static const uint8_t g_op_size[SHAPE_OP_COUNT] = {
+    [SHAPE_OP_END] = 1,
+    [SHAPE_OP_RECTANGLE] = 15,
+    [SHAPE_OP_CIRCLE] = 11,
+    [SHAPE_OP_TRIANGLE] = 15,
+    [SHAPE_OP_RESIZE] = 10,
+    [SHAPE_OP_SET_COLOR] = 6,
+    [SHAPE_OP_SET_VISIBLE] = 3,
+    [SHAPE_OP_CANVAS_ADD] = 6,
+    [SHAPE_OP_CANVAS_MOVE] = 6,
+    [SHAPE_OP_CANVAS_REMOVE] = 2,
+    [SHAPE_OP_CANVAS_TASK] = 3,
+    [SHAPE_OP_REGISTER] = 2,
+};
+
+static uint16_t read_u16(const uint8_t *p);
+static uint32_t read_u32(const uint8_t *p);
+static api_shape_t *slot_shape(shape_script_t *self, const uint8_t *arg);
+static bool create_shape(shape_script_t *self, const uint8_t *arg, shape_type_t type);
+static bool resize_shape(api_shape_t *shape, uint32_t dim_a, uint32_t dim_b);
+static bool emit(shape_script_writer_t *writer, const uint8_t *command, size_t size);
+static uint8_t *put_u16(uint8_t *p, uint16_t value);
+static uint8_t *put_u32(uint8_t *p, uint32_t value);
+
+// --- Public API ---
+
+bool shapeScript_init(shape_script_t *self, const shape_script_config_t *config)
+{
+    if (self == NULL || config == NULL || config->slots == NULL || config->slot_count > MAX_SLOTS) {
+        return false;
+    }
+
+    memset(self, 0, sizeof(shape_script_t));
+    memset(config->slots, 0, config->slot_count * sizeof(api_shape_storage_t));
+    self->slots = config->slots;
+    self->slot_count = config->slot_count;
+    return true;
+}
+
+/*
+ * Every handler ends with NEXT(). With computed goto, NEXT() fetches the
+ * following command and jumps straight to its handler (one indirect branch
+ * per handler instead of a shared switch jump). scriptBench measures both
+ * dispatches within noise of each other.
+ */
+#if SHAPE_SCRIPT_COMPUTED_GOTO
+#define OP(name)  L_##name:
+#define NEXT()    do { FETCH(); goto *labels[op]; } while (0)
+#else
+#define OP(name)  case name:
+#define NEXT()    continue
+#endif
+
+// Bounds and opcode are checked once per command: handlers read arg[] freely
+#define FETCH()                                                                     \
+    do {                                                                            \
+        if (pc >= end) {                                                            \
+            return true;                                                            \
+        }                                                                           \
+        cmd = pc;                                                                   \
+        op = *pc;                                                                   \
+        if (op >= SHAPE_OP_COUNT || (size_t)(end - pc) < g_op_size[op]) {          \
+            goto fail;                                                              \
+        }                                                                           \
+        arg = pc + 1;                                                               \
+        pc += g_op_size[op];                                                        \
+        self->op_counts[op]++;                                                      \
+    } while (0)
+
+bool shapeScript_run(shape_script_t *self, const uint8_t *code, size_t size)
+{
+    if (self == NULL || code == NULL) {
+        return false;
+    }
+
+    const uint8_t *pc = code;
+    const uint8_t *end = code + size;
+    const uint8_t *cmd = code;
+    const uint8_t *arg = code;
+    api_shape_t *shape = NULL;
+    uint8_t op = 0;
+
+#if SHAPE_SCRIPT_COMPUTED_GOTO
+    static void *const labels[SHAPE_OP_COUNT] = {
+        [SHAPE_OP_END] = &&L_SHAPE_OP_END,
+        [SHAPE_OP_RECTANGLE] = &&L_SHAPE_OP_RECTANGLE,
+        [SHAPE_OP_CIRCLE] = &&L_SHAPE_OP_CIRCLE,
+        [SHAPE_OP_TRIANGLE] = &&L_SHAPE_OP_TRIANGLE,
+        [SHAPE_OP_RESIZE] = &&L_SHAPE_OP_RESIZE,
+        [SHAPE_OP_SET_COLOR] = &&L_SHAPE_OP_SET_COLOR,
+        [SHAPE_OP_SET_VISIBLE] = &&L_SHAPE_OP_SET_VISIBLE,
+        [SHAPE_OP_CANVAS_ADD] = &&L_SHAPE_OP_CANVAS_ADD,
+        [SHAPE_OP_CANVAS_MOVE] = &&L_SHAPE_OP_CANVAS_MOVE,
+        [SHAPE_OP_CANVAS_REMOVE] = &&L_SHAPE_OP_CANVAS_REMOVE,
+        [SHAPE_OP_CANVAS_TASK] = &&L_SHAPE_OP_CANVAS_TASK,
+        [SHAPE_OP_REGISTER] = &&L_SHAPE_OP_REGISTER,
+    };
+    NEXT();
+#else
+    for (;;) {
+        FETCH();
+        switch ((shape_op_t)op) {
+#endif
+
+    OP(SHAPE_OP_END)
+        return true;
+
+    OP(SHAPE_OP_RECTANGLE)
+        if (!create_shape(self, arg, SHAPE_TYPE_RECTANGLE)) {
+            goto fail;
+        }
+        NEXT();
+
+    OP(SHAPE_OP_CIRCLE)
+        if (!create_shape(self, arg, SHAPE_TYPE_CIRCLE)) {
+            goto fail;
+        }
+        NEXT();
+
+    OP(SHAPE_OP_TRIANGLE)
+        if (!create_shape(self, arg, SHAPE_TYPE_TRIANGLE)) {
+            goto fail;
+        }
+        NEXT();
+
+    OP(SHAPE_OP_RESIZE)
+        shape = slot_shape(self, arg);
+        if (shape == NULL || !resize_shape(shape, read_u32(&arg[1]), read_u32(&arg[5]))) {
+            goto fail;
+        }
+        NEXT();
+
+    OP(SHAPE_OP_SET_COLOR)
+        shape = slot_shape(self, arg);
+        if (shape == NULL) {
+            goto fail;
+        }
+        shape->base.color = read_u32(&arg[1]);
+        NEXT();
+
+    OP(SHAPE_OP_SET_VISIBLE)
+        shape = slot_shape(self, arg);
+        if (shape == NULL) {
+            goto fail;
+        }
+        shape->base.visible = (arg[1] != 0);
+        NEXT();
+
+    OP(SHAPE_OP_CANVAS_ADD)
+        shape = slot_shape(self, arg);
+        if (shape == NULL || !canvas_addShape(shape, (int16_t)read_u16(&arg[1]), (int16_t)read_u16(&arg[3]))) {
+            goto fail;
+        }
+        NEXT();
+
+    OP(SHAPE_OP_CANVAS_MOVE)
+        shape = slot_shape(self, arg);
+        if (shape == NULL) {
+            goto fail;
+        }
+        canvas_moveShape(shape, (int16_t)read_u16(&arg[1]), (int16_t)read_u16(&arg[3]));
+        NEXT();
+
+    OP(SHAPE_OP_CANVAS_REMOVE)
+        shape = slot_shape(self, arg);
+        if (shape == NULL) {
+            goto fail;
+        }
+        canvas_removeShape(shape);
+        NEXT();
+
+    OP(SHAPE_OP_CANVAS_TASK)
+        for (uint16_t i = read_u16(arg); i > 0; i--) {
+            canvas_task();
+        }
+        NEXT();
+
+    OP(SHAPE_OP_REGISTER)
+        shape = slot_shape(self, arg);
+        if (shape == NULL || !shapeRegistry_Register(shape)) {
+            goto fail;
+        }
+        NEXT();
+
+#if !SHAPE_SCRIPT_COMPUTED_GOTO
+        case SHAPE_OP_COUNT:
+        default:
+            goto fail;
+        }
+    }
+#endif
+
+fail:
+    self->error_offset = (size_t)(cmd - code);
+    return false;
+}
+
+#undef OP
+#undef NEXT
+#undef FETCH
+
+void shapeScript_resetCounters(shape_script_t *self)
+{
+    memset(self->op_counts, 0, sizeof(self->op_counts));
+}
+
+api_shape_t *shapeScript_getShape(shape_script_t *self, uint32_t slot)
+{
+    if (self == NULL || slot >= self->slot_count || self->slots[slot].super.vptr == NULL) {
+        return NULL;
+    }
+    return &self->slots[slot].super;
+}
+
+// --- Stream builder ---
+
+void shapeScript_writerInit(shape_script_writer_t *writer, uint8_t *buffer, size_t capacity)
+{
+    writer->buffer = buffer;
+    writer->capacity = (buffer != NULL) ? capacity : 0;
+    writer->size = 0;
+    writer->overflow = false;
+}
+
+bool shapeScript_emitRectangle(shape_script_writer_t *writer, uint8_t slot, const rect_config_t *rect_conf,
+                               const shape_config_t *shape_conf)
+{
+    uint8_t command[15] = {SHAPE_OP_RECTANGLE, slot};
+    uint8_t *p = put_u32(&command[2], shape_conf->color);
+    *p++ = shape_conf->visible ? 1 : 0;
+    p = put_u32(p, rect_conf->width);
+    put_u32(p, rect_conf->height);
+    return emit(writer, command, sizeof(command));
+}
+
+bool shapeScript_emitCircle(shape_script_writer_t *writer, uint8_t slot, const circle_config_t *circle_conf,
+                            const shape_config_t *shape_conf)
+{
+    uint8_t command[11] = {SHAPE_OP_CIRCLE, slot};
+    uint8_t *p = put_u32(&command[2], shape_conf->color);
+    *p++ = shape_conf->visible ? 1 : 0;
+    put_u32(p, circle_conf->radius);
+    return emit(writer, command, sizeof(command));
+}
+
+bool shapeScript_emitTriangle(shape_script_writer_t *writer, uint8_t slot, const triangle_config_t *tri_conf,
+                              const shape_config_t *shape_conf)
+{
+    uint8_t command[15] = {SHAPE_OP_TRIANGLE, slot};
+    uint8_t *p = put_u32(&command[2], shape_conf->color);
+    *p++ = shape_conf->visible ? 1 : 0;
+    p = put_u32(p, tri_conf->base);
+    put_u32(p, tri_conf->height);
+    return emit(writer, command, sizeof(command));
+}
+
+bool shapeScript_emitResize(shape_script_writer_t *writer, uint8_t slot, uint32_t dim_a, uint32_t dim_b)
+{
+    uint8_t command[10] = {SHAPE_OP_RESIZE, slot};
+    put_u32(put_u32(&command[2], dim_a), dim_b);
+    return emit(writer, command, sizeof(command));
+}
+
+bool shapeScript_emitSetColor(shape_script_writer_t *writer, uint8_t slot, uint32_t color)
+{
+    uint8_t command[6] = {SHAPE_OP_SET_COLOR, slot};
+    put_u32(&command[2], color);
+    return emit(writer, command, sizeof(command));
+}
+
+bool shapeScript_emitSetVisible(shape_script_writer_t *writer, uint8_t slot, bool visible)
+{
+    uint8_t command[3] = {SHAPE_OP_SET_VISIBLE, slot, visible ? 1 : 0};
+    return emit(writer, command, sizeof(command));
+}
+
+bool shapeScript_emitCanvasAdd(shape_script_writer_t *writer, uint8_t slot, int16_t x, int16_t y)
+{
+    uint8_t command[6] = {SHAPE_OP_CANVAS_ADD, slot};
+    put_u16(put_u16(&command[2], (uint16_t)x), (uint16_t)y);
+    return emit(writer, command, sizeof(command));
+}
+
+bool shapeScript_emitCanvasMove(shape_script_writer_t *writer, uint8_t slot, int16_t x, int16_t y)
+{
+    uint8_t command[6] = {SHAPE_OP_CANVAS_MOVE, slot};
+    put_u16(put_u16(&command[2], (uint16_t)x), (uint16_t)y);
+    return emit(writer, command, sizeof(command));
+}
+
+bool shapeScript_emitCanvasRemove(shape_script_writer_t *writer, uint8_t slot)
+{
+    uint8_t command[2] = {SHAPE_OP_CANVAS_REMOVE, slot};
+    return emit(writer, command, sizeof(command));
+}
+
+bool shapeScript_emitCanvasTask(shape_script_writer_t *writer, uint16_t repeat)
+{
+    uint8_t command[3] = {SHAPE_OP_CANVAS_TASK};
+    put_u16(&command[1], repeat);
+    return emit(writer, command, sizeof(command));
+}
+
+bool shapeScript_emitRegister(shape_script_writer_t *writer, uint8_t slot)
+{
+    uint8_t command[2] = {SHAPE_OP_REGISTER, slot};
+    return emit(writer, command, sizeof(command));
+}
+
+bool shapeScript_emitEnd(shape_script_writer_t *writer)
+{
+    uint8_t command[1] = {SHAPE_OP_END};
+    return emit(writer, command, sizeof(command));
+}
+
+/* Static helper functions */
+
+static uint16_t read_u16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t read_u32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// arg[0] is the slot operand of every slot command
+static api_shape_t *slot_shape(shape_script_t *self, const uint8_t *arg)
+{
+    return shapeScript_getShape(self, arg[0]);
+}
+
+// Operands: slot, color, visible, dim_a[, dim_b]
+static bool create_shape(shape_script_t *self, const uint8_t *arg, shape_type_t type)
+{
+    // An occupied slot may be registered or on the canvas: never rebuild it in place
+    if (arg[0] >= self->slot_count || shapeScript_getShape(self, arg[0]) != NULL) {
+        return false;
+    }
+
+    factory_config_t config;
+    config.shape_conf.type = type;
+    config.shape_conf.color = read_u32(&arg[1]);
+    config.shape_conf.visible = (arg[5] != 0);
+
+    switch (type) {
+        case SHAPE_TYPE_RECTANGLE:
+            config.shape.rect.width = read_u32(&arg[6]);
+            config.shape.rect.height = read_u32(&arg[10]);
+            break;
+        case SHAPE_TYPE_CIRCLE:
+            config.shape.circle.radius = read_u32(&arg[6]);
+            break;
+        case SHAPE_TYPE_TRIANGLE:
+            config.shape.triangle.base = read_u32(&arg[6]);
+            config.shape.triangle.height = read_u32(&arg[10]);
+            break;
+        default:
+            return false;
+    }
+    return factory_shape_create(&self->slots[arg[0]].super, &config) != NULL;
+}
+
+static bool resize_shape(api_shape_t *shape, uint32_t dim_a, uint32_t dim_b)
+{
+    api_shape_storage_t *slot = (api_shape_storage_t *)shape;
+
+    switch (shape->base.type) {
+        case SHAPE_TYPE_RECTANGLE:
+            rect_updateDimensions(&slot->api_rectangle.rect, dim_a, dim_b);
+            return true;
+        case SHAPE_TYPE_CIRCLE:
+            circle_updateRadius(slot->api_circle.circle, dim_a);
+            return true;
+        case SHAPE_TYPE_TRIANGLE:
+            triangle_updateDimensions(&slot->api_triangle.triangle, dim_a, dim_b);
+            return true;
+        default:
+            return false;
+    }
+}
+
+static bool emit(shape_script_writer_t *writer, const uint8_t *command, size_t size)
+{
+    if (writer->overflow || writer->capacity - writer->size < size) {
+        writer->overflow = true;
+        return false;
+    }
+    memcpy(&writer->buffer[writer->size], command, size);
+    writer->size += size;
+    return true;
+}
+
+static uint8_t *put_u16(uint8_t *p, uint16_t value)
+{
+    p[0] = (uint8_t)value;
+    p[1] = (uint8_t)(value >> 8);
+    return p + 2;
+}
+
+static uint8_t *put_u32(uint8_t *p, uint32_t value)
+{
+    p[0] = (uint8_t)value;
+    p[1] = (uint8_t)(value >> 8);
+    p[2] = (uint8_t)(value >> 16);
+    p[3] = (uint8_t)(value >> 24);
+    return p + 4;
+}
@@ -0,0 +1,307 @@
+#include "shape_store.h"
+#include "shape_math.h"
+#include "shape_batch.h"
+#include "shape_seqlock.h"
+#include "common.h"
+#include <stdio.h>
+#include <string.h>
+
+// Shapes per block: the scaled dimensions are still in L1 when the caches are refreshed
+#define SCALE_BLOCK 256u
+
+static shape_store_lane_t *lane_of(const shape_store_t *self, shape_type_t type);
+static api_shape_t *add_shape(shape_store_t *self, shape_config_t *shape_conf, uint32_t dim_a, uint32_t dim_b);
+static void refresh_slot(shape_store_lane_t *lane, shape_type_t type, uint32_t index);
+
+// --- Interface Implementations ---
+
+static void draw(api_shape_t *self)
+{
+    shape_store_handle_t *this = (shape_store_handle_t *)self;
+    shape_store_lane_t *lane = lane_of(this->store, self->base.type);
+
+    printf("Drawing Stored Shape: Type=%d, A=%u, B=%u, Color=%X\n", (int)self->base.type,
+           lane->dim_a[this->index], lane->dim_b[this->index], lane->color[this->index]);
+}
+
+static float get_area(api_shape_t *self)
+{
+    shape_store_handle_t *this = (shape_store_handle_t *)self;
+    return shapeSeqlock_loadFloat(&lane_of(this->store, self->base.type)->area[this->index]);
+}
+
+static uint32_t get_perimeter(api_shape_t *self)
+{
+    shape_store_handle_t *this = (shape_store_handle_t *)self;
+    return shapeSeqlock_loadU32(&lane_of(this->store, self->base.type)->perimeter[this->index]);
+}
+
+// One counter per store: any update marks every handle as changed
+static uint32_t get_generation(api_shape_t *self)
+{
+    return shapeSeqlock_load(&((shape_store_handle_t *)self)->store->generation);
+}
+
+// Every handle reports the store's counter: one notify per store update
+static const void *get_change_key(api_shape_t *self)
+{
+    return &((shape_store_handle_t *)self)->store->generation;
+}
+
+// Batch slots: one call per group of store handles
+static void get_area_many(api_shape_t **shapes, uint32_t n, float *out)
+{
+    for (uint32_t i = 0; i < n; i++) {
+        out[i] = get_area(shapes[i]);
+    }
+}
+
+static void get_perimeter_many(api_shape_t **shapes, uint32_t n, uint32_t *out)
+{
+    for (uint32_t i = 0; i < n; i++) {
+        out[i] = get_perimeter(shapes[i]);
+    }
+}
+
+// --- VTable Definition ---
+static const shape_vtable_t store_vtable = {
+    .draw = draw,
+    .get_area = get_area,
+    .get_perimeter = get_perimeter,
+    .get_area_many = get_area_many,
+    .get_perimeter_many = get_perimeter_many,
+    .get_generation = get_generation,
+    .get_change_key = get_change_key
+};
+
+// --- Public API ---
+
+bool shapeStore_init(shape_store_t *self, const shape_store_config_t *config)
+{
+    if (self == NULL || config == NULL || config->memory == NULL) {
+        return false;
+    }
+
+    memset(self, 0, sizeof(shape_store_t));
+
+    uint8_t *cursor = (uint8_t *)config->memory;
+    size_t remaining = config->memory_size;
+
+    for (uint32_t i = 0; i < SHAPE_STORE_LANE_COUNT; i++) {
+        shape_store_lane_t *lane = &self->lanes[i];
+        size_t n = config->capacity[i];
+
+        lane->handles = common_carve(&cursor, &remaining, n * sizeof(shape_store_handle_t), sizeof(void *));
+        lane->dim_a = common_carve(&cursor, &remaining, n * sizeof(uint32_t), sizeof(uint32_t));
+        lane->dim_b = common_carve(&cursor, &remaining, n * sizeof(uint32_t), sizeof(uint32_t));
+        lane->color = common_carve(&cursor, &remaining, n * sizeof(uint32_t), sizeof(uint32_t));
+        lane->area = common_carve(&cursor, &remaining, n * sizeof(float), sizeof(float));
+        lane->perimeter = common_carve(&cursor, &remaining, n * sizeof(uint32_t), sizeof(uint32_t));
+        lane->visible = common_carve(&cursor, &remaining, n * sizeof(bool), sizeof(bool));
+
+        if (lane->handles == NULL || lane->dim_a == NULL || lane->dim_b == NULL || lane->color == NULL ||
+            lane->area == NULL || lane->perimeter == NULL || lane->visible == NULL) {
+            memset(self, 0, sizeof(shape_store_t));
+            return false; // Error: memory block is too small for the requested capacity
+        }
+        lane->capacity = (uint32_t)n;
+    }
+    return true;
+}
+
+void shapeStore_clear(shape_store_t *self)
+{
+    shapeSeqlock_writeBegin(&self->generation);
+    for (uint32_t i = 0; i < SHAPE_STORE_LANE_COUNT; i++) {
+        self->lanes[i].count = 0;
+    }
+    shapeSeqlock_writeEnd(&self->generation);
+}
+
+api_shape_t *shapeStore_addRectangle(shape_store_t *self, rect_config_t *rect_conf, shape_config_t *shape_conf)
+{
+    if (self == NULL || rect_conf == NULL || shape_conf == NULL || shape_conf->type != SHAPE_TYPE_RECTANGLE) {
+        return NULL;
+    }
+    return add_shape(self, shape_conf, rect_conf->width, rect_conf->height);
+}
+
+api_shape_t *shapeStore_addCircle(shape_store_t *self, circle_config_t *circle_conf, shape_config_t *shape_conf)
+{
+    if (self == NULL || circle_conf == NULL || shape_conf == NULL || shape_conf->type != SHAPE_TYPE_CIRCLE) {
+        return NULL;
+    }
+    return add_shape(self, shape_conf, circle_conf->radius, 0);
+}
+
+api_shape_t *shapeStore_addTriangle(shape_store_t *self, triangle_config_t *tri_conf, shape_config_t *shape_conf)
+{
+    if (self == NULL || tri_conf == NULL || shape_conf == NULL || shape_conf->type != SHAPE_TYPE_TRIANGLE) {
+        return NULL;
+    }
+    return add_shape(self, shape_conf, tri_conf->base, tri_conf->height);
+}
+
+bool shapeStore_updateDimensions(api_shape_t *shape, uint32_t dim_a, uint32_t dim_b)
+{
+    if (shape == NULL || shape->vptr != &store_vtable) {
+        return false;
+    }
+
+    shape_store_handle_t *handle = (shape_store_handle_t *)shape;
+    shape_store_lane_t *lane = lane_of(handle->store, shape->base.type);
+
+    shapeSeqlock_writeBegin(&handle->store->generation);
+    lane->dim_a[handle->index] = dim_a;
+    lane->dim_b[handle->index] = (shape->base.type == SHAPE_TYPE_CIRCLE) ? 0 : dim_b;
+    refresh_slot(lane, shape->base.type, handle->index);
+    shapeSeqlock_writeEnd(&handle->store->generation);
+    return true;
+}
+
+void shapeStore_setVisible(api_shape_t *shape, bool visible)
+{
+    if (shape == NULL || shape->vptr != &store_vtable) {
+        return;
+    }
+
+    shape_store_handle_t *handle = (shape_store_handle_t *)shape;
+    lane_of(handle->store, shape->base.type)->visible[handle->index] = visible;
+    shape->base.visible = visible;
+}
+
+void shapeStore_refresh(shape_store_t *self)
+{
+    shapeSeqlock_writeBegin(&self->generation);
+    for (uint32_t l = 0; l < SHAPE_STORE_LANE_COUNT; l++) {
+        shape_store_lane_t *lane = &self->lanes[l];
+        shape_type_t type = (shape_type_t)(SHAPE_TYPE_RECTANGLE + l);
+
+        shape_get_area_n(type, lane->dim_a, lane->dim_b, lane->area, lane->count);
+        shape_get_perimeter_n(type, lane->dim_a, lane->dim_b, lane->perimeter, lane->count);
+    }
+    shapeSeqlock_writeEnd(&self->generation);
+}
+
+void shapeStore_scale(shape_store_t *self, float scale)
+{
+    shapeSeqlock_writeBegin(&self->generation);
+    for (uint32_t l = 0; l < SHAPE_STORE_LANE_COUNT; l++) {
+        shape_store_lane_t *lane = &self->lanes[l];
+        shape_type_t type = (shape_type_t)(SHAPE_TYPE_RECTANGLE + l);
+
+        for (uint32_t i = 0; i < lane->count; i += SCALE_BLOCK) {
+            uint32_t n = (lane->count - i < SCALE_BLOCK) ? (lane->count - i) : SCALE_BLOCK;
+
+            shape_scale_n(&lane->dim_a[i], scale, n);
+            shape_scale_n(&lane->dim_b[i], scale, n); // Circles keep 0
+            shape_get_area_n(type, &lane->dim_a[i], &lane->dim_b[i], &lane->area[i], n);
+            shape_get_perimeter_n(type, &lane->dim_a[i], &lane->dim_b[i], &lane->perimeter[i], n);
+        }
+    }
+    shapeSeqlock_writeEnd(&self->generation);
+}
+
+uint32_t shapeStore_getCount(const shape_store_t *self, shape_type_t type)
+{
+    const shape_store_lane_t *lane = shapeStore_getLane(self, type);
+    return (lane != NULL) ? lane->count : 0;
+}
+
+const shape_store_lane_t *shapeStore_getLane(const shape_store_t *self, shape_type_t type)
+{
+    if (self == NULL) {
+        return NULL;
+    }
+    return lane_of(self, type);
+}
+
+void shapeStore_findBiggest(const shape_store_t *self, api_shape_t **biggestArea, api_shape_t **biggestPerimeter)
+{
+    float max_area = 0.0f;
+    uint32_t max_perimeter = 0;
+    api_shape_t *shape_with_max_area = NULL;
+    api_shape_t *shape_with_max_perimeter = NULL;
+
+    for (uint32_t l = 0; l < SHAPE_STORE_LANE_COUNT; l++) {
+        const shape_store_lane_t *lane = &self->lanes[l];
+
+        // Both maxima in one pass over the dense value arrays
+        for (uint32_t i = 0; i < lane->count; i++) {
+            if (lane->area[i] > max_area) {
+                max_area = lane->area[i];
+                shape_with_max_area = &lane->handles[i].super;
+            }
+            if (lane->perimeter[i] > max_perimeter) {
+                max_perimeter = lane->perimeter[i];
+                shape_with_max_perimeter = &lane->handles[i].super;
+            }
+        }
+    }
+
+    if (biggestArea != NULL) {
+        *biggestArea = shape_with_max_area;
+    }
+    if (biggestPerimeter != NULL) {
+        *biggestPerimeter = shape_with_max_perimeter;
+    }
+}
+
+/* Static helper functions */
+
+static shape_store_lane_t *lane_of(const shape_store_t *self, shape_type_t type)
+{
+    if (type < SHAPE_TYPE_RECTANGLE || type > SHAPE_TYPE_TRIANGLE) {
+        return NULL;
+    }
+    return (shape_store_lane_t *)&self->lanes[type - SHAPE_TYPE_RECTANGLE];
+}
+
+static api_shape_t *add_shape(shape_store_t *self, shape_config_t *shape_conf, uint32_t dim_a, uint32_t dim_b)
+{
+    shape_store_lane_t *lane = lane_of(self, shape_conf->type);
+
+    if (lane == NULL || lane->count >= lane->capacity) {
+        return NULL;
+    }
+
+    uint32_t index = lane->count;
+    shape_store_handle_t *handle = &lane->handles[index];
+
+    api_shape_init(&handle->super, shape_conf, &store_vtable);
+    handle->store = self;
+    handle->index = index;
+
+    lane->dim_a[index] = dim_a;
+    lane->dim_b[index] = dim_b;
+    lane->color[index] = shape_conf->color;
+    lane->visible[index] = shape_conf->visible;
+    refresh_slot(lane, shape_conf->type, index);
+
+    lane->count++;
+    return &handle->super;
+}
+
+// Recomputes the dependent state (shared formulas keep it equal to the api_* shapes)
+static void refresh_slot(shape_store_lane_t *lane, shape_type_t type, uint32_t index)
+{
+    uint32_t a = lane->dim_a[index];
+    uint32_t b = lane->dim_b[index];
+
+    switch (type) {
+        case SHAPE_TYPE_RECTANGLE:
+            shapeSeqlock_storeFloat(&lane->area[index], shapeMath_rectArea(a, b));
+            shapeSeqlock_storeU32(&lane->perimeter[index], shapeMath_rectPerimeter(a, b));
+            break;
+        case SHAPE_TYPE_CIRCLE:
+            shapeSeqlock_storeFloat(&lane->area[index], shapeMath_circleArea(a));
+            shapeSeqlock_storeU32(&lane->perimeter[index], shapeMath_circlePerimeter(a));
+            break;
+        case SHAPE_TYPE_TRIANGLE:
+            shapeSeqlock_storeFloat(&lane->area[index], shapeMath_triangleArea(a, b));
+            shapeSeqlock_storeU32(&lane->perimeter[index], 0); // As api_triangle_get_perimeter
+            break;
+        default:
+            break;
+    }
+}
@@ -1,24 +1,38 @@
 #include "triangle.h"
+#include "shape_math.h"
+#include "shape_seqlock.h"
+#include "common.h"
 
-#define PI 3.14159f
+// Public fields come first, the private block mirrors triangle_config_t
+STATIC_ASSERT(offsetof(triangle_t, area) == 0, triangle_public_fields_first);
+STATIC_ASSERT(sizeof(_triangle_private_t) == sizeof(triangle_config_t), triangle_private_mirrors_config);
+
+static void update_dependent_state(hTriangle_t self);
 
 void triangle_init(hTriangle_t self, triangle_config_t *config)
 {
     self->_private.base = config->base;
     self->_private.height = config->height;
+    *(uint32_t *)&self->generation = 0;
     
-    *(float *)&self->area = (float)(self->_private.base * self->_private.height) / 2.0f;
+    update_dependent_state(self);
 }
 
 void triangle_updateDimensions(hTriangle_t self, uint32_t base, uint32_t height)
 {
-    self->_private.base = base;
-    self->_private.height = height;
-    
-    *(float *)&self->area = (float)(base * height) / 2.0f;
+    shapeSeqlock_writeBegin((uint32_t *)&self->generation);
+    shapeSeqlock_storeU32(&self->_private.base, base);
+    shapeSeqlock_storeU32(&self->_private.height, height);
+    update_dependent_state(self);
+    shapeSeqlock_writeEnd((uint32_t *)&self->generation);
 }
 
 _triangle_private_t* triangle_getPrivateInfo(hTriangle_t self)
 {
     return &self->_private;
 }
+
+static void update_dependent_state(hTriangle_t self)
+{
+    shapeSeqlock_storeFloat((float *)&self->area, shapeMath_triangleArea(self->_private.base, self->_private.height));
+}
@@ -0,0 +1,139 @@
+#include "CppUTest/TestHarness.h"
+
+extern "C" {
+    #include "shape_arena.h"
+    #include "shape_registry.h"
+}
+
+static int g_moveCount = 0;
+
+static void countMove(api_shape_t *shape, void *context)
+{
+    (void)shape;
+    (void)context;
+    g_moveCount++;
+}
+
+static factory_config_t rect_config(uint32_t width, uint32_t height)
+{
+    factory_config_t conf = {};
+    conf.shape_conf.type = SHAPE_TYPE_RECTANGLE;
+    conf.shape_conf.color = 0xFF0000;
+    conf.shape_conf.visible = true;
+    conf.shape.rect.width = width;
+    conf.shape.rect.height = height;
+    return conf;
+}
+
+TEST_GROUP(ShapeArena_BumpPattern)
+{
+    alignas(api_shape_storage_t) uint8_t memory[1024];
+    shape_arena_t arena;
+    const shape_registry_data_t *registry;
+
+    void setup()
+    {
+        g_moveCount = 0;
+        registry = shapeRegistry_Init();
+
+        canvas_config_t canvas = {};
+        shape_arena_config_t config = {};
+        config.memory = memory;
+        config.memory_size = sizeof(memory);
+        config.canvas = &canvas; // Scene mode
+        CHECK_TRUE(shapeArena_init(&arena, &config));
+    }
+
+    void teardown()
+    {
+    }
+};
+
+TEST(ShapeArena_BumpPattern, usage_example)
+{
+    // 1. Build a level: shapes and observers all come from the arena
+    factory_config_t conf = rect_config(10, 20);
+    api_shape_t *rect = shapeArena_create(&arena, &conf);
+    conf.shape_conf.type = SHAPE_TYPE_CIRCLE;
+    conf.shape.circle.radius = 5;
+    api_shape_t *circle = shapeArena_create(&arena, &conf);
+    CHECK(rect != NULL);
+    CHECK(circle != NULL);
+    DOUBLES_EQUAL(200.0, shape_get_area(rect), 0.1);
+
+    CHECK_TRUE(canvas_addShape(rect, 0, 0));
+    CHECK_TRUE(shapeRegistry_Register(rect));
+    CHECK_TRUE(shapeRegistry_Register(circle));
+    CHECK(shapeArena_addMoveObserver(&arena, countMove, NULL) != NULL);
+    canvas_moveShape(rect, 1, 0);
+    CHECK_TRUE(canvas_isMoving(rect));
+
+    // 2. End of level: one call, no per-object teardown
+    shapeArena_reset(&arena);
+    LONGS_EQUAL(0, shapeArena_getUsed(&arena));
+    LONGS_EQUAL(0, registry->count);
+    CHECK_FALSE(canvas_isMoving(rect));
+
+    // 3. The next level reuses the same memory
+    POINTERS_EQUAL(rect, shapeArena_create(&arena, &conf));
+    for (int i = 0; i < 4; i++) {
+        canvas_task();
+    }
+    LONGS_EQUAL(0, g_moveCount); // The old observer is gone
+}
+
+TEST(ShapeArena_BumpPattern, reset_frees_every_canvas_slot)
+{
+    factory_config_t conf = rect_config(1, 1);
+
+    for (int level = 0; level < 3; level++) {
+        for (int i = 0; i < CANVAS_MAX_SHAPES; i++) {
+            CHECK_TRUE(canvas_addShape(shapeArena_create(&arena, &conf), 0, 0));
+        }
+        CHECK_FALSE(canvas_addShape(shapeArena_create(&arena, &conf), 0, 0));
+        shapeArena_reset(&arena);
+    }
+}
+
+TEST(ShapeArena_BumpPattern, alignment_and_exhaustion)
+{
+    uint8_t *byte = (uint8_t *)shapeArena_alloc(&arena, 1, 1);
+    uint8_t *word = (uint8_t *)shapeArena_alloc(&arena, 4, 8);
+    uintptr_t misalignment = (uintptr_t)word % 8;
+    LONGS_EQUAL(0, misalignment);
+    CHECK(word > byte);
+    LONGS_EQUAL(word + 4 - memory, shapeArena_getUsed(&arena));
+
+    POINTERS_EQUAL(NULL, shapeArena_alloc(&arena, 8, 3)); // Not a power of two
+    POINTERS_EQUAL(NULL, shapeArena_alloc(&arena, sizeof(memory), 1));
+    CHECK(shapeArena_alloc(&arena, sizeof(memory) - shapeArena_getUsed(&arena), 1) != NULL);
+    POINTERS_EQUAL(NULL, shapeArena_alloc(&arena, 1, 1));
+
+    // High water survives the reset
+    shapeArena_reset(&arena);
+    LONGS_EQUAL(sizeof(memory), shapeArena_getHighWater(&arena));
+
+    factory_config_t conf = rect_config(1, 1);
+    conf.shape_conf.type = (shape_type_t)99;
+    POINTERS_EQUAL(NULL, shapeArena_create(&arena, &conf));
+    LONGS_EQUAL(0, shapeArena_getUsed(&arena));
+}
+
+TEST(ShapeArena_BumpPattern, plain_mode_leaves_singletons_alone)
+{
+    api_rectangle_t outside = {};
+    rect_config_t rect_conf = {3, 4};
+    shape_config_t shape_conf = {SHAPE_TYPE_RECTANGLE, 0, true};
+    api_rectangle_init(&outside, &rect_conf, &shape_conf);
+    CHECK_TRUE(shapeRegistry_Register(&outside.super));
+
+    shape_arena_t plain;
+    uint8_t block[64];
+    shape_arena_config_t config = {block, sizeof(block), NULL};
+    CHECK_TRUE(shapeArena_init(&plain, &config));
+    CHECK(shapeArena_alloc(&plain, 16, 4) != NULL);
+
+    shapeArena_reset(&plain);
+    LONGS_EQUAL(0, shapeArena_getUsed(&plain));
+    LONGS_EQUAL(1, registry->count);
+}
@@ -0,0 +1,139 @@
+#include "CppUTest/TestHarness.h"
+#include <string.h>
+
+extern "C" {
+    #include "shape_batch.h"
+    #include "shape_math.h"
+}
+
+// Odd size so the scalar tail of every SIMD kernel is exercised
+#define BATCH_SIZE 37
+
+static uint32_t next_random(uint32_t *state)
+{
+    *state = *state * 1664525u + 1013904223u;
+    return *state;
+}
+
+TEST_GROUP(ShapeBatch_Kernels)
+{
+    uint32_t dim_a[BATCH_SIZE];
+    uint32_t dim_b[BATCH_SIZE];
+    float area[BATCH_SIZE];
+    float expected_area[BATCH_SIZE];
+    uint32_t perimeter[BATCH_SIZE];
+    uint32_t expected_perimeter[BATCH_SIZE];
+
+    void setup()
+    {
+        // Mix of small, large (wrapping) and edge values
+        uint32_t seed = 12345;
+        for (uint32_t i = 0; i < BATCH_SIZE; i++) {
+            dim_a[i] = (i % 3 == 0) ? next_random(&seed) : (next_random(&seed) % 5000);
+            dim_b[i] = (i % 4 == 0) ? next_random(&seed) : (next_random(&seed) % 5000);
+        }
+        dim_a[1] = 0;
+        dim_a[2] = 0xFFFFFFFFu;
+        dim_a[5] = 16777217u; // first integer not representable as float
+    }
+
+    void teardown()
+    {
+    }
+};
+
+TEST(ShapeBatch_Kernels, usage_example)
+{
+    // 1. Dimensions of several rectangles, as stored by a shape_store lane
+    uint32_t widths[] = {10, 50, 5};
+    uint32_t heights[] = {20, 100, 10};
+    float areas[3];
+    uint32_t perimeters[3];
+
+    // 2. One call computes the whole array
+    shape_get_area_n(SHAPE_TYPE_RECTANGLE, widths, heights, areas, 3);
+    shape_get_perimeter_n(SHAPE_TYPE_RECTANGLE, widths, heights, perimeters, 3);
+
+    DOUBLES_EQUAL(200.0, areas[0], 0.1);
+    DOUBLES_EQUAL(5000.0, areas[1], 0.1);
+    LONGS_EQUAL(300, perimeters[1]);
+}
+
+TEST(ShapeBatch_Kernels, rectangle_is_bit_exact)
+{
+    for (uint32_t i = 0; i < BATCH_SIZE; i++) {
+        expected_area[i] = shapeMath_rectArea(dim_a[i], dim_b[i]);
+        expected_perimeter[i] = shapeMath_rectPerimeter(dim_a[i], dim_b[i]);
+    }
+
+    shape_get_area_n(SHAPE_TYPE_RECTANGLE, dim_a, dim_b, area, BATCH_SIZE);
+    shape_get_perimeter_n(SHAPE_TYPE_RECTANGLE, dim_a, dim_b, perimeter, BATCH_SIZE);
+
+    CHECK_EQUAL(0, memcmp(expected_area, area, sizeof(area)));
+    CHECK_EQUAL(0, memcmp(expected_perimeter, perimeter, sizeof(perimeter)));
+}
+
+TEST(ShapeBatch_Kernels, circle_is_bit_exact)
+{
+    // Keep 2*pi*r inside the uint32 range (the scalar cast is undefined beyond it)
+    for (uint32_t i = 0; i < BATCH_SIZE; i++) {
+        dim_a[i] %= 600000000u;
+        expected_area[i] = shapeMath_circleArea(dim_a[i]);
+        expected_perimeter[i] = shapeMath_circlePerimeter(dim_a[i]);
+    }
+
+    shape_get_area_n(SHAPE_TYPE_CIRCLE, dim_a, NULL, area, BATCH_SIZE);
+    shape_get_perimeter_n(SHAPE_TYPE_CIRCLE, dim_a, NULL, perimeter, BATCH_SIZE);
+
+    CHECK_EQUAL(0, memcmp(expected_area, area, sizeof(area)));
+    CHECK_EQUAL(0, memcmp(expected_perimeter, perimeter, sizeof(perimeter)));
+}
+
+TEST(ShapeBatch_Kernels, triangle_is_bit_exact)
+{
+    for (uint32_t i = 0; i < BATCH_SIZE; i++) {
+        expected_area[i] = shapeMath_triangleArea(dim_a[i], dim_b[i]);
+        expected_perimeter[i] = 0;
+    }
+
+    shape_get_area_n(SHAPE_TYPE_TRIANGLE, dim_a, dim_b, area, BATCH_SIZE);
+    shape_get_perimeter_n(SHAPE_TYPE_TRIANGLE, dim_a, dim_b, perimeter, BATCH_SIZE);
+
+    CHECK_EQUAL(0, memcmp(expected_area, area, sizeof(area)));
+    CHECK_EQUAL(0, memcmp(expected_perimeter, perimeter, sizeof(perimeter)));
+}
+
+TEST(ShapeBatch_Kernels, scale_is_bit_exact)
+{
+    const float scales[] = {0.0f, 0.5f, 1.0f, 1.25f, 3.0f, 1e6f, -2.0f};
+
+    for (uint32_t s = 0; s < sizeof(scales) / sizeof(scales[0]); s++) {
+        uint32_t dims[BATCH_SIZE];
+        uint32_t expected[BATCH_SIZE];
+        for (uint32_t i = 0; i < BATCH_SIZE; i++) {
+            dims[i] = dim_a[i];
+            expected[i] = shapeMath_scaleDim(dim_a[i], scales[s]);
+        }
+
+        shape_scale_n(dims, scales[s], BATCH_SIZE);
+        CHECK_EQUAL(0, memcmp(expected, dims, sizeof(dims)));
+    }
+}
+
+TEST(ShapeBatch_Kernels, scale_saturates)
+{
+    uint32_t dims[] = {10, 0xFFFFFFFFu, 3};
+
+    shape_scale_n(dims, 2.0f, 3);
+    LONGS_EQUAL(20, dims[0]);
+    CHECK_EQUAL(0xFFFFFF00u, dims[1]);
+    LONGS_EQUAL(6, dims[2]);
+
+    shape_scale_n(dims, -1.0f, 3);
+    LONGS_EQUAL(0, dims[0]);
+}
+
+TEST(ShapeBatch_Kernels, backend_is_reported)
+{
+    CHECK_TRUE(shapeBatch_getBackend() != NULL);
+}
@@ -243,6 +243,50 @@ TEST(CanvasMove, usage_example)
     CHECK_FALSE(canvas_isMoving((api_shape_t*)&rect3));
 }
 
+TEST(Canvas, Transform_ScalesAndTranslatesWithoutCallbacks)
+{
+    int context = 0;
+    api_rectangle_t rect = {};
+    rect_config_t rect_conf = {10, 20};
+    shape_config_t shape_conf = {SHAPE_TYPE_RECTANGLE, 0xFF0000, true};
+    api_rectangle_init(&rect, &rect_conf, &shape_conf);
+
+    g_positionCallbackCount = 0;
+    canvas_setPositionChangeCallback(positionTestCallback, &context);
+    canvas_addShape((api_shape_t*)&rect, 10, -4);
+    canvas_moveShape((api_shape_t*)&rect, 12, -4);
+
+    canvas_transform(2.0f, 1, 1);
+    CHECK_EQUAL(0, g_positionCallbackCount);
+
+    // Target moved with the shape: (21, -7) -> (25, -7), one step per task
+    for (int i = 0; i < 5; i++) {
+        canvas_task();
+    }
+    CHECK_EQUAL(4, g_positionCallbackCount);
+    CHECK_EQUAL(25, g_positionX);
+    CHECK_EQUAL(-7, g_positionY);
+    CHECK_FALSE(canvas_isMoving((api_shape_t*)&rect));
+}
+
+TEST(Canvas, Transform_Saturates)
+{
+    api_rectangle_t rect = {};
+    rect_config_t rect_conf = {10, 20};
+    shape_config_t shape_conf = {SHAPE_TYPE_RECTANGLE, 0xFF0000, true};
+    api_rectangle_init(&rect, &rect_conf, &shape_conf);
+
+    g_positionCallbackCount = 0;
+    canvas_setPositionChangeCallback(positionTestCallback, NULL);
+    canvas_addShape((api_shape_t*)&rect, 20000, -20000);
+    canvas_transform(4.0f, 0, 0);
+    canvas_moveShape((api_shape_t*)&rect, 32766, -32767);
+    canvas_task();
+
+    CHECK_EQUAL(32766, g_positionX);
+    CHECK_EQUAL(-32767, g_positionY);
+}
+
 // ============================================
 // Group 3: Canvas Position Listener (1:1)
 // ============================================
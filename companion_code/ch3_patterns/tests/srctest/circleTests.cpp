@@ -4,6 +4,8 @@ extern "C" {
     #include "circle.h"
 }
 
+#include "shapeTolerance.h"
+
 TEST_GROUP(Circle_OpaquePattern){ 
     void setup(){
         // add init 
@@ -31,4 +33,20 @@ TEST(Circle_OpaquePattern, demonstrates_OpaqueHandleUsage)
 
     // Test expected behavior
     CHECK(circle_getArea(hSmall) < circle_getArea(hBig));
-}
\ No newline at end of file
+}
+
+TEST(Circle_OpaquePattern, update_refreshes_cache_and_bumps_generation)
+{
+    circle_memory_t mem = { };
+    circle_config_t conf = {10};
+    hCircle_t circle = circle_init(&mem, &conf);
+
+    uint32_t generation = circle_getGeneration(circle);
+    LONGS_EQUAL(62, circle_getPerimeter(circle));
+
+    circle_updateRadius(circle, 20);
+
+    LONGS_EQUAL(125, circle_getPerimeter(circle));
+    DOUBLES_EQUAL(1256.6, circle_getArea(circle), AREA_TOLERANCE(1256.6, 0.1));
+    CHECK(circle_getGeneration(circle) != generation);
+}
@@ -0,0 +1,168 @@
+#include "CppUTest/TestHarness.h"
+
+extern "C" {
+    #include "shape_compact.h"
+    #include "api_rectangle.h"
+    #include "api_circle.h"
+    #include "api_triangle.h"
+}
+
+static uint32_t g_customDraws = 0;
+
+static void custom_draw(const shape_compact_t *self)
+{
+    (void)self;
+    g_customDraws++;
+}
+
+static float custom_area(const shape_compact_t *self)
+{
+    return (float)shapeCompact_getDimA(self);
+}
+
+static const shape_compact_vtable_t custom_vtable = {custom_draw, custom_area, NULL};
+
+TEST_GROUP(ShapeCompact_PackedPattern)
+{
+    void setup()
+    {
+        g_customDraws = 0;
+    }
+
+    void teardown()
+    {
+    }
+};
+
+TEST(ShapeCompact_PackedPattern, usage_example)
+{
+    // 1. Same configs as the api_* shapes, 8 bytes per shape
+    shape_compact_t rect;
+    rect_config_t rect_conf = {10, 20};
+    shape_config_t rect_shape = {SHAPE_TYPE_RECTANGLE, 0x00FFFF, true};
+    CHECK_TRUE(shapeCompact_initRectangle(&rect, &rect_conf, &rect_shape));
+
+    // 2. Accessors hide the packing (cyan survives both RGB565 and palette mode)
+    LONGS_EQUAL(SHAPE_TYPE_RECTANGLE, shapeCompact_getType(&rect));
+    CHECK_TRUE(shapeCompact_isVisible(&rect));
+    LONGS_EQUAL(0x00FFFF, shapeCompact_getColor(&rect));
+
+    // 3. Polymorphism through the 8-bit vtable index
+    DOUBLES_EQUAL(200.0, shapeCompact_getArea(&rect), 0.001);
+    LONGS_EQUAL(60, shapeCompact_getPerimeter(&rect));
+}
+
+TEST(ShapeCompact_PackedPattern, footprint_is_less_than_half)
+{
+    LONGS_EQUAL(8, sizeof(shape_compact_t));
+    CHECK(2 * sizeof(shape_compact_t) <= sizeof(api_rectangle_t));
+    CHECK(2 * sizeof(shape_compact_t) <= sizeof(api_circle_t));
+    CHECK(2 * sizeof(shape_compact_t) <= sizeof(api_triangle_t));
+}
+
+TEST(ShapeCompact_PackedPattern, values_match_api_shapes)
+{
+    api_circle_t circle = {};
+    circle_config_t circle_conf = {1234};
+    shape_config_t circle_shape = {SHAPE_TYPE_CIRCLE, 0x00FF00, true};
+    api_circle_init(&circle, &circle_conf, &circle_shape);
+
+    api_triangle_t tri = {};
+    triangle_config_t tri_conf = {300, 70};
+    shape_config_t tri_shape = {SHAPE_TYPE_TRIANGLE, 0x0000FF, false};
+    api_triangle_init(&tri, &tri_conf, &tri_shape);
+
+    shape_compact_t compact_circle;
+    shape_compact_t compact_tri;
+    CHECK_TRUE(shapeCompact_initCircle(&compact_circle, &circle_conf, &circle_shape));
+    CHECK_TRUE(shapeCompact_initTriangle(&compact_tri, &tri_conf, &tri_shape));
+
+    DOUBLES_EQUAL(shape_get_area((api_shape_t *)&circle), shapeCompact_getArea(&compact_circle), 0.0);
+    LONGS_EQUAL(shape_get_perimeter((api_shape_t *)&circle), shapeCompact_getPerimeter(&compact_circle));
+    DOUBLES_EQUAL(shape_get_area((api_shape_t *)&tri), shapeCompact_getArea(&compact_tri), 0.0);
+    CHECK_FALSE(shapeCompact_isVisible(&compact_tri));
+    LONGS_EQUAL(SHAPE_TYPE_TRIANGLE, shapeCompact_getType(&compact_tri));
+}
+
+TEST(ShapeCompact_PackedPattern, rejects_dimensions_over_16_bits)
+{
+    shape_compact_t rect;
+    rect_config_t rect_conf = {SHAPE_COMPACT_MAX_DIMENSION + 1, 1};
+    shape_config_t rect_shape = {SHAPE_TYPE_RECTANGLE, 0, true};
+
+    CHECK_FALSE(shapeCompact_initRectangle(&rect, &rect_conf, &rect_shape));
+
+    rect_conf.width = SHAPE_COMPACT_MAX_DIMENSION;
+    CHECK_TRUE(shapeCompact_initRectangle(&rect, &rect_conf, &rect_shape));
+    CHECK_FALSE(shapeCompact_setDimensions(&rect, 1, SHAPE_COMPACT_MAX_DIMENSION + 1));
+    LONGS_EQUAL(SHAPE_COMPACT_MAX_DIMENSION, shapeCompact_getDimA(&rect));
+}
+
+TEST(ShapeCompact_PackedPattern, visible_flag_shares_the_type_byte)
+{
+    shape_compact_t circle;
+    circle_config_t circle_conf = {5};
+    shape_config_t circle_shape = {SHAPE_TYPE_CIRCLE, 0, false};
+    CHECK_TRUE(shapeCompact_initCircle(&circle, &circle_conf, &circle_shape));
+
+    shapeCompact_setVisible(&circle, true);
+    LONGS_EQUAL(SHAPE_TYPE_CIRCLE, shapeCompact_getType(&circle));
+    CHECK_TRUE(shapeCompact_isVisible(&circle));
+
+    shapeCompact_setVisible(&circle, false);
+    LONGS_EQUAL(SHAPE_TYPE_CIRCLE, shapeCompact_getType(&circle));
+    CHECK_FALSE(shapeCompact_isVisible(&circle));
+}
+
+TEST(ShapeCompact_PackedPattern, color_is_packed)
+{
+    shape_compact_t rect;
+    rect_config_t rect_conf = {1, 1};
+    shape_config_t rect_shape = {SHAPE_TYPE_RECTANGLE, 0x123456, true};
+    CHECK_TRUE(shapeCompact_initRectangle(&rect, &rect_conf, &rect_shape));
+
+#if SHAPE_COMPACT_COLOR_PALETTE
+    LONGS_EQUAL(0x3456, shapeCompact_getColor(&rect)); // 16-bit palette index
+#else
+    // RGB565 keeps the top 5/6/5 bits of each channel
+    LONGS_EQUAL(0x123456 & 0xF8FCF8, shapeCompact_getColor(&rect) & 0xF8FCF8);
+    shapeCompact_setColor(&rect, 0xFFFFFF);
+    LONGS_EQUAL(0xFFFFFF, shapeCompact_getColor(&rect));
+#endif
+}
+
+TEST(ShapeCompact_PackedPattern, custom_vtable_by_index)
+{
+    uint8_t index = shapeCompact_registerVtable(&custom_vtable);
+    CHECK(index != SHAPE_COMPACT_NO_VTABLE);
+
+    shape_compact_t rect;
+    rect_config_t rect_conf = {42, 1};
+    shape_config_t rect_shape = {SHAPE_TYPE_RECTANGLE, 0, true};
+    CHECK_TRUE(shapeCompact_initRectangle(&rect, &rect_conf, &rect_shape));
+    CHECK_TRUE(shapeCompact_setVtable(&rect, index));
+
+    shapeCompact_draw(&rect);
+    LONGS_EQUAL(1, g_customDraws);
+    DOUBLES_EQUAL(42.0, shapeCompact_getArea(&rect), 0.001);
+    LONGS_EQUAL(0, shapeCompact_getPerimeter(&rect)); // Empty slot
+    CHECK_FALSE(shapeCompact_setVtable(&rect, SHAPE_COMPACT_MAX_VTABLES));
+}
+
+TEST(ShapeCompact_PackedPattern, unregistered_index_dispatches_nothing)
+{
+    shape_compact_t rect;
+    rect_config_t rect_conf = {42, 1};
+    shape_config_t rect_shape = {SHAPE_TYPE_RECTANGLE, 0, true};
+    CHECK_TRUE(shapeCompact_initRectangle(&rect, &rect_conf, &rect_shape));
+
+    // e.g. a corrupt record: the index is checked, not trusted
+    rect._vtable = 0xFF;
+    shapeCompact_draw(&rect);
+    DOUBLES_EQUAL(0.0, shapeCompact_getArea(&rect), 0.0);
+    LONGS_EQUAL(0, shapeCompact_getPerimeter(&rect));
+
+    shapeCompact_draw(NULL);
+    DOUBLES_EQUAL(0.0, shapeCompact_getArea(NULL), 0.0);
+    LONGS_EQUAL(0, shapeCompact_getPerimeter(NULL));
+}
@@ -4,6 +4,10 @@ extern "C" {
     #include "factory_shape.h"
 }
 
+#include "shapeTolerance.h"
+
+#include <thread>
+
 TEST_GROUP(FactoryPattern)
 {
     void setup()
@@ -61,10 +65,136 @@ TEST(FactoryPattern, Polymorphism)
     DOUBLES_EQUAL(200.0, shape_get_area(shapes[0]), 0.1);
 
     // Circle: pi * 5^2 = 78.53
-    DOUBLES_EQUAL(78.5398, shape_get_area(shapes[1]), 0.1);
+    DOUBLES_EQUAL(78.5398, shape_get_area(shapes[1]), AREA_TOLERANCE(78.5398, 0.1));
 
     // Triangle: 0.5 * 10 * 20 = 100
     DOUBLES_EQUAL(100.0, shape_get_area(shapes[2]), 0.1);
 }
 
 
+
+// Test 2: One slot type holds any shape, scenes are contiguous arrays
+TEST(FactoryPattern, storage_slots)
+{
+    api_shape_storage_t scene[3] = {};
+    factory_config_t conf[3] = {};
+    conf[0].shape_conf = {SHAPE_TYPE_RECTANGLE, 0xFF0000, true};
+    conf[0].shape.rect = {10, 20};
+    conf[1].shape_conf = {SHAPE_TYPE_CIRCLE, 0x00FF00, true};
+    conf[1].shape.circle = {5};
+    conf[2].shape_conf = {SHAPE_TYPE_TRIANGLE, 0x0000FF, true};
+    conf[2].shape.triangle = {10, 20};
+
+    for (int i = 0; i < 3; i++) {
+        POINTERS_EQUAL(&scene[i].super, factory_shape_create(&scene[i].super, &conf[i]));
+    }
+
+    DOUBLES_EQUAL(200.0, shape_get_area(&scene[0].super), 0.1);
+    DOUBLES_EQUAL(78.5, shape_get_area(&scene[1].super), AREA_TOLERANCE(78.5, 0.1));
+    DOUBLES_EQUAL(100.0, shape_get_area(&scene[2].super), 0.1);
+    LONGS_EQUAL(sizeof(api_shape_storage_t), (char *)&scene[1] - (char *)&scene[0]);
+}
+
+// Test 3: Size queries match the concrete types and bound the slot
+TEST(FactoryPattern, sizeof_and_alignof)
+{
+    LONGS_EQUAL(sizeof(api_rectangle_t), factory_shape_sizeof(SHAPE_TYPE_RECTANGLE));
+    LONGS_EQUAL(sizeof(api_circle_t), factory_shape_sizeof(SHAPE_TYPE_CIRCLE));
+    LONGS_EQUAL(sizeof(api_triangle_t), factory_shape_sizeof(SHAPE_TYPE_TRIANGLE));
+    LONGS_EQUAL(alignof(api_circle_t), factory_shape_alignof(SHAPE_TYPE_CIRCLE));
+
+    const shape_type_t types[] = {SHAPE_TYPE_RECTANGLE, SHAPE_TYPE_CIRCLE, SHAPE_TYPE_TRIANGLE};
+    for (shape_type_t type : types) {
+        CHECK(factory_shape_sizeof(type) <= sizeof(api_shape_storage_t));
+        size_t slack = alignof(api_shape_storage_t) % factory_shape_alignof(type);
+        LONGS_EQUAL(0, slack);
+    }
+
+    LONGS_EQUAL(0, factory_shape_sizeof((shape_type_t)99));
+    LONGS_EQUAL(0, factory_shape_alignof((shape_type_t)99));
+}
+
+// Test 4: Bulk creation keeps the config order and groups storage by type
+TEST(FactoryPattern, create_many_partitions_by_type)
+{
+    factory_config_t conf[5] = {};
+    conf[0].shape_conf = {SHAPE_TYPE_TRIANGLE, 0x0000FF, true};
+    conf[0].shape.triangle = {10, 20};
+    conf[1].shape_conf = {SHAPE_TYPE_RECTANGLE, 0xFF0000, true};
+    conf[1].shape.rect = {10, 20};
+    conf[2].shape_conf = {(shape_type_t)99, 0, true};
+    conf[3].shape_conf = {SHAPE_TYPE_CIRCLE, 0x00FF00, true};
+    conf[3].shape.circle = {5};
+    conf[4].shape_conf = {SHAPE_TYPE_RECTANGLE, 0xFFFF00, false};
+    conf[4].shape.rect = {3, 4};
+
+    api_shape_storage_t storage[5] = {};
+    api_shape_t *shapes[5];
+    LONGS_EQUAL(4, factory_shape_create_many(conf, 5, storage, shapes, NULL));
+
+    DOUBLES_EQUAL(100.0, shape_get_area(shapes[0]), 0.1);
+    DOUBLES_EQUAL(200.0, shape_get_area(shapes[1]), 0.1);
+    POINTERS_EQUAL(NULL, shapes[2]);
+    DOUBLES_EQUAL(78.5, shape_get_area(shapes[3]), AREA_TOLERANCE(78.5, 0.1));
+    LONGS_EQUAL(14, shape_get_perimeter(shapes[4]));
+
+    // Rectangles, then circles, then triangles
+    POINTERS_EQUAL(&storage[0].super, shapes[1]);
+    POINTERS_EQUAL(&storage[1].super, shapes[4]);
+    POINTERS_EQUAL(&storage[2].super, shapes[3]);
+    POINTERS_EQUAL(&storage[3].super, shapes[0]);
+}
+
+#define THREAD_COUNT 4
+
+static uint32_t jobs_run;
+
+// Minimal fork/join pool: job j runs on thread j % THREAD_COUNT
+static void thread_run_jobs(void *context, factory_job_t job, void *job_context, uint32_t job_count)
+{
+    (void)context;
+    std::thread threads[THREAD_COUNT];
+
+    jobs_run = job_count;
+    for (uint32_t t = 0; t < THREAD_COUNT; t++) {
+        threads[t] = std::thread([=]() {
+            for (uint32_t j = t; j < job_count; j += THREAD_COUNT) {
+                job(job_context, j);
+            }
+        });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+}
+
+// Test 5: A caller thread pool splits the batch into jobs
+TEST(FactoryPattern, create_many_with_executor)
+{
+    enum { COUNT = 1000 };
+    static factory_config_t conf[COUNT];
+    static api_shape_storage_t storage[COUNT] = {};
+    static api_shape_t *shapes[COUNT];
+
+    for (uint32_t i = 0; i < COUNT; i++) {
+        conf[i].shape_conf = {(shape_type_t)(SHAPE_TYPE_RECTANGLE + i % 3), i, true};
+        conf[i].shape.rect = {i + 1, 2};
+    }
+
+    factory_executor_t executor = {thread_run_jobs, NULL, 64};
+    jobs_run = 0;
+    LONGS_EQUAL(COUNT, factory_shape_create_many(conf, COUNT, storage, shapes, &executor));
+    LONGS_EQUAL((COUNT + 63) / 64, jobs_run);
+
+    for (uint32_t i = 0; i < COUNT; i++) {
+        api_shape_storage_t reference = {};
+        factory_shape_create(&reference.super, &conf[i]);
+        DOUBLES_EQUAL(shape_get_area(&reference.super), shape_get_area(shapes[i]), 0.001);
+        LONGS_EQUAL(i, shapes[i]->base.color);
+    }
+
+    // Small batches stay on the calling thread
+    jobs_run = 0;
+    LONGS_EQUAL(10, factory_shape_create_many(conf, 10, storage, shapes, &executor));
+    LONGS_EQUAL(0, jobs_run);
+}
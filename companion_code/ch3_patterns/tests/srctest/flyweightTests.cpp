@@ -0,0 +1,166 @@
+#include "CppUTest/TestHarness.h"
+
+extern "C" {
+    #include "shape_flyweight.h"
+    #include "api_rectangle.h"
+}
+
+#define TABLE_CAPACITY 8
+
+TEST_GROUP(ShapeFlyweight_Interning)
+{
+    uint8_t memory[SHAPE_FLYWEIGHT_MEMORY_SIZE(TABLE_CAPACITY)];
+    shape_flyweight_table_t table;
+
+    void setup()
+    {
+        shape_flyweight_config_t config = {};
+        config.memory = memory;
+        config.memory_size = sizeof(memory);
+        config.capacity = TABLE_CAPACITY;
+        CHECK_TRUE(shapeFlyweight_init(&table, &config));
+    }
+
+    void teardown()
+    {
+    }
+};
+
+TEST(ShapeFlyweight_Interning, usage_example)
+{
+    // 1. Stamp the same rectangle three times in different colors
+    shape_flyweight_t tiles[3];
+    rect_config_t rect_conf = {50, 100};
+    for (uint32_t i = 0; i < 3; i++) {
+        shape_config_t shape_conf = {SHAPE_TYPE_RECTANGLE, 0x100000u * i, true};
+        CHECK_TRUE(shapeFlyweight_initRectangle(&table, &tiles[i], &rect_conf, &shape_conf));
+    }
+
+    // 2. One geometry, computed once, shared by every tile
+    LONGS_EQUAL(1, shapeFlyweight_getUniqueCount(&table));
+    POINTERS_EQUAL(tiles[0].geometry, tiles[2].geometry);
+    LONGS_EQUAL(3, tiles[0].geometry->refs);
+    DOUBLES_EQUAL(5000.0, shape_get_area(&tiles[1].super), 0.1);
+    LONGS_EQUAL(300, shape_get_perimeter(&tiles[1].super));
+    LONGS_EQUAL(0x200000, tiles[2].super.base.color);
+
+    // 3. Resizing one tile copies on write: the others keep their size
+    CHECK_TRUE(shapeFlyweight_resize(&table, &tiles[1].super, 10, 20));
+    DOUBLES_EQUAL(200.0, shape_get_area(&tiles[1].super), 0.1);
+    DOUBLES_EQUAL(5000.0, shape_get_area(&tiles[0].super), 0.1);
+    LONGS_EQUAL(2, shapeFlyweight_getUniqueCount(&table));
+}
+
+TEST(ShapeFlyweight_Interning, key_includes_type)
+{
+    shape_flyweight_t rect, tri, circle, other_circle;
+    rect_config_t rect_conf = {30, 40};
+    shape_config_t rect_shape = {SHAPE_TYPE_RECTANGLE, 0, true};
+    triangle_config_t tri_conf = {30, 40};
+    shape_config_t tri_shape = {SHAPE_TYPE_TRIANGLE, 0, true};
+    circle_config_t circle_conf = {30};
+    shape_config_t circle_shape = {SHAPE_TYPE_CIRCLE, 0, true};
+
+    CHECK_TRUE(shapeFlyweight_initRectangle(&table, &rect, &rect_conf, &rect_shape));
+    CHECK_TRUE(shapeFlyweight_initTriangle(&table, &tri, &tri_conf, &tri_shape));
+    CHECK_TRUE(shapeFlyweight_initCircle(&table, &circle, &circle_conf, &circle_shape));
+    CHECK_TRUE(shapeFlyweight_initCircle(&table, &other_circle, &circle_conf, &circle_shape));
+
+    LONGS_EQUAL(3, shapeFlyweight_getUniqueCount(&table));
+    DOUBLES_EQUAL(1200.0, shape_get_area(&rect.super), 0.1);
+    DOUBLES_EQUAL(600.0, shape_get_area(&tri.super), 0.1);
+    POINTERS_EQUAL(circle.geometry, other_circle.geometry);
+
+    // Circles ignore dim_b, so this resize is a no-op
+    uint32_t generation;
+    CHECK_TRUE(shapeFlyweight_resize(&table, &circle.super, 30, 99));
+    POINTERS_EQUAL(other_circle.geometry, circle.geometry);
+    CHECK_TRUE(shape_get_generation(&circle.super, &generation));
+    LONGS_EQUAL(0, generation);
+
+    // Wrong type tag is rejected
+    shape_flyweight_t wrong;
+    CHECK_FALSE(shapeFlyweight_initCircle(&table, &wrong, &circle_conf, &rect_shape));
+}
+
+TEST(ShapeFlyweight_Interning, release_frees_the_last_reference)
+{
+    shape_flyweight_t a, b;
+    rect_config_t rect_conf = {7, 8};
+    shape_config_t shape_conf = {SHAPE_TYPE_RECTANGLE, 0, true};
+    shapeFlyweight_initRectangle(&table, &a, &rect_conf, &shape_conf);
+    shapeFlyweight_initRectangle(&table, &b, &rect_conf, &shape_conf);
+
+    shapeFlyweight_release(&table, &a.super);
+    LONGS_EQUAL(1, shapeFlyweight_getUniqueCount(&table));
+    POINTERS_EQUAL(NULL, shapeFlyweight_getGeometry(&a.super));
+
+    shapeFlyweight_release(&table, &b.super);
+    LONGS_EQUAL(0, shapeFlyweight_getUniqueCount(&table));
+
+    // Non-flyweight shapes are ignored
+    api_rectangle_t plain = {};
+    api_rectangle_init(&plain, &rect_conf, &shape_conf);
+    CHECK_FALSE(shapeFlyweight_resize(&table, &plain.super, 1, 1));
+    POINTERS_EQUAL(NULL, shapeFlyweight_getGeometry(&plain.super));
+}
+
+TEST(ShapeFlyweight_Interning, full_table_keeps_the_old_geometry)
+{
+    shape_flyweight_t shapes[TABLE_CAPACITY + 1];
+    shape_config_t shape_conf = {SHAPE_TYPE_RECTANGLE, 0, true};
+
+    for (uint32_t i = 0; i < TABLE_CAPACITY; i++) {
+        rect_config_t rect_conf = {i + 1, 1};
+        CHECK_TRUE(shapeFlyweight_initRectangle(&table, &shapes[i], &rect_conf, &shape_conf));
+    }
+    rect_config_t extra = {100, 1};
+    CHECK_FALSE(shapeFlyweight_initRectangle(&table, &shapes[TABLE_CAPACITY], &extra, &shape_conf));
+
+    // Resizing into an existing geometry still works, a new one does not
+    CHECK_FALSE(shapeFlyweight_resize(&table, &shapes[0].super, 100, 1));
+    LONGS_EQUAL(1, shapes[0].geometry->dim_a);
+    CHECK_TRUE(shapeFlyweight_resize(&table, &shapes[0].super, 2, 1));
+    POINTERS_EQUAL(shapes[1].geometry, shapes[0].geometry);
+    LONGS_EQUAL(TABLE_CAPACITY - 1, shapeFlyweight_getUniqueCount(&table));
+
+    const shape_geometry_t *area = NULL;
+    shapeFlyweight_findBiggest(&table, &area, NULL);
+    LONGS_EQUAL(TABLE_CAPACITY, area->dim_a);
+}
+
+// Random resizes stress the probing and the backward-shift deletion
+TEST(ShapeFlyweight_Interning, churn_matches_the_instances)
+{
+    enum { COUNT = 6 };
+    shape_flyweight_t shapes[COUNT];
+    shape_config_t shape_conf = {SHAPE_TYPE_RECTANGLE, 0, true};
+    rect_config_t rect_conf = {1, 1};
+    uint32_t seed = 7;
+
+    for (uint32_t i = 0; i < COUNT; i++) {
+        CHECK_TRUE(shapeFlyweight_initRectangle(&table, &shapes[i], &rect_conf, &shape_conf));
+    }
+
+    for (uint32_t step = 0; step < 2000; step++) {
+        seed = seed * 1664525u + 1013904223u;
+        uint32_t i = (seed >> 16) % COUNT;
+        uint32_t width = 1 + (seed >> 8) % 5;
+        CHECK_TRUE(shapeFlyweight_resize(&table, &shapes[i].super, width, 1));
+
+        // Every instance still sees its own size, and equal sizes share one geometry
+        uint32_t distinct = 0;
+        for (uint32_t a = 0; a < COUNT; a++) {
+            bool first = true;
+            for (uint32_t b = 0; b < a; b++) {
+                if (shapes[b].geometry->dim_a == shapes[a].geometry->dim_a) {
+                    POINTERS_EQUAL(shapes[b].geometry, shapes[a].geometry);
+                    first = false;
+                }
+            }
+            distinct += first ? 1 : 0;
+            DOUBLES_EQUAL((double)shapes[a].geometry->dim_a, shape_get_area(&shapes[a].super), 0.001);
+        }
+        LONGS_EQUAL(distinct, shapeFlyweight_getUniqueCount(&table));
+    }
+}
@@ -0,0 +1,159 @@
+#include "CppUTest/TestHarness.h"
+
+extern "C" {
+    #include "shape_math.h"
+    #include "circle.h"
+}
+
+#include "shapeTolerance.h"
+
+// Reference values use the library's pi constant in double precision
+#define REF_PI 3.14159
+
+static const uint32_t g_radii[] = {0, 1, 5, 20, 100, 4096, 65535, 65536, 100000, 1000000, SHAPE_Q_MAX_RADIUS};
+#define RADII_COUNT (sizeof(g_radii) / sizeof(g_radii[0]))
+
+// Q results are only defined up to SHAPE_Q_MAX_RADIUS
+static bool q_in_range(uint32_t radius)
+{
+    return radius <= SHAPE_Q_MAX_RADIUS;
+}
+
+TEST_GROUP(ShapeMath_FixedPoint)
+{
+    void setup()
+    {
+    }
+
+    void teardown()
+    {
+    }
+};
+
+TEST(ShapeMath_FixedPoint, usage_example)
+{
+    // 1. Q values are plain integers: no float unit needed
+    shape_q_t area = shapeMath_circleAreaQ(20);
+    shape_q_t perimeter = shapeMath_circlePerimeterQ(20);
+
+    // 2. Convert only at the edges (display, logging, float API)
+    DOUBLES_EQUAL(1256.6, shapeMath_qToFloat(area), AREA_TOLERANCE(1256.6, 0.1));
+    LONGS_EQUAL(125, shapeMath_qToUint(perimeter));
+}
+
+TEST(ShapeMath_FixedPoint, circle_area_q_within_bound)
+{
+    for (uint32_t i = 0; i < RADII_COUNT; i++) {
+        if (!q_in_range(g_radii[i])) {
+            continue;
+        }
+        double r = g_radii[i];
+        double expected = r * r * REF_PI;
+        double q_area = shapeMath_qToFloat(shapeMath_circleAreaQ(g_radii[i]));
+        DOUBLES_EQUAL(expected, q_area, expected * Q_RELATIVE_BOUND);
+    }
+}
+
+TEST(ShapeMath_FixedPoint, circle_perimeter_q_within_bound)
+{
+    for (uint32_t i = 0; i < RADII_COUNT; i++) {
+        double expected = 2.0 * REF_PI * g_radii[i];
+        if (expected >= 4294967296.0) {
+            continue; // Perimeter does not fit the uint32 API
+        }
+        uint32_t q_perimeter = shapeMath_qToUint(shapeMath_circlePerimeterQ(g_radii[i]));
+        // Truncation can move the result by one unit
+        DOUBLES_EQUAL(expected, q_perimeter, 1.0 + expected * Q_RELATIVE_BOUND);
+    }
+}
+
+TEST(ShapeMath_FixedPoint, triangle_and_rectangle_q_are_exact)
+{
+    DOUBLES_EQUAL(600.0, shapeMath_qToFloat(shapeMath_triangleAreaQ(30, 40)), 0.0);
+    DOUBLES_EQUAL(12.5, shapeMath_qToFloat(shapeMath_triangleAreaQ(5, 5)), 0.0);
+    DOUBLES_EQUAL(5000.0, shapeMath_qToFloat(shapeMath_rectAreaQ(50, 100)), 0.0);
+}
+
+TEST(ShapeMath_FixedPoint, selected_backend_matches_reference)
+{
+    for (uint32_t i = 0; i < RADII_COUNT; i++) {
+        double r = g_radii[i];
+        double expected = r * r * REF_PI;
+        double bound = (SHAPE_MATH_FIXED_POINT && !q_in_range(g_radii[i])) ? FALLBACK_RELATIVE_BOUND
+                                                                           : PATH_RELATIVE_BOUND;
+        DOUBLES_EQUAL(expected, shapeMath_circleArea(g_radii[i]), expected * bound);
+    }
+}
+
+TEST(ShapeMath_FixedPoint, circle_area_past_max_radius)
+{
+    const uint32_t radii[] = {SHAPE_Q_MAX_RADIUS + 1, 1u << 24, 0xFFFFFFFFu};
+
+    // At the bound the Q value is still exact to the Q pi
+    double r = SHAPE_Q_MAX_RADIUS;
+    double q_area = shapeMath_qToFloat(shapeMath_circleAreaQ(SHAPE_Q_MAX_RADIUS));
+    DOUBLES_EQUAL(r * r * REF_PI, q_area, r * r * REF_PI * Q_RELATIVE_BOUND);
+
+    // Past it: Q saturates, the float API stays accurate on both backends
+    for (uint32_t i = 0; i < sizeof(radii) / sizeof(radii[0]); i++) {
+        if (!q_in_range(radii[i])) {
+            CHECK(shapeMath_circleAreaQ(radii[i]) == SHAPE_Q_SATURATED);
+        }
+        r = radii[i];
+        DOUBLES_EQUAL(r * r * REF_PI, shapeMath_circleArea(radii[i]), r * r * REF_PI * FALLBACK_RELATIVE_BOUND);
+    }
+}
+
+TEST(ShapeMath_FixedPoint, circle_perimeter_saturates)
+{
+    // At the bound the Q value still holds 2 * r * Q pi (Q30 reaches it below 2^32)
+    uint32_t radius = SHAPE_Q_MAX_PERIMETER_RADIUS;
+    CHECK(shapeMath_circlePerimeterQ(radius) == 2 * (shape_q_t)radius * SHAPE_Q_PI);
+    if (radius < 0xFFFFFFFFu) {
+        CHECK(shapeMath_circlePerimeterQ(radius + 1) == SHAPE_Q_SATURATED);
+    }
+
+    // Perimeters past 2^32 clamp instead of dropping the high bits, on both backends
+    LONGS_EQUAL(0xFFFFFFFFu, shapeMath_qToUint(SHAPE_Q_SATURATED));
+    LONGS_EQUAL(0xFFFFFFFFu, shapeMath_circlePerimeter(1000000000u));
+    LONGS_EQUAL(0xFFFFFFFFu, shapeMath_circlePerimeter(0xFFFFFFFFu));
+}
+
+TEST(ShapeMath_FixedPoint, triangle_and_rectangle_area_past_product_bound)
+{
+    // Largest height that keeps base * height within each bound
+    const uint32_t base = 0xFFFFFFFFu;
+    shape_q_t tri_height = SHAPE_Q_MAX_TRIANGLE_PRODUCT / base;
+    shape_q_t rect_height = SHAPE_Q_MAX_RECT_PRODUCT / base;
+    tri_height = (tri_height > 0xFFFFFFFFu) ? 0xFFFFFFFFu : tri_height;
+    rect_height = (rect_height > 0xFFFFFFFFu) ? 0xFFFFFFFFu : rect_height;
+
+    // At the bound: exact
+    double product = (double)base * (double)tri_height;
+    DOUBLES_EQUAL(product / 2.0, shapeMath_qToFloat(shapeMath_triangleAreaQ(base, (uint32_t)tri_height)),
+                  product * FLOAT_RELATIVE_BOUND);
+    product = (double)base * (double)rect_height;
+    DOUBLES_EQUAL(product, shapeMath_qToFloat(shapeMath_rectAreaQ(base, (uint32_t)rect_height)),
+                  product * FLOAT_RELATIVE_BOUND);
+
+    // One past it: saturated
+    CHECK(shapeMath_triangleAreaQ(base, (uint32_t)tri_height + 1) == SHAPE_Q_SATURATED);
+    CHECK(shapeMath_rectAreaQ(base, (uint32_t)rect_height + 1) == SHAPE_Q_SATURATED);
+
+    // The float API does not wrap
+    const uint32_t side = 1u << 25;
+    DOUBLES_EQUAL(562949953421312.0, shapeMath_triangleArea(side, side), 562949953421312.0 * FLOAT_RELATIVE_BOUND);
+    DOUBLES_EQUAL(9223372032559808512.5, shapeMath_triangleArea(base, base), 9223372032559808512.5 * FLOAT_RELATIVE_BOUND);
+}
+
+TEST(ShapeMath_FixedPoint, large_radius_does_not_wrap)
+{
+    // 100000^2 does not fit in 32 bits
+    uint32_t radius = q_in_range(100000) ? 100000 : SHAPE_Q_MAX_RADIUS;
+    circle_memory_t mem = { };
+    circle_config_t conf = {radius};
+    hCircle_t circle = circle_init(&mem, &conf);
+
+    double expected = (double)radius * radius * REF_PI;
+    DOUBLES_EQUAL(expected, circle_getArea(circle), expected * PATH_RELATIVE_BOUND);
+}
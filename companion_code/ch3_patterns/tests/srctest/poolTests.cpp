@@ -0,0 +1,231 @@
+#include "CppUTest/TestHarness.h"
+
+extern "C" {
+    #include "shape_pool.h"
+}
+
+#include "shapeTolerance.h"
+
+#define POOL_CAPACITY 4
+
+static uint32_t lock_calls;
+static uint32_t unlock_calls;
+
+static void count_lock(void *context)
+{
+    (void)context;
+    lock_calls++;
+}
+
+static void count_unlock(void *context)
+{
+    (void)context;
+    unlock_calls++;
+}
+
+static factory_config_t rect_config(uint32_t width, uint32_t height)
+{
+    factory_config_t conf = {};
+    conf.shape_conf.type = SHAPE_TYPE_RECTANGLE;
+    conf.shape_conf.color = 0xFF0000;
+    conf.shape_conf.visible = true;
+    conf.shape.rect.width = width;
+    conf.shape.rect.height = height;
+    return conf;
+}
+
+TEST_GROUP(ShapePool_SlabPattern)
+{
+    uint8_t memory[SHAPE_POOL_MEMORY_SIZE(POOL_CAPACITY, POOL_CAPACITY, POOL_CAPACITY)];
+    shape_pool_t pool;
+
+    void setup()
+    {
+        lock_calls = 0;
+        unlock_calls = 0;
+
+        shape_pool_config_t config = {};
+        config.memory = memory;
+        config.memory_size = sizeof(memory);
+        config.capacity[0] = POOL_CAPACITY;
+        config.capacity[1] = POOL_CAPACITY;
+        config.capacity[2] = POOL_CAPACITY;
+        CHECK_TRUE(shapePool_init(&pool, &config));
+    }
+
+    void teardown()
+    {
+    }
+};
+
+TEST(ShapePool_SlabPattern, usage_example)
+{
+    // 1. Create shapes straight from factory configs: no heap, one call each
+    factory_config_t conf = rect_config(50, 100);
+    api_shape_t *rect = shapePool_create(&pool, &conf);
+
+    conf.shape_conf.type = SHAPE_TYPE_CIRCLE;
+    conf.shape.circle.radius = 20;
+    api_shape_t *circle = shapePool_create(&pool, &conf);
+
+    CHECK(rect != NULL);
+    CHECK(circle != NULL);
+    DOUBLES_EQUAL(5000.0, shape_get_area(rect), 0.1);
+    DOUBLES_EQUAL(1256.6, shape_get_area(circle), AREA_TOLERANCE(1256.6, 0.1));
+
+    // 2. Free returns the block to its slab
+    CHECK_TRUE(shapePool_free(&pool, rect));
+
+    // 3. Statistics per type
+    shape_pool_stats_t stats;
+    CHECK_TRUE(shapePool_getStats(&pool, SHAPE_TYPE_RECTANGLE, &stats));
+    LONGS_EQUAL(POOL_CAPACITY, stats.capacity);
+    LONGS_EQUAL(0, stats.in_use);
+    LONGS_EQUAL(1, stats.high_water);
+}
+
+TEST(ShapePool_SlabPattern, exhaustion_and_high_water)
+{
+    factory_config_t conf = rect_config(1, 2);
+    api_shape_t *shapes[POOL_CAPACITY];
+
+    for (uint32_t i = 0; i < POOL_CAPACITY; i++) {
+        shapes[i] = shapePool_create(&pool, &conf);
+        CHECK(shapes[i] != NULL);
+    }
+    POINTERS_EQUAL(NULL, shapePool_create(&pool, &conf));
+
+    // Other types have their own slab
+    POINTERS_EQUAL(NULL, shapePool_alloc(&pool, SHAPE_TYPE_RECTANGLE));
+    CHECK(shapePool_alloc(&pool, SHAPE_TYPE_TRIANGLE) != NULL);
+
+    shapePool_free(&pool, shapes[1]);
+    shapePool_free(&pool, shapes[2]);
+
+    shape_pool_stats_t stats;
+    shapePool_getStats(&pool, SHAPE_TYPE_RECTANGLE, &stats);
+    LONGS_EQUAL(2, stats.in_use);
+    LONGS_EQUAL(POOL_CAPACITY, stats.high_water);
+    LONGS_EQUAL(2, stats.failed);
+}
+
+TEST(ShapePool_SlabPattern, freed_block_is_reused_first)
+{
+    api_shape_t *a = shapePool_alloc(&pool, SHAPE_TYPE_CIRCLE);
+    api_shape_t *b = shapePool_alloc(&pool, SHAPE_TYPE_CIRCLE);
+    CHECK(a != b);
+
+    shapePool_free(&pool, a);
+    POINTERS_EQUAL(a, shapePool_alloc(&pool, SHAPE_TYPE_CIRCLE));
+}
+
+TEST(ShapePool_SlabPattern, rejects_foreign_and_misaligned_pointers)
+{
+    api_rectangle_t outside = {};
+    CHECK_FALSE(shapePool_free(&pool, (api_shape_t *)&outside));
+    CHECK_FALSE(shapePool_free(&pool, NULL));
+
+    api_shape_t *rect = shapePool_alloc(&pool, SHAPE_TYPE_RECTANGLE);
+    CHECK_FALSE(shapePool_free(&pool, (api_shape_t *)((uint8_t *)rect + 1)));
+    CHECK_TRUE(shapePool_free(&pool, rect));
+
+    POINTERS_EQUAL(NULL, shapePool_alloc(&pool, (shape_type_t)0));
+}
+
+TEST(ShapePool_SlabPattern, double_free_is_rejected)
+{
+    api_shape_t *a = shapePool_alloc(&pool, SHAPE_TYPE_CIRCLE);
+    api_shape_t *b = shapePool_alloc(&pool, SHAPE_TYPE_CIRCLE);
+    CHECK_TRUE(shapePool_free(&pool, a));
+    CHECK_FALSE(shapePool_free(&pool, a));
+
+    // The free list still holds 'a' once and in_use did not underflow
+    shape_pool_stats_t stats;
+    shapePool_getStats(&pool, SHAPE_TYPE_CIRCLE, &stats);
+    LONGS_EQUAL(1, stats.in_use);
+    POINTERS_EQUAL(a, shapePool_alloc(&pool, SHAPE_TYPE_CIRCLE));
+    CHECK(shapePool_alloc(&pool, SHAPE_TYPE_CIRCLE) != a);
+
+    // Same through a thread cache, and across the two paths
+    shape_pool_cache_t cache;
+    shapePool_cacheInit(&cache, &pool);
+    CHECK_TRUE(shapePool_cacheFree(&cache, b));
+    CHECK_FALSE(shapePool_cacheFree(&cache, b));
+    CHECK_FALSE(shapePool_free(&pool, b));
+    POINTERS_EQUAL(b, shapePool_cacheAlloc(&cache, SHAPE_TYPE_CIRCLE));
+    CHECK_TRUE(shapePool_cacheFree(&cache, b));
+    shapePool_cacheFlush(&cache);
+    CHECK_FALSE(shapePool_cacheFree(&cache, b));
+}
+
+TEST(ShapePool_SlabPattern, init_fails_when_memory_is_too_small)
+{
+    shape_pool_config_t config = {};
+    config.memory = memory;
+    config.memory_size = sizeof(api_rectangle_t);
+    config.capacity[0] = 2;
+    CHECK_FALSE(shapePool_init(&pool, &config));
+
+    config.memory_size = sizeof(memory);
+    config.lock = count_lock; // unlock missing
+    CHECK_FALSE(shapePool_init(&pool, &config));
+}
+
+TEST(ShapePool_SlabPattern, cache_locks_once_per_batch)
+{
+    shape_pool_config_t config = {};
+    config.memory = memory;
+    config.memory_size = sizeof(memory);
+    config.capacity[0] = POOL_CAPACITY;
+    config.lock = count_lock;
+    config.unlock = count_unlock;
+    CHECK_TRUE(shapePool_init(&pool, &config));
+
+    shape_pool_cache_t cache;
+    shapePool_cacheInit(&cache, &pool);
+
+    // One refill serves several allocations
+    factory_config_t conf = rect_config(3, 4);
+    api_shape_t *first = shapePool_cacheCreate(&cache, &conf);
+    api_shape_t *second = shapePool_cacheCreate(&cache, &conf);
+    CHECK(first != NULL);
+    CHECK(second != NULL);
+    LONGS_EQUAL(12, shape_get_area(second));
+    LONGS_EQUAL(1, lock_calls);
+
+    // Cached frees do not touch the pool
+    CHECK_TRUE(shapePool_cacheFree(&cache, first));
+    CHECK_TRUE(shapePool_cacheFree(&cache, second));
+    LONGS_EQUAL(1, lock_calls);
+
+    // Cached blocks still count as in use until flushed
+    shape_pool_stats_t stats;
+    shapePool_getStats(&pool, SHAPE_TYPE_RECTANGLE, &stats);
+    LONGS_EQUAL(SHAPE_POOL_CACHE_SIZE / 2, stats.in_use);
+
+    shapePool_cacheFlush(&cache);
+    shapePool_getStats(&pool, SHAPE_TYPE_RECTANGLE, &stats);
+    LONGS_EQUAL(0, stats.in_use);
+    LONGS_EQUAL(2, lock_calls);
+    LONGS_EQUAL(lock_calls, unlock_calls);
+}
+
+TEST(ShapePool_SlabPattern, partial_refill_is_not_a_failure)
+{
+    shape_pool_cache_t cache;
+    shapePool_cacheInit(&cache, &pool);
+
+    // Fewer free blocks than a refill asks for: the allocations still succeed
+    CHECK(shapePool_alloc(&pool, SHAPE_TYPE_CIRCLE) != NULL);
+    for (uint32_t i = 1; i < POOL_CAPACITY; i++) {
+        CHECK(shapePool_cacheAlloc(&cache, SHAPE_TYPE_CIRCLE) != NULL);
+    }
+    shape_pool_stats_t stats;
+    shapePool_getStats(&pool, SHAPE_TYPE_CIRCLE, &stats);
+    LONGS_EQUAL(0, stats.failed);
+
+    // Only the call that gets NULL counts
+    POINTERS_EQUAL(NULL, shapePool_cacheAlloc(&cache, SHAPE_TYPE_CIRCLE));
+    shapePool_getStats(&pool, SHAPE_TYPE_CIRCLE, &stats);
+    LONGS_EQUAL(1, stats.failed);
+}
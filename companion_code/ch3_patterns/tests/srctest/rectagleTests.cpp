@@ -2,6 +2,7 @@
 
 extern "C" {
     #include "rectangle.h"
+    #include "shape_seqlock.h"
 }
 
 TEST_GROUP(Rectangle_ObjectPattern){ 
@@ -34,3 +35,30 @@ TEST(Rectangle_ObjectPattern, demonstrates_MultipleIndependentInstances)
     LONGS_EQUAL(5*10, small_rect.area);
     LONGS_EQUAL(100*200, big_rect.area);
 }
+
+TEST(Rectangle_ObjectPattern, mutators_refresh_cache_and_bump_generation)
+{
+    rectangle_t rect = { };
+    rect_config_t conf = {10, 20};
+    rect_init(&rect, &conf);
+
+    uint32_t generation = rect.generation;
+    rect_updateWidth(&rect, 30);
+
+    LONGS_EQUAL(30 * 20, rect_get_area(&rect));
+    LONGS_EQUAL(2 * (30 + 20), rect_get_perimeter(&rect));
+    CHECK(rect.generation != generation);
+}
+
+TEST(Rectangle_ObjectPattern, update_dimensions_is_one_update)
+{
+    rectangle_t rect = { };
+    rect_config_t conf = {10, 20};
+    rect_init(&rect, &conf);
+
+    rect_updateDimensions(&rect, 3, 4);
+
+    LONGS_EQUAL(12, rect_get_area(&rect));
+    LONGS_EQUAL(14, rect_get_perimeter(&rect));
+    LONGS_EQUAL(SHAPE_SEQLOCK ? 2 : 1, rect.generation); // One writer bracket
+}
@@ -0,0 +1,631 @@
+#include "CppUTest/TestHarness.h"
+
+#include <thread>
+
+extern "C" {
+    #include "shape_registry.h"
+    #include "api_rectangle.h"
+    #include "api_circle.h"
+    #include "shape_change.h"
+    #include "shape_store.h"
+}
+
+#define REGISTRY_CAPACITY 100
+
+static void make_rect(api_rectangle_t *rect, uint32_t width, uint32_t height)
+{
+    rect_config_t rect_conf = {width, height};
+    shape_config_t shape_conf = {SHAPE_TYPE_RECTANGLE, 0xFF0000, true};
+    api_rectangle_init(rect, &rect_conf, &shape_conf);
+}
+
+TEST_GROUP(ShapeRegistry_InstancePattern)
+{
+    uint8_t memory[SHAPE_REGISTRY_MEMORY_SIZE(REGISTRY_CAPACITY)];
+    shape_registry_t registry;
+
+    void setup()
+    {
+        shape_registry_config_t config = {};
+        config.memory = memory;
+        config.memory_size = sizeof(memory);
+        config.capacity = REGISTRY_CAPACITY;
+        CHECK_TRUE(shapeRegistry_InstanceInit(&registry, &config));
+    }
+
+    void teardown()
+    {
+        shapeChange_removeAll();
+    }
+};
+
+TEST(ShapeRegistry_InstancePattern, usage_example)
+{
+    // 1. Far more shapes than the singleton's MAX_SHAPES
+    static api_rectangle_t rects[REGISTRY_CAPACITY] = {};
+    for (uint32_t i = 0; i < REGISTRY_CAPACITY; i++) {
+        make_rect(&rects[i], i + 1, 2);
+        CHECK_TRUE(shapeRegistry_InstanceRegister(&registry, &rects[i].super, NULL));
+    }
+    LONGS_EQUAL(REGISTRY_CAPACITY, registry.count);
+
+    // 2. Same Tasks pattern as the singleton
+    shapeRegistry_InstanceTasks(&registry);
+    POINTERS_EQUAL(&rects[REGISTRY_CAPACITY - 1], registry.biggestArea);
+    POINTERS_EQUAL(&rects[REGISTRY_CAPACITY - 1], registry.biggestPerimeter);
+
+    // 3. Unregister keeps the rest in order
+    CHECK_TRUE(shapeRegistry_InstanceUnregister(&registry, &rects[REGISTRY_CAPACITY - 1].super));
+    CHECK_FALSE(shapeRegistry_InstanceUnregister(&registry, &rects[REGISTRY_CAPACITY - 1].super));
+    shapeRegistry_InstanceTasks(&registry);
+    POINTERS_EQUAL(&rects[REGISTRY_CAPACITY - 2], registry.biggestArea);
+    POINTERS_EQUAL(&rects[0], registry.api_shapes[0]);
+}
+
+TEST(ShapeRegistry_InstancePattern, capacity_comes_from_the_config)
+{
+    api_rectangle_t rect = {};
+    make_rect(&rect, 1, 1);
+
+    shape_registry_t small;
+    uint8_t small_memory[SHAPE_REGISTRY_MEMORY_SIZE(2)];
+    shape_registry_config_t config = {small_memory, sizeof(small_memory), 2};
+    CHECK_TRUE(shapeRegistry_InstanceInit(&small, &config));
+    CHECK_TRUE(shapeRegistry_InstanceRegister(&small, &rect.super, NULL));
+    CHECK_TRUE(shapeRegistry_InstanceRegister(&small, &rect.super, NULL));
+    CHECK_FALSE(shapeRegistry_InstanceRegister(&small, &rect.super, NULL));
+
+    api_shape_t *table[2] = {&rect.super, &rect.super};
+    CHECK_FALSE(shapeRegistry_InstanceRegisterStatic(&small, table, 1));
+
+    config.capacity = 1000;
+    CHECK_FALSE(shapeRegistry_InstanceInit(&small, &config));
+}
+
+TEST(ShapeRegistry_InstancePattern, instances_are_independent_of_the_singleton)
+{
+    api_rectangle_t rect = {};
+    make_rect(&rect, 10, 10);
+
+    const shape_registry_data_t *singleton = shapeRegistry_Init();
+    CHECK_TRUE(shapeRegistry_InstanceRegister(&registry, &rect.super, NULL));
+    shapeRegistry_InstanceTasks(&registry);
+    shapeRegistry_Tasks();
+
+    LONGS_EQUAL(0, singleton->count);
+    POINTERS_EQUAL(NULL, singleton->biggestArea);
+    POINTERS_EQUAL(&rect, registry.biggestArea);
+}
+
+TEST(ShapeRegistry_InstancePattern, generation_change_triggers_rescan)
+{
+    api_rectangle_t rect = {};
+    make_rect(&rect, 10, 10);
+    api_circle_t circle = {};
+    circle_config_t circle_conf = {1};
+    shape_config_t circle_shape = {SHAPE_TYPE_CIRCLE, 0, true};
+    api_circle_init(&circle, &circle_conf, &circle_shape);
+
+    shapeRegistry_InstanceRegister(&registry, &rect.super, NULL);
+    shapeRegistry_InstanceRegister(&registry, &circle.super, NULL);
+    shapeRegistry_InstanceTasks(&registry);
+    POINTERS_EQUAL(&rect, registry.biggestArea);
+
+    circle_updateRadius(circle.circle, 50);
+    shapeRegistry_InstanceTasks(&registry);
+    POINTERS_EQUAL(&circle, registry.biggestArea);
+}
+
+TEST(ShapeRegistry_InstancePattern, merge_combines_shards)
+{
+    api_rectangle_t small = {}, big = {}, tall = {};
+    make_rect(&small, 1, 1);
+    make_rect(&big, 10, 10);
+    make_rect(&tall, 1, 30);
+
+    shape_registry_t shards[3];
+    uint8_t shard_memory[3][SHAPE_REGISTRY_MEMORY_SIZE(4)];
+    for (uint32_t i = 0; i < 3; i++) {
+        shape_registry_config_t config = {shard_memory[i], sizeof(shard_memory[i]), 4};
+        CHECK_TRUE(shapeRegistry_InstanceInit(&shards[i], &config));
+    }
+    shapeRegistry_InstanceRegister(&shards[0], &small.super, NULL);
+    shapeRegistry_InstanceRegister(&shards[1], &big.super, NULL);
+    shapeRegistry_InstanceRegister(&shards[1], &small.super, NULL);
+    shapeRegistry_InstanceRegister(&shards[2], &tall.super, NULL);
+    for (uint32_t i = 0; i < 3; i++) {
+        shapeRegistry_InstanceTasks(&shards[i]);
+    }
+
+    const shape_registry_t *list[3] = {&shards[0], &shards[1], &shards[2]};
+    shape_registry_stats_t stats;
+    shapeRegistry_Merge(list, 3, &stats);
+
+    LONGS_EQUAL(4, stats.count);
+    POINTERS_EQUAL(&big, stats.biggestArea);
+    DOUBLES_EQUAL(100.0, stats.max_area, 0.1);
+    POINTERS_EQUAL(&tall, stats.biggestPerimeter);
+    LONGS_EQUAL(62, stats.max_perimeter);
+
+    shapeRegistry_Merge(list, 0, &stats);
+    LONGS_EQUAL(0, stats.count);
+    POINTERS_EQUAL(NULL, stats.biggestArea);
+}
+
+TEST(ShapeRegistry_InstancePattern, token_unregister_keeps_order)
+{
+    api_rectangle_t rects[4] = {};
+    shape_registry_token_t tokens[4];
+    for (uint32_t i = 0; i < 4; i++) {
+        make_rect(&rects[i], i + 1, 1);
+        CHECK_TRUE(shapeRegistry_InstanceRegister(&registry, &rects[i].super, &tokens[i]));
+    }
+
+    CHECK_TRUE(shapeRegistry_InstanceUnregisterToken(&registry, tokens[1]));
+    LONGS_EQUAL(3, registry.count);
+    POINTERS_EQUAL(&rects[0], registry.api_shapes[0]);
+    POINTERS_EQUAL(&rects[2], registry.api_shapes[1]);
+    POINTERS_EQUAL(&rects[3], registry.api_shapes[2]);
+
+    // Shifted shapes keep their tokens
+    CHECK_TRUE(shapeRegistry_InstanceUnregisterToken(&registry, tokens[3]));
+    POINTERS_EQUAL(&rects[2], registry.api_shapes[1]);
+    LONGS_EQUAL(2, registry.count);
+}
+
+TEST(ShapeRegistry_InstancePattern, unordered_fills_the_hole_with_the_last)
+{
+    shape_registry_config_t config = {memory, sizeof(memory), REGISTRY_CAPACITY, true};
+    CHECK_TRUE(shapeRegistry_InstanceInit(&registry, &config));
+
+    api_rectangle_t rects[4] = {};
+    shape_registry_token_t tokens[4];
+    for (uint32_t i = 0; i < 4; i++) {
+        make_rect(&rects[i], i + 1, 1);
+        shapeRegistry_InstanceRegister(&registry, &rects[i].super, &tokens[i]);
+    }
+
+    CHECK_TRUE(shapeRegistry_InstanceUnregisterToken(&registry, tokens[0]));
+    POINTERS_EQUAL(&rects[3], registry.api_shapes[0]);
+    POINTERS_EQUAL(&rects[1], registry.api_shapes[1]);
+
+    // The moved shape is still found through its token
+    CHECK_TRUE(shapeRegistry_InstanceUnregisterToken(&registry, tokens[3]));
+    CHECK_TRUE(shapeRegistry_InstanceUnregister(&registry, &rects[1].super));
+    POINTERS_EQUAL(&rects[2], registry.api_shapes[0]);
+    LONGS_EQUAL(1, registry.count);
+
+    shapeRegistry_InstanceTasks(&registry);
+    POINTERS_EQUAL(&rects[2], registry.biggestArea);
+}
+
+TEST(ShapeRegistry_InstancePattern, stale_tokens_are_rejected)
+{
+    api_rectangle_t a = {}, b = {};
+    make_rect(&a, 1, 1);
+    make_rect(&b, 2, 2);
+    shape_registry_token_t token_a, token_b;
+
+    CHECK_FALSE(shapeRegistry_InstanceUnregisterToken(&registry, 0));
+    CHECK_FALSE(shapeRegistry_InstanceUnregisterToken(&registry, SHAPE_REGISTRY_INVALID_TOKEN));
+
+    shapeRegistry_InstanceRegister(&registry, &a.super, &token_a);
+    CHECK_TRUE(shapeRegistry_InstanceUnregisterToken(&registry, token_a));
+    CHECK_FALSE(shapeRegistry_InstanceUnregisterToken(&registry, token_a));
+
+    // A released token is reused; b's registration is the only one it names now
+    shapeRegistry_InstanceRegister(&registry, &b.super, &token_b);
+    shapeRegistry_InstanceRegister(&registry, &a.super, &token_a);
+    CHECK_TRUE(token_a != token_b);
+    CHECK_TRUE(shapeRegistry_InstanceUnregisterToken(&registry, token_b));
+    POINTERS_EQUAL(&a, registry.api_shapes[0]);
+}
+
+TEST(ShapeRegistry_InstancePattern, indexed_is_current_without_tasks)
+{
+    static uint8_t indexed_memory[SHAPE_REGISTRY_INDEXED_MEMORY_SIZE(8)];
+    shape_registry_config_t config = {indexed_memory, sizeof(indexed_memory), 8, false, true};
+    CHECK_TRUE(shapeRegistry_InstanceInit(&registry, &config));
+
+    api_rectangle_t wide = {}, tall = {}, twin = {};
+    make_rect(&wide, 20, 1);
+    make_rect(&tall, 2, 30);
+    make_rect(&twin, 20, 1);
+    shape_registry_token_t wide_token, tall_token, twin_token;
+
+    // Heaps update on every call: no Tasks needed
+    shapeRegistry_InstanceRegister(&registry, &wide.super, &wide_token);
+    shapeRegistry_InstanceRegister(&registry, &tall.super, &tall_token);
+    shapeRegistry_InstanceRegister(&registry, &twin.super, &twin_token);
+    POINTERS_EQUAL(&tall, registry.biggestArea);
+    POINTERS_EQUAL(&tall, registry.biggestPerimeter);
+
+    // Ties keep the earlier shape, like the scan
+    CHECK_TRUE(shapeRegistry_InstanceUnregisterToken(&registry, tall_token));
+    POINTERS_EQUAL(&wide, registry.biggestArea);
+
+    // Changes are not polled: a reported change re-keys one shape
+    rect_updateWidth(&twin.rect, 50);
+    shapeRegistry_InstanceTasks(&registry);
+    POINTERS_EQUAL(&wide, registry.biggestArea);
+    CHECK_TRUE(shapeRegistry_InstanceUpdate(&registry, twin_token));
+    POINTERS_EQUAL(&twin, registry.biggestArea);
+    DOUBLES_EQUAL(50.0, registry.max_area, 0.1);
+    CHECK_FALSE(shapeRegistry_InstanceUpdate(&registry, tall_token));
+
+    // Not enough memory for the trees
+    config.memory_size = SHAPE_REGISTRY_MEMORY_SIZE(8);
+    CHECK_FALSE(shapeRegistry_InstanceInit(&registry, &config));
+}
+
+// Random churn: the trees must agree with a full rescan and a brute force count, ties included
+TEST(ShapeRegistry_InstancePattern, indexed_matches_the_scan)
+{
+    enum { COUNT = 40 };
+    static uint8_t indexed_memory[SHAPE_REGISTRY_INDEXED_MEMORY_SIZE(COUNT)];
+    shape_registry_t indexed;
+    shape_registry_config_t config = {indexed_memory, sizeof(indexed_memory), COUNT, false, true};
+    CHECK_TRUE(shapeRegistry_InstanceInit(&indexed, &config));
+
+    static api_rectangle_t rects[COUNT] = {};
+    shape_registry_token_t tokens[COUNT];
+    bool registered[COUNT] = {};
+    uint32_t seed = 11;
+    for (uint32_t i = 0; i < COUNT; i++) {
+        make_rect(&rects[i], 1 + i % 4, 1 + i % 3);
+    }
+
+    for (uint32_t step = 0; step < 3000; step++) {
+        seed = seed * 1664525u + 1013904223u;
+        uint32_t i = (seed >> 16) % COUNT;
+        uint32_t action = (seed >> 8) % 3;
+
+        if (action == 0 && !registered[i]) {
+            shapeRegistry_InstanceRegister(&registry, &rects[i].super, NULL);
+            shapeRegistry_InstanceRegister(&indexed, &rects[i].super, &tokens[i]);
+            registered[i] = true;
+        } else if (action == 1 && registered[i]) {
+            shapeRegistry_InstanceUnregister(&registry, &rects[i].super);
+            CHECK_TRUE(shapeRegistry_InstanceUnregisterToken(&indexed, tokens[i]));
+            registered[i] = false;
+        } else {
+            rect_updateWidth(&rects[i].rect, (seed >> 20) % 5);
+            if (registered[i]) {
+                CHECK_TRUE(shapeRegistry_InstanceUpdate(&indexed, tokens[i]));
+            }
+        }
+
+        shapeRegistry_InstanceTasks(&registry);
+        shapeRegistry_InstanceTasks(&indexed);
+        LONGS_EQUAL(registry.count, indexed.count);
+        POINTERS_EQUAL(registry.biggestArea, indexed.biggestArea);
+        POINTERS_EQUAL(registry.biggestPerimeter, indexed.biggestPerimeter);
+
+        uint32_t lo = (seed >> 4) % 8;
+        uint32_t expected = 0;
+        for (uint32_t j = 0; j < registry.count; j++) {
+            uint32_t perimeter = shape_get_perimeter(registry.api_shapes[j]);
+            expected += (perimeter >= lo && perimeter <= lo + 3) ? 1 : 0;
+        }
+        LONGS_EQUAL(expected, shapeRegistry_CountInRange(&indexed, SHAPE_REGISTRY_KEY_PERIMETER, lo, lo + 3));
+    }
+}
+
+TEST(ShapeRegistry_InstancePattern, top_k_and_ranges)
+{
+    static uint8_t indexed_memory[SHAPE_REGISTRY_INDEXED_MEMORY_SIZE(16)];
+    shape_registry_config_t config = {indexed_memory, sizeof(indexed_memory), 16, true, true};
+    CHECK_TRUE(shapeRegistry_InstanceInit(&registry, &config));
+
+    // Areas 1, 2, ..., 10 registered in a scrambled order
+    api_rectangle_t rects[10] = {};
+    for (uint32_t i = 0; i < 10; i++) {
+        make_rect(&rects[i], 1 + (i * 7) % 10, 1);
+        shapeRegistry_InstanceRegister(&registry, &rects[i].super, NULL);
+    }
+
+    api_shape_t *top[4];
+    LONGS_EQUAL(3, shapeRegistry_TopK(&registry, SHAPE_REGISTRY_KEY_AREA, 3, top));
+    DOUBLES_EQUAL(10.0, shape_get_area(top[0]), 0.1);
+    DOUBLES_EQUAL(9.0, shape_get_area(top[1]), 0.1);
+    DOUBLES_EQUAL(8.0, shape_get_area(top[2]), 0.1);
+
+    LONGS_EQUAL(4, shapeRegistry_CountInRange(&registry, SHAPE_REGISTRY_KEY_AREA, 2.5, 6.0));
+    LONGS_EQUAL(0, shapeRegistry_CountInRange(&registry, SHAPE_REGISTRY_KEY_AREA, 6.0, 2.5));
+    LONGS_EQUAL(10, shapeRegistry_CountInRange(&registry, SHAPE_REGISTRY_KEY_PERIMETER, 0, 100));
+
+    // Ascending walk over [3, 5]
+    shape_registry_range_t range;
+    shapeRegistry_RangeBegin(&range, &registry, SHAPE_REGISTRY_KEY_AREA, 3.0, 5.0);
+    for (uint32_t expected = 3; expected <= 5; expected++) {
+        api_shape_t *shape = shapeRegistry_RangeNext(&range);
+        CHECK_TRUE(shape != NULL);
+        DOUBLES_EQUAL((double)expected, shape_get_area(shape), 0.1);
+    }
+    POINTERS_EQUAL(NULL, shapeRegistry_RangeNext(&range));
+
+    // Scanning registries have no index
+    shape_registry_t plain;
+    shape_registry_config_t plain_config = {memory, sizeof(memory), REGISTRY_CAPACITY};
+    shapeRegistry_InstanceInit(&plain, &plain_config);
+    shapeRegistry_InstanceRegister(&plain, &rects[0].super, NULL);
+    LONGS_EQUAL(0, shapeRegistry_TopK(&plain, SHAPE_REGISTRY_KEY_AREA, 4, top));
+    shapeRegistry_RangeBegin(&range, &plain, SHAPE_REGISTRY_KEY_AREA, 0.0, 100.0);
+    POINTERS_EQUAL(NULL, shapeRegistry_RangeNext(&range));
+}
+
+TEST(ShapeRegistry_InstancePattern, tracked_changes_skip_the_poll)
+{
+    static uint8_t tracked_memory[SHAPE_REGISTRY_FULL_MEMORY_SIZE(8)];
+    shape_registry_config_t config = {tracked_memory, sizeof(tracked_memory), 8, false, false, true};
+    CHECK_TRUE(shapeRegistry_InstanceInit(&registry, &config));
+
+    api_rectangle_t small = {}, big = {};
+    make_rect(&small, 1, 1);
+    make_rect(&big, 10, 10);
+    shapeRegistry_InstanceRegister(&registry, &small.super, NULL);
+    shapeRegistry_InstanceRegister(&registry, &big.super, NULL);
+    shapeRegistry_InstanceTasks(&registry);
+    POINTERS_EQUAL(&big, registry.biggestArea);
+
+    // Not reported: no poll, so the result is kept
+    rect_updateWidth(&small.rect, 500);
+    shapeChange_notify(NULL);
+#if !SHAPE_CHANGE_HOOK
+    shapeRegistry_InstanceTasks(&registry);
+    POINTERS_EQUAL(&big, registry.biggestArea);
+
+    // What the mutator reports when built with SHAPE_CHANGE_HOOK=1
+    shapeRegistry_ChangeHook(&registry, shape_get_change_key(&small.super));
+    shapeRegistry_ChangeHook(&registry, shape_get_change_key(&small.super));
+#endif
+    LONGS_EQUAL(SHAPE_CHANGE_HOOK ? 0 : 1, registry.dirty_count);
+    shapeRegistry_InstanceTasks(&registry);
+    LONGS_EQUAL(0, registry.dirty_count);
+#if !SHAPE_CHANGE_HOOK
+    POINTERS_EQUAL(&small, registry.biggestArea);
+    DOUBLES_EQUAL(500.0, registry.max_area, 0.1);
+#endif
+
+    // Unknown keys are ignored
+    api_rectangle_t stranger = {};
+    make_rect(&stranger, 1, 1);
+    shapeRegistry_ChangeHook(&registry, shape_get_change_key(&stranger.super));
+    LONGS_EQUAL(0, registry.dirty_count);
+}
+
+// Queued tokens survive unregister/reuse and keys survive the bucket shifts
+TEST(ShapeRegistry_InstancePattern, tracked_indexed_churn_matches_the_scan)
+{
+    enum { COUNT = 24 };
+    static uint8_t tracked_memory[SHAPE_REGISTRY_FULL_MEMORY_SIZE(COUNT)];
+    shape_registry_t tracked;
+    shape_registry_config_t config = {tracked_memory, sizeof(tracked_memory), COUNT, true, true, true};
+    CHECK_TRUE(shapeRegistry_InstanceInit(&tracked, &config));
+    CHECK_TRUE(shapeChange_addHook(shapeRegistry_ChangeHook, &tracked));
+
+    static api_rectangle_t rects[COUNT] = {};
+    shape_registry_token_t tokens[COUNT];
+    bool registered[COUNT] = {};
+    uint32_t seed = 5;
+    for (uint32_t i = 0; i < COUNT; i++) {
+        make_rect(&rects[i], 1 + i % 5, 2);
+    }
+
+    for (uint32_t step = 0; step < 3000; step++) {
+        seed = seed * 1664525u + 1013904223u;
+        uint32_t i = (seed >> 16) % COUNT;
+        uint32_t action = (seed >> 8) % 3;
+
+        if (action == 0 && !registered[i]) {
+            shapeRegistry_InstanceRegister(&registry, &rects[i].super, NULL);
+            shapeRegistry_InstanceRegister(&tracked, &rects[i].super, &tokens[i]);
+            registered[i] = true;
+        } else if (action == 1 && registered[i]) {
+            shapeRegistry_InstanceUnregister(&registry, &rects[i].super);
+            shapeRegistry_InstanceUnregisterToken(&tracked, tokens[i]);
+            registered[i] = false;
+        } else {
+            rect_updateWidth(&rects[i].rect, 1 + (seed >> 20) % 7);
+#if !SHAPE_CHANGE_HOOK
+            shapeRegistry_ChangeHook(&tracked, shape_get_change_key(&rects[i].super));
+#endif
+        }
+
+        // Tasks only every few steps so the queue holds unregistered tokens too
+        if (step % 4 == 3) {
+            shapeRegistry_InstanceTasks(&registry);
+            shapeRegistry_InstanceTasks(&tracked);
+            LONGS_EQUAL(registry.count, tracked.count);
+            DOUBLES_EQUAL(registry.max_area, tracked.max_area, 0.1);
+            LONGS_EQUAL(registry.max_perimeter, tracked.max_perimeter);
+        }
+    }
+    CHECK_TRUE(shapeChange_removeHook(shapeRegistry_ChangeHook, &tracked));
+}
+
+// Each tracking registry installs its own hook: all of them see the change
+TEST(ShapeRegistry_InstancePattern, change_hooks_fan_out_to_every_registry)
+{
+    static uint8_t first_memory[SHAPE_REGISTRY_FULL_MEMORY_SIZE(4)];
+    static uint8_t second_memory[SHAPE_REGISTRY_FULL_MEMORY_SIZE(4)];
+    shape_registry_t first, second;
+    shape_registry_config_t first_config = {first_memory, sizeof(first_memory), 4, false, false, true};
+    shape_registry_config_t second_config = {second_memory, sizeof(second_memory), 4, false, true, true};
+    CHECK_TRUE(shapeRegistry_InstanceInit(&first, &first_config));
+    CHECK_TRUE(shapeRegistry_InstanceInit(&second, &second_config));
+    CHECK_TRUE(shapeChange_addHook(shapeRegistry_ChangeHook, &first));
+    CHECK_TRUE(shapeChange_addHook(shapeRegistry_ChangeHook, &second));
+    CHECK_FALSE(shapeChange_addHook(shapeRegistry_ChangeHook, &first)); // Twice would be redundant
+    CHECK_FALSE(shapeChange_addHook(NULL, NULL));
+
+    api_rectangle_t rect = {};
+    make_rect(&rect, 2, 2);
+    shapeRegistry_InstanceRegister(&first, &rect.super, NULL);
+    shapeRegistry_InstanceRegister(&second, &rect.super, NULL);
+
+    shapeChange_notify(shape_get_change_key(&rect.super));
+    LONGS_EQUAL(1, first.dirty_count);
+    LONGS_EQUAL(1, second.dirty_count);
+
+    // Removing one leaves the other subscribed
+    CHECK_TRUE(shapeChange_removeHook(shapeRegistry_ChangeHook, &first));
+    CHECK_FALSE(shapeChange_removeHook(shapeRegistry_ChangeHook, &first));
+    shapeRegistry_InstanceTasks(&first);
+    shapeRegistry_InstanceTasks(&second);
+    shapeChange_notify(shape_get_change_key(&rect.super));
+    LONGS_EQUAL(0, first.dirty_count);
+    LONGS_EQUAL(1, second.dirty_count);
+
+    // The list is bounded
+    shape_registry_t others[SHAPE_CHANGE_MAX_HOOKS];
+    uint32_t added = 0;
+    for (uint32_t i = 0; i < SHAPE_CHANGE_MAX_HOOKS; i++) {
+        added += shapeChange_addHook(shapeRegistry_ChangeHook, &others[i]) ? 1 : 0;
+    }
+    LONGS_EQUAL(SHAPE_CHANGE_MAX_HOOKS - 1, added);
+}
+
+// Store handles share the store's key; a shape registered twice holds two tokens
+TEST(ShapeRegistry_InstancePattern, shared_change_key_queues_every_shape)
+{
+    static uint8_t tracked_memory[SHAPE_REGISTRY_FULL_MEMORY_SIZE(8)];
+    shape_registry_config_t config = {tracked_memory, sizeof(tracked_memory), 8, false, false, true};
+    CHECK_TRUE(shapeRegistry_InstanceInit(&registry, &config));
+    CHECK_TRUE(shapeChange_addHook(shapeRegistry_ChangeHook, &registry));
+
+    static uint8_t store_memory[SHAPE_STORE_MEMORY_SIZE(4, 0, 0)];
+    shape_store_t store;
+    shape_store_config_t store_config = {store_memory, sizeof(store_memory), {4, 0, 0}};
+    CHECK_TRUE(shapeStore_init(&store, &store_config));
+    shape_config_t shape_conf = {SHAPE_TYPE_RECTANGLE, 0, true};
+    api_shape_t *handles[3];
+    for (uint32_t i = 0; i < 3; i++) {
+        rect_config_t rect_conf = {1 + i, 1};
+        handles[i] = shapeStore_addRectangle(&store, &rect_conf, &shape_conf);
+        shapeRegistry_InstanceRegister(&registry, handles[i], NULL);
+    }
+    POINTERS_EQUAL(&store.generation, shape_get_change_key(handles[0]));
+    POINTERS_EQUAL(shape_get_change_key(handles[0]), shape_get_change_key(handles[2]));
+
+    api_rectangle_t big = {};
+    make_rect(&big, 5, 5);
+    shape_registry_token_t first, second;
+    shapeRegistry_InstanceRegister(&registry, &big.super, &first);
+    shapeRegistry_InstanceRegister(&registry, &big.super, &second);
+    shapeRegistry_InstanceTasks(&registry);
+    POINTERS_EQUAL(&big, registry.biggestArea);
+
+    // One batch update, one notify: every handle is queued
+    shapeStore_scale(&store, 10.0f);
+#if !SHAPE_CHANGE_HOOK
+    shapeChange_notify(&store.generation);
+#endif
+    LONGS_EQUAL(3, registry.dirty_count);
+    shapeRegistry_InstanceTasks(&registry);
+    POINTERS_EQUAL(handles[2], registry.biggestArea);
+    DOUBLES_EQUAL(300.0, registry.max_area, 0.1);
+
+    // Both registrations are tracked, and each unregister unlinks only its own
+    shapeChange_notify(shape_get_change_key(&big.super));
+    LONGS_EQUAL(2, registry.dirty_count);
+    shapeRegistry_InstanceTasks(&registry);
+    CHECK_TRUE(shapeRegistry_InstanceUnregisterToken(&registry, second));
+    shapeChange_notify(shape_get_change_key(&big.super));
+    LONGS_EQUAL(1, registry.dirty_count);
+    shapeRegistry_InstanceTasks(&registry);
+    CHECK_TRUE(shapeRegistry_InstanceUnregisterToken(&registry, first));
+    shapeChange_notify(shape_get_change_key(&big.super));
+    LONGS_EQUAL(0, registry.dirty_count);
+
+    // Unregistering the head of the store chain keeps the rest tracked
+    CHECK_TRUE(shapeRegistry_InstanceUnregister(&registry, handles[2]));
+    shapeChange_notify(&store.generation);
+    LONGS_EQUAL(2, registry.dirty_count);
+}
+
+#if SHAPE_CHANGE_HOOK
+TEST(ShapeRegistry_InstancePattern, mutators_report_to_the_hook)
+{
+    static uint8_t tracked_memory[SHAPE_REGISTRY_FULL_MEMORY_SIZE(8)];
+    shape_registry_config_t config = {tracked_memory, sizeof(tracked_memory), 8, false, false, true};
+    CHECK_TRUE(shapeRegistry_InstanceInit(&registry, &config));
+    CHECK_TRUE(shapeChange_addHook(shapeRegistry_ChangeHook, &registry));
+
+    api_rectangle_t rect = {};
+    make_rect(&rect, 10, 10);
+    api_circle_t circle = {};
+    circle_config_t circle_conf = {1};
+    shape_config_t circle_shape = {SHAPE_TYPE_CIRCLE, 0, true};
+    api_circle_init(&circle, &circle_conf, &circle_shape);
+    shapeRegistry_InstanceRegister(&registry, &rect.super, NULL);
+    shapeRegistry_InstanceRegister(&registry, &circle.super, NULL);
+    shapeRegistry_InstanceTasks(&registry);
+    POINTERS_EQUAL(&rect, registry.biggestArea);
+
+    circle_updateRadius(circle.circle, 50);
+    LONGS_EQUAL(1, registry.dirty_count);
+    shapeRegistry_InstanceTasks(&registry);
+    POINTERS_EQUAL(&circle, registry.biggestArea);
+
+    CHECK_TRUE(shapeChange_removeHook(shapeRegistry_ChangeHook, &registry));
+    rect_updateWidth(&rect.rect, 1000);
+    LONGS_EQUAL(0, registry.dirty_count);
+}
+#endif
+
+// Minimal fork/join pool: one thread per job
+static void thread_run_jobs(void *context, factory_job_t job, void *job_context, uint32_t job_count)
+{
+    (void)context;
+    std::thread threads[SHAPE_REGISTRY_MAX_WORKERS];
+
+    for (uint32_t j = 0; j < job_count; j++) {
+        threads[j] = std::thread([=]() { job(job_context, j); });
+    }
+    for (uint32_t j = 0; j < job_count; j++) {
+        threads[j].join();
+    }
+}
+
+// Equal maxima in several ranges: the combined result must be the serial one
+TEST(ShapeRegistry_InstancePattern, parallel_rescan_matches_serial)
+{
+    enum { COUNT = 97 };
+    static uint8_t parallel_memory[SHAPE_REGISTRY_MEMORY_SIZE(COUNT)];
+    static api_rectangle_t rects[COUNT] = {};
+    factory_executor_t executor = {thread_run_jobs, NULL, 1};
+
+    for (uint32_t i = 0; i < COUNT; i++) {
+        make_rect(&rects[i], 1 + (i * 37) % 9, 1 + (i * 11) % 4);
+    }
+
+    for (uint32_t workers = 1; workers <= 6; workers++) {
+        for (uint32_t count = 1; count <= COUNT; count += 8) {
+            shape_registry_t parallel;
+            shape_registry_config_t config = {};
+            config.memory = parallel_memory;
+            config.memory_size = sizeof(parallel_memory);
+            config.capacity = COUNT;
+            config.executor = &executor;
+            config.workers = workers;
+            CHECK_TRUE(shapeRegistry_InstanceInit(&parallel, &config));
+
+            for (uint32_t i = 0; i < count; i++) {
+                shapeRegistry_InstanceRegister(&parallel, &rects[i].super, NULL);
+            }
+            shapeRegistry_InstanceTasks(&parallel);
+
+            shape_registry_config_t serial_config = {memory, sizeof(memory), REGISTRY_CAPACITY};
+            CHECK_TRUE(shapeRegistry_InstanceInit(&registry, &serial_config));
+            for (uint32_t i = 0; i < count; i++) {
+                shapeRegistry_InstanceRegister(&registry, &rects[i].super, NULL);
+            }
+            shapeRegistry_InstanceTasks(&registry);
+
+            POINTERS_EQUAL(registry.biggestArea, parallel.biggestArea);
+            POINTERS_EQUAL(registry.biggestPerimeter, parallel.biggestPerimeter);
+            LONGS_EQUAL(registry.max_perimeter, parallel.max_perimeter);
+        }
+    }
+}
@@ -0,0 +1,208 @@
+#include "CppUTest/TestHarness.h"
+
+#include <atomic>
+#include <thread>
+
+extern "C" {
+    #include "shape_registry_view.h"
+    #include "api_rectangle.h"
+}
+
+#define VIEW_CAPACITY 64
+#define VIEW_BUFFERS 3
+
+static void make_rect(api_rectangle_t *rect, uint32_t width, uint32_t height)
+{
+    rect_config_t rect_conf = {width, height};
+    shape_config_t shape_conf = {SHAPE_TYPE_RECTANGLE, 0, true};
+    api_rectangle_init(rect, &rect_conf, &shape_conf);
+}
+
+TEST_GROUP(ShapeRegistryView_ReadCopyUpdate)
+{
+    uint8_t registry_memory[SHAPE_REGISTRY_MEMORY_SIZE(VIEW_CAPACITY)];
+    uint8_t view_memory[SHAPE_REGISTRY_VIEW_MEMORY_SIZE(VIEW_CAPACITY, VIEW_BUFFERS)];
+    shape_registry_t registry;
+    shape_registry_views_t views;
+
+    void setup()
+    {
+        shape_registry_config_t registry_conf = {};
+        registry_conf.memory = registry_memory;
+        registry_conf.memory_size = sizeof(registry_memory);
+        registry_conf.capacity = VIEW_CAPACITY;
+        CHECK_TRUE(shapeRegistry_InstanceInit(&registry, &registry_conf));
+
+        shape_registry_views_config_t view_conf = {view_memory, sizeof(view_memory), VIEW_CAPACITY, VIEW_BUFFERS};
+        CHECK_TRUE(shapeRegistryView_init(&views, &view_conf));
+    }
+
+    void teardown()
+    {
+    }
+};
+
+TEST(ShapeRegistryView_ReadCopyUpdate, usage_example)
+{
+    api_rectangle_t small = {}, big = {};
+    make_rect(&small, 1, 1);
+    make_rect(&big, 10, 10);
+
+    // 1. Before any publish readers see an empty view
+    const shape_registry_view_t *view = shapeRegistryView_acquire(&views);
+    LONGS_EQUAL(0, view->count);
+    shapeRegistryView_release(&views, view);
+
+    // 2. Writer: modify, Tasks, publish
+    shapeRegistry_InstanceRegister(&registry, &small.super, NULL);
+    shapeRegistry_InstanceRegister(&registry, &big.super, NULL);
+    shapeRegistry_InstanceTasks(&registry);
+    CHECK_TRUE(shapeRegistryView_publish(&views, &registry));
+
+    // 3. Reader: a consistent copy that later changes do not touch
+    view = shapeRegistryView_acquire(&views);
+    shapeRegistry_InstanceUnregister(&registry, &small.super);
+    shapeRegistry_InstanceTasks(&registry);
+    CHECK_TRUE(shapeRegistryView_publish(&views, &registry));
+
+    LONGS_EQUAL(2, view->count);
+    POINTERS_EQUAL(&small, view->api_shapes[0]);
+    POINTERS_EQUAL(&big, view->biggestArea);
+    LONGS_EQUAL(1, view->version);
+    shapeRegistryView_release(&views, view);
+
+    view = shapeRegistryView_acquire(&views);
+    LONGS_EQUAL(1, view->count);
+    LONGS_EQUAL(2, view->version);
+    shapeRegistryView_release(&views, view);
+}
+
+TEST(ShapeRegistryView_ReadCopyUpdate, pinned_views_are_not_reused)
+{
+    api_rectangle_t rect = {};
+    make_rect(&rect, 2, 2);
+
+    // Pin every buffer in turn: publish must never overwrite a pinned one
+    const shape_registry_view_t *first = shapeRegistryView_acquire(&views);
+    CHECK_TRUE(shapeRegistryView_publish(&views, &registry));
+    const shape_registry_view_t *second = shapeRegistryView_acquire(&views);
+    CHECK_TRUE(shapeRegistryView_publish(&views, &registry));
+    const shape_registry_view_t *third = shapeRegistryView_acquire(&views);
+    CHECK_TRUE(first != second && second != third && first != third);
+
+    shapeRegistry_InstanceRegister(&registry, &rect.super, NULL);
+    CHECK_FALSE(shapeRegistryView_publish(&views, &registry));
+    LONGS_EQUAL(0, first->count);
+    LONGS_EQUAL(2, third->version);
+
+    // Releasing the oldest view lets the writer reclaim it
+    shapeRegistryView_release(&views, first);
+    CHECK_TRUE(shapeRegistryView_publish(&views, &registry));
+    shapeRegistryView_release(&views, second);
+    shapeRegistryView_release(&views, third);
+
+    const shape_registry_view_t *view = shapeRegistryView_acquire(&views);
+    POINTERS_EQUAL(first, view);
+    LONGS_EQUAL(1, view->count);
+    shapeRegistryView_release(&views, view);
+}
+
+TEST(ShapeRegistryView_ReadCopyUpdate, config_is_checked)
+{
+    shape_registry_views_t other;
+    shape_registry_views_config_t view_conf = {view_memory, sizeof(view_memory), VIEW_CAPACITY, 1};
+    CHECK_FALSE(shapeRegistryView_init(&other, &view_conf));
+
+    view_conf.buffer_count = VIEW_BUFFERS;
+    view_conf.capacity = 1000;
+    CHECK_FALSE(shapeRegistryView_init(&other, &view_conf));
+
+    // A registry larger than the views cannot be published
+    uint8_t small_memory[SHAPE_REGISTRY_VIEW_MEMORY_SIZE(1, 2)];
+    shape_registry_views_config_t small_conf = {small_memory, sizeof(small_memory), 1, 2};
+    CHECK_TRUE(shapeRegistryView_init(&other, &small_conf));
+    api_rectangle_t rects[2] = {};
+    make_rect(&rects[0], 1, 1);
+    make_rect(&rects[1], 1, 1);
+    shapeRegistry_InstanceRegister(&registry, &rects[0].super, NULL);
+    shapeRegistry_InstanceRegister(&registry, &rects[1].super, NULL);
+    CHECK_FALSE(shapeRegistryView_publish(&other, &registry));
+}
+
+// The singleton's default instance can be published like any other
+TEST(ShapeRegistryView_ReadCopyUpdate, singleton_views)
+{
+    api_rectangle_t rect = {};
+    make_rect(&rect, 3, 3);
+
+    shapeRegistry_Init();
+    shapeRegistry_Register(&rect.super);
+    shapeRegistry_Tasks();
+    CHECK_TRUE(shapeRegistryView_publish(&views, shapeRegistry_GetInstance()));
+
+    const shape_registry_view_t *view = shapeRegistryView_acquire(&views);
+    LONGS_EQUAL(1, view->count);
+    POINTERS_EQUAL(&rect, view->biggestArea);
+    shapeRegistryView_release(&views, view);
+    shapeRegistry_Init();
+}
+
+// Writer churns the registry while readers check every view they get.
+// Invariant kept by the writer: shape i has width i + 1, biggest is the last.
+TEST(ShapeRegistryView_ReadCopyUpdate, readers_see_consistent_views)
+{
+    enum { READERS = 3, ROUNDS = 20000 };
+    static api_rectangle_t rects[VIEW_CAPACITY] = {};
+    for (uint32_t i = 0; i < VIEW_CAPACITY; i++) {
+        make_rect(&rects[i], i + 1, 1);
+    }
+
+    std::atomic<bool> done(false);
+    std::atomic<uint32_t> errors(0);
+    std::atomic<uint32_t> reads(0);
+    std::thread readers[READERS];
+
+    for (uint32_t r = 0; r < READERS; r++) {
+        readers[r] = std::thread([&]() {
+            uint32_t last_version = 0;
+            do {
+                const shape_registry_view_t *view = shapeRegistryView_acquire(&views);
+                bool ok = view->version >= last_version;
+                for (uint32_t i = 0; i < view->count; i++) {
+                    ok = ok && view->api_shapes[i] == &rects[i].super;
+                }
+                if (view->count > 0) {
+                    ok = ok && view->biggestArea == &rects[view->count - 1].super;
+                } else {
+                    ok = ok && view->biggestArea == NULL;
+                }
+                last_version = view->version;
+                shapeRegistryView_release(&views, view);
+                errors += ok ? 0 : 1;
+                reads++;
+            } while (!done.load());
+        });
+    }
+
+    uint32_t published = 0;
+    for (uint32_t round = 0; round < ROUNDS; round++) {
+        // Grow to a random size, then shrink from the end: order is kept
+        uint32_t target = (round * 2654435761u >> 8) % VIEW_CAPACITY;
+        while (registry.count < target) {
+            shapeRegistry_InstanceRegister(&registry, &rects[registry.count].super, NULL);
+        }
+        while (registry.count > target) {
+            shapeRegistry_InstanceUnregister(&registry, &rects[registry.count - 1].super);
+        }
+        shapeRegistry_InstanceTasks(&registry);
+        published += shapeRegistryView_publish(&views, &registry) ? 1 : 0;
+    }
+    done = true;
+    for (std::thread &reader : readers) {
+        reader.join();
+    }
+
+    LONGS_EQUAL(0, errors.load());
+    CHECK_TRUE(published > 0);
+    CHECK_TRUE(reads.load() > 0);
+}
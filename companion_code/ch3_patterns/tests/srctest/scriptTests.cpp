@@ -0,0 +1,168 @@
+#include "CppUTest/TestHarness.h"
+
+extern "C" {
+    #include "shape_script.h"
+    #include "canvas.h"
+    #include "shape_registry.h"
+    #include "shape_seqlock.h"
+}
+
+#include "shapeTolerance.h"
+
+#define SLOT_COUNT 4
+
+TEST_GROUP(ShapeScript_Bytecode)
+{
+    api_shape_storage_t slots[SLOT_COUNT] = {};
+    uint8_t code[256];
+    shape_script_t script;
+    shape_script_writer_t writer;
+
+    void setup()
+    {
+        canvas_config_t canvas_conf = {};
+        canvas_init(&canvas_conf);
+
+        shape_script_config_t config = {slots, SLOT_COUNT};
+        CHECK_TRUE(shapeScript_init(&script, &config));
+        shapeScript_writerInit(&writer, code, sizeof(code));
+    }
+
+    void teardown()
+    {
+    }
+};
+
+TEST(ShapeScript_Bytecode, usage_example)
+{
+    // 1. Record the scene setup once (tooling, replay file, ROM table...)
+    rect_config_t rect_conf = {10, 20};
+    shape_config_t rect_shape = {SHAPE_TYPE_RECTANGLE, 0xFF0000, true};
+    circle_config_t circle_conf = {5};
+    shape_config_t circle_shape = {SHAPE_TYPE_CIRCLE, 0x00FF00, true};
+
+    shapeScript_emitRectangle(&writer, 0, &rect_conf, &rect_shape);
+    shapeScript_emitCircle(&writer, 1, &circle_conf, &circle_shape);
+    shapeScript_emitCanvasAdd(&writer, 0, 0, 0);
+    shapeScript_emitCanvasAdd(&writer, 1, 5, 5);
+    shapeScript_emitCanvasMove(&writer, 0, 3, 0);
+    shapeScript_emitResize(&writer, 1, 10, 0);
+    shapeScript_emitCanvasTask(&writer, 4);
+    shapeScript_emitEnd(&writer);
+    CHECK_FALSE(writer.overflow);
+
+    // 2. Execute the whole stream in one call
+    CHECK_TRUE(shapeScript_run(&script, code, writer.size));
+
+    // 3. Shapes live in the slots and work with every API
+    api_shape_t *rect = shapeScript_getShape(&script, 0);
+    api_shape_t *circle = shapeScript_getShape(&script, 1);
+    DOUBLES_EQUAL(200.0, shape_get_area(rect), 0.1);
+    DOUBLES_EQUAL(314.159, shape_get_area(circle), AREA_TOLERANCE(314.159, 0.1));
+    CHECK_FALSE(canvas_isMoving(rect));
+    LONGS_EQUAL(2, script.op_counts[SHAPE_OP_CANVAS_ADD]);
+    LONGS_EQUAL(1, script.op_counts[SHAPE_OP_END]);
+}
+
+TEST(ShapeScript_Bytecode, resize_and_properties)
+{
+    rect_config_t rect_conf = {10, 20};
+    shape_config_t rect_shape = {SHAPE_TYPE_RECTANGLE, 0xFF0000, true};
+    triangle_config_t tri_conf = {10, 20};
+    shape_config_t tri_shape = {SHAPE_TYPE_TRIANGLE, 0x0000FF, true};
+
+    shapeScript_emitRectangle(&writer, 2, &rect_conf, &rect_shape);
+    shapeScript_emitTriangle(&writer, 3, &tri_conf, &tri_shape);
+    shapeScript_emitResize(&writer, 2, 30, 40);
+    shapeScript_emitResize(&writer, 3, 4, 5);
+    shapeScript_emitSetColor(&writer, 2, 0x123456);
+    shapeScript_emitSetVisible(&writer, 3, false);
+    CHECK_TRUE(shapeScript_run(&script, code, writer.size));
+
+    api_shape_t *rect = shapeScript_getShape(&script, 2);
+    api_shape_t *tri = shapeScript_getShape(&script, 3);
+    DOUBLES_EQUAL(1200.0, shape_get_area(rect), 0.1);
+    LONGS_EQUAL(140, shape_get_perimeter(rect));
+    uint32_t generation = 0;
+    CHECK_TRUE(shape_get_generation(rect, &generation));
+    LONGS_EQUAL(SHAPE_SEQLOCK ? 2 : 1, generation); // One RESIZE is one update
+    DOUBLES_EQUAL(10.0, shape_get_area(tri), 0.1);
+    LONGS_EQUAL(0x123456, rect->base.color);
+    CHECK_FALSE(tri->base.visible);
+    POINTERS_EQUAL(NULL, shapeScript_getShape(&script, 0));
+}
+
+TEST(ShapeScript_Bytecode, invalid_commands_stop_with_offset)
+{
+    rect_config_t rect_conf = {10, 20};
+    shape_config_t rect_shape = {SHAPE_TYPE_RECTANGLE, 0xFF0000, true};
+
+    // Empty slot
+    shapeScript_emitRectangle(&writer, 0, &rect_conf, &rect_shape);
+    shapeScript_emitSetColor(&writer, 1, 0);
+    CHECK_FALSE(shapeScript_run(&script, code, writer.size));
+    LONGS_EQUAL(15, script.error_offset);
+    CHECK_TRUE(shapeScript_getShape(&script, 0) != NULL); // Earlier commands stay applied
+
+    // Create on an occupied slot leaves the existing shape untouched
+    api_shape_t *rect = shapeScript_getShape(&script, 0);
+    rect_config_t other_conf = {1, 1};
+    shapeScript_writerInit(&writer, code, sizeof(code));
+    shapeScript_emitRectangle(&writer, 0, &other_conf, &rect_shape);
+    CHECK_FALSE(shapeScript_run(&script, code, writer.size));
+    LONGS_EQUAL(0, script.error_offset);
+    POINTERS_EQUAL(rect, shapeScript_getShape(&script, 0));
+    DOUBLES_EQUAL(200.0, shape_get_area(rect), 0.1);
+
+    // Slot out of range
+    shapeScript_writerInit(&writer, code, sizeof(code));
+    shapeScript_emitRectangle(&writer, SLOT_COUNT, &rect_conf, &rect_shape);
+    CHECK_FALSE(shapeScript_run(&script, code, writer.size));
+    LONGS_EQUAL(0, script.error_offset);
+
+    // Unknown opcode
+    uint8_t bad[] = {SHAPE_OP_CANVAS_TASK, 0, 0, 0xEE};
+    CHECK_FALSE(shapeScript_run(&script, bad, sizeof(bad)));
+    LONGS_EQUAL(3, script.error_offset);
+
+    // Truncated operands
+    shapeScript_writerInit(&writer, code, sizeof(code));
+    shapeScript_emitResize(&writer, 0, 1, 2);
+    CHECK_FALSE(shapeScript_run(&script, code, writer.size - 1));
+    LONGS_EQUAL(0, script.error_offset);
+}
+
+TEST(ShapeScript_Bytecode, canvas_and_registry_rejections_fail)
+{
+    const shape_registry_data_t *registry = shapeRegistry_Init();
+    circle_config_t circle_conf = {1};
+    shape_config_t circle_shape = {SHAPE_TYPE_CIRCLE, 0, true};
+
+    shapeScript_emitCircle(&writer, 0, &circle_conf, &circle_shape);
+    shapeScript_emitRegister(&writer, 0);
+    for (int i = 0; i <= CANVAS_MAX_SHAPES; i++) {
+        shapeScript_emitCanvasAdd(&writer, 0, 0, 0);
+    }
+    CHECK_FALSE(shapeScript_run(&script, code, writer.size));
+    LONGS_EQUAL(CANVAS_MAX_SHAPES + 1, script.op_counts[SHAPE_OP_CANVAS_ADD]);
+    LONGS_EQUAL(1, registry->count);
+    shapeRegistry_Init(); // Leave the singleton empty for the other groups
+}
+
+TEST(ShapeScript_Bytecode, counters_and_writer_overflow)
+{
+    shapeScript_emitCanvasTask(&writer, 0);
+    shapeScript_emitCanvasTask(&writer, 0);
+    CHECK_TRUE(shapeScript_run(&script, code, writer.size));
+    LONGS_EQUAL(2, script.op_counts[SHAPE_OP_CANVAS_TASK]);
+    shapeScript_resetCounters(&script);
+    LONGS_EQUAL(0, script.op_counts[SHAPE_OP_CANVAS_TASK]);
+
+    uint8_t small[4];
+    shapeScript_writerInit(&writer, small, sizeof(small));
+    CHECK_TRUE(shapeScript_emitCanvasTask(&writer, 1));
+    CHECK_FALSE(shapeScript_emitCanvasTask(&writer, 1));
+    CHECK_FALSE(shapeScript_emitEnd(&writer)); // Sticky: the stream is already incomplete
+    CHECK_TRUE(writer.overflow);
+    LONGS_EQUAL(3, writer.size);
+}
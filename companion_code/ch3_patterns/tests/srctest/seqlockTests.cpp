@@ -0,0 +1,119 @@
+#include "CppUTest/TestHarness.h"
+
+#if SHAPE_SEQLOCK
+#include <atomic>
+#include <thread>
+#endif
+
+extern "C" {
+    #include "api_rectangle.h"
+    #include "api_circle.h"
+    #include "shape_seqlock.h"
+}
+
+#include "shapeTolerance.h"
+
+static float no_area(api_shape_t *self)
+{
+    (void)self;
+    return 1.0f;
+}
+
+static uint32_t no_perimeter(api_shape_t *self)
+{
+    (void)self;
+    return 2;
+}
+
+static const shape_vtable_t untracked_vtable = {NULL, no_area, no_perimeter, NULL, NULL, NULL};
+
+TEST_GROUP(ShapeSeqlock_ConsistentReads)
+{
+    void setup()
+    {
+    }
+
+    void teardown()
+    {
+    }
+};
+
+TEST(ShapeSeqlock_ConsistentReads, usage_example)
+{
+    // 1. Writer (control thread) updates the shape as usual
+    api_circle_t circle = {};
+    circle_config_t circle_conf = {5};
+    shape_config_t shape_conf = {SHAPE_TYPE_CIRCLE, 0x00FF00, true};
+    api_circle_init(&circle, &circle_conf, &shape_conf);
+    circle_updateRadius(circle.circle, 10);
+
+    // 2. Reader (renderer, stats) gets area and perimeter of the same update
+    shape_snapshot_t snapshot;
+    CHECK_TRUE(shape_get_snapshot((api_shape_t *)&circle, &snapshot));
+    DOUBLES_EQUAL(314.159, snapshot.area, AREA_TOLERANCE(314.159, 0.1));
+    LONGS_EQUAL(62, snapshot.perimeter);
+    LONGS_EQUAL(circle_getGeneration(circle.circle), snapshot.generation);
+}
+
+TEST(ShapeSeqlock_ConsistentReads, generation_is_even_outside_updates)
+{
+    api_rectangle_t rect = {};
+    rect_config_t rect_conf = {10, 20};
+    shape_config_t shape_conf = {SHAPE_TYPE_RECTANGLE, 0xFF0000, true};
+    api_rectangle_init(&rect, &rect_conf, &shape_conf);
+
+    rect_updateWidth(&rect.rect, 11);
+    rect_updateWidth(&rect.rect, 12);
+
+    shape_snapshot_t snapshot;
+    CHECK_TRUE(shape_get_snapshot((api_shape_t *)&rect, &snapshot));
+    LONGS_EQUAL(SHAPE_SEQLOCK ? 4 : 2, snapshot.generation);
+    CHECK_FALSE(shapeSeqlock_isWriting(snapshot.generation));
+}
+
+TEST(ShapeSeqlock_ConsistentReads, untracked_type_is_read_once)
+{
+    api_shape_t custom = {};
+    shape_config_t conf = {SHAPE_TYPE_CIRCLE, 0, true};
+    api_shape_init(&custom, &conf, &untracked_vtable);
+
+    shape_snapshot_t snapshot;
+    CHECK_FALSE(shape_get_snapshot(&custom, &snapshot));
+    DOUBLES_EQUAL(1.0, snapshot.area, 0.0);
+    LONGS_EQUAL(2, snapshot.perimeter);
+}
+
+#if SHAPE_SEQLOCK
+
+// Height 3: every consistent pair satisfies 2 * area == 3 * (perimeter - 6)
+TEST(ShapeSeqlock_ConsistentReads, concurrent_reader_never_sees_torn_state)
+{
+    api_rectangle_t rect = {};
+    rect_config_t rect_conf = {1, 3};
+    shape_config_t shape_conf = {SHAPE_TYPE_RECTANGLE, 0xFF0000, true};
+    api_rectangle_init(&rect, &rect_conf, &shape_conf);
+
+    std::atomic<bool> done(false);
+    std::thread writer([&]() {
+        for (uint32_t w = 1; w < 200000; w++) {
+            rect_updateWidth(&rect.rect, w);
+        }
+        done = true;
+    });
+
+    uint32_t torn = 0;
+    uint32_t reads = 0;
+    while (!done || reads == 0) {
+        shape_snapshot_t snapshot;
+        shape_get_snapshot((api_shape_t *)&rect, &snapshot);
+        if (2.0 * snapshot.area != 3.0 * (snapshot.perimeter - 6.0)) {
+            torn++;
+        }
+        reads++;
+    }
+    writer.join();
+
+    LONGS_EQUAL(0, torn);
+}
+
+#endif // SHAPE_SEQLOCK
@@ -0,0 +1,24 @@
+#ifndef SHAPE_TOLERANCE_H
+#define SHAPE_TOLERANCE_H
+
+extern "C" {
+    #include "shape_math.h"
+}
+
+// Q path: pi rounded to SHAPE_MATH_Q_BITS bits plus one float conversion
+#define Q_RELATIVE_BOUND (1.0 / (double)SHAPE_Q_ONE + 1e-7)
+#define FLOAT_RELATIVE_BOUND 2e-7
+
+// Past the Q bounds: the Q pi times one more float rounding
+#define FALLBACK_RELATIVE_BOUND (Q_RELATIVE_BOUND + FLOAT_RELATIVE_BOUND)
+
+#if SHAPE_MATH_FIXED_POINT
+#define PATH_RELATIVE_BOUND Q_RELATIVE_BOUND
+#else
+#define PATH_RELATIVE_BOUND FLOAT_RELATIVE_BOUND
+#endif
+
+// Rounded reference value ('reference' = its own error) checked against the selected backend
+#define AREA_TOLERANCE(expected, reference) ((reference) + (expected) * PATH_RELATIVE_BOUND)
+
+#endif // SHAPE_TOLERANCE_H
@@ -8,6 +8,8 @@ extern "C" {
     #include "api_triangle.h"
 }
 
+#include "shapeTolerance.h"
+
 TEST_GROUP(SingletonPattern)
 {
     void setup()
@@ -78,7 +80,7 @@ TEST(SingletonPattern, usage_example)
 
     // 9. Verify new biggest area (Circle: 1256.6)
     CHECK_TRUE(registry->biggestArea == (api_shape_t*)&circle);
-    DOUBLES_EQUAL(1256.6, shape_get_area(registry->biggestArea), 0.1);
+    DOUBLES_EQUAL(1256.6, shape_get_area(registry->biggestArea), AREA_TOLERANCE(1256.6, 0.1));
 }
 
 TEST(SingletonPattern, init_returns_valid_pointer)
@@ -176,6 +178,32 @@ TEST(SingletonPattern, tasks_only_updates_when_new_shape_registered)
     CHECK_TRUE(registry->biggestArea == (api_shape_t*)&rect2);
 }
 
+TEST(SingletonPattern, tasks_updates_when_registered_shape_is_modified)
+{
+    api_rectangle_t rect = {};
+    rect_config_t rect_conf = {10, 20};
+    shape_config_t rect_shape = {SHAPE_TYPE_RECTANGLE, 0xFF0000, true};
+    api_rectangle_init(&rect, &rect_conf, &rect_shape);
+
+    api_circle_t circle = {};
+    circle_config_t circle_conf = {5};
+    shape_config_t circle_shape = {SHAPE_TYPE_CIRCLE, 0x00FF00, true};
+    api_circle_init(&circle, &circle_conf, &circle_shape);
+
+    const shape_registry_data_t *registry = shapeRegistry_Init();
+    shapeRegistry_Register((api_shape_t*)&rect);
+    shapeRegistry_Register((api_shape_t*)&circle);
+    shapeRegistry_Tasks();
+    CHECK_TRUE(registry->biggestArea == (api_shape_t*)&rect);
+
+    // No register/unregister: the generation change alone triggers the rescan
+    circle_updateRadius(circle.circle, 50);
+    shapeRegistry_Tasks();
+
+    CHECK_TRUE(registry->biggestArea == (api_shape_t*)&circle);
+    CHECK_TRUE(registry->biggestPerimeter == (api_shape_t*)&circle);
+}
+
 TEST(SingletonPattern, empty_registry_has_null_biggest)
 {
     const shape_registry_data_t *registry = shapeRegistry_Init();
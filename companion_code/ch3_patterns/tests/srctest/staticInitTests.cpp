@@ -0,0 +1,98 @@
+#include "CppUTest/TestHarness.h"
+#include <string.h>
+
+extern "C" {
+    #include "shape_registry.h"
+    #include "api_rectangle.h"
+    #include "api_circle.h"
+    #include "api_triangle.h"
+}
+
+// A whole scene defined at compile time: no init calls at boot
+static const api_rectangle_t g_rect = API_RECTANGLE_STATIC_INIT(10, 20, 0xFF0000, true);
+static const api_circle_t g_circle = API_CIRCLE_STATIC_INIT(g_circle, 20, 0x00FF00, true);
+static const api_triangle_t g_triangle = API_TRIANGLE_STATIC_INIT(30, 40, 0x0000FF, false);
+
+static api_shape_t * const g_scene[] = {
+    (api_shape_t *)&g_rect,
+    (api_shape_t *)&g_circle,
+    (api_shape_t *)&g_triangle,
+};
+
+TEST_GROUP(StaticInit_RomPattern)
+{
+    void setup()
+    {
+    }
+
+    void teardown()
+    {
+    }
+};
+
+TEST(StaticInit_RomPattern, usage_example)
+{
+    // 1. Hand the const table to the registry in one call
+    const shape_registry_data_t *registry = shapeRegistry_Init();
+    CHECK_TRUE(shapeRegistry_RegisterStatic(g_scene, 3));
+    LONGS_EQUAL(3, registry->count);
+
+    // 2. Statistics work as for runtime-initialized shapes
+    shapeRegistry_Tasks();
+    POINTERS_EQUAL(&g_circle, registry->biggestArea);
+    POINTERS_EQUAL(&g_circle, registry->biggestPerimeter);
+}
+
+TEST(StaticInit_RomPattern, values_match_runtime_init)
+{
+    api_rectangle_t rect = {};
+    rect_config_t rect_conf = {10, 20};
+    shape_config_t rect_shape = {SHAPE_TYPE_RECTANGLE, 0xFF0000, true};
+    api_rectangle_init(&rect, &rect_conf, &rect_shape);
+
+    api_circle_t circle = {};
+    circle_config_t circle_conf = {20};
+    shape_config_t circle_shape = {SHAPE_TYPE_CIRCLE, 0x00FF00, true};
+    api_circle_init(&circle, &circle_conf, &circle_shape);
+
+    api_triangle_t tri = {};
+    triangle_config_t tri_conf = {30, 40};
+    shape_config_t tri_shape = {SHAPE_TYPE_TRIANGLE, 0x0000FF, false};
+    api_triangle_init(&tri, &tri_conf, &tri_shape);
+
+    api_shape_t *runtime[] = {(api_shape_t *)&rect, (api_shape_t *)&circle, (api_shape_t *)&tri};
+
+    for (uint32_t i = 0; i < 3; i++) {
+        float static_area = shape_get_area(g_scene[i]);
+        float runtime_area = shape_get_area(runtime[i]);
+
+        // Bit-identical: both paths use the same shape_math formulas
+        MEMCMP_EQUAL(&runtime_area, &static_area, sizeof(float));
+        LONGS_EQUAL(shape_get_perimeter(runtime[i]), shape_get_perimeter(g_scene[i]));
+        POINTERS_EQUAL(runtime[i]->vptr, g_scene[i]->vptr);
+        LONGS_EQUAL(runtime[i]->base.type, g_scene[i]->base.type);
+        LONGS_EQUAL(runtime[i]->base.color, g_scene[i]->base.color);
+        CHECK_EQUAL(runtime[i]->base.visible, g_scene[i]->base.visible);
+    }
+    LONGS_EQUAL(200, g_rect.rect.area);
+    LONGS_EQUAL(20, circle_getRadius(g_circle.circle));
+}
+
+TEST(StaticInit_RomPattern, circle_handle_points_into_its_own_memory)
+{
+    POINTERS_EQUAL(&g_circle.mem, g_circle.circle);
+}
+
+TEST(StaticInit_RomPattern, register_static_fails_when_table_does_not_fit)
+{
+    api_shape_t *table[MAX_SHAPES + 1];
+    for (uint32_t i = 0; i < MAX_SHAPES + 1; i++) {
+        table[i] = g_scene[i % 3];
+    }
+
+    const shape_registry_data_t *registry = shapeRegistry_Init();
+    CHECK_FALSE(shapeRegistry_RegisterStatic(table, MAX_SHAPES + 1));
+    LONGS_EQUAL(0, registry->count);
+    CHECK_TRUE(shapeRegistry_RegisterStatic(table, MAX_SHAPES));
+    CHECK_FALSE(shapeRegistry_RegisterStatic(table, 1));
+}
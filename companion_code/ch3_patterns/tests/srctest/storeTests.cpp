@@ -0,0 +1,195 @@
+#include "CppUTest/TestHarness.h"
+
+extern "C" {
+    #include "shape_store.h"
+    #include "api_rectangle.h"
+    #include "api_circle.h"
+    #include "api_triangle.h"
+    #include "shape_seqlock.h"
+}
+
+#include "shapeTolerance.h"
+
+#define STORE_CAPACITY 4
+
+TEST_GROUP(ShapeStore_SoAPattern)
+{
+    uint8_t memory[SHAPE_STORE_MEMORY_SIZE(STORE_CAPACITY, STORE_CAPACITY, STORE_CAPACITY)];
+    shape_store_t store;
+
+    void setup()
+    {
+        shape_store_config_t config = {};
+        config.memory = memory;
+        config.memory_size = sizeof(memory);
+        config.capacity[0] = STORE_CAPACITY;
+        config.capacity[1] = STORE_CAPACITY;
+        config.capacity[2] = STORE_CAPACITY;
+        CHECK_TRUE(shapeStore_init(&store, &config));
+    }
+
+    void teardown()
+    {
+    }
+};
+
+TEST(ShapeStore_SoAPattern, usage_example)
+{
+    // 1. Add shapes of different types; each type lands in its own dense lane
+    rect_config_t rect_conf = {50, 100};
+    shape_config_t rect_shape = {SHAPE_TYPE_RECTANGLE, 0xFF0000, true};
+    api_shape_t *rect = shapeStore_addRectangle(&store, &rect_conf, &rect_shape);
+
+    circle_config_t circle_conf = {20};
+    shape_config_t circle_shape = {SHAPE_TYPE_CIRCLE, 0x00FF00, true};
+    api_shape_t *circle = shapeStore_addCircle(&store, &circle_conf, &circle_shape);
+
+    triangle_config_t tri_conf = {30, 40};
+    shape_config_t tri_shape = {SHAPE_TYPE_TRIANGLE, 0x0000FF, true};
+    api_shape_t *tri = shapeStore_addTriangle(&store, &tri_conf, &tri_shape);
+
+    // 2. Handles keep working with the polymorphic API
+    DOUBLES_EQUAL(5000.0, shape_get_area(rect), 0.1);
+    DOUBLES_EQUAL(1256.6, shape_get_area(circle), AREA_TOLERANCE(1256.6, 0.1));
+    DOUBLES_EQUAL(600.0, shape_get_area(tri), 0.1);
+    LONGS_EQUAL(300, shape_get_perimeter(rect));
+
+    // 3. Dense scans read the lane arrays directly
+    const shape_store_lane_t *rects = shapeStore_getLane(&store, SHAPE_TYPE_RECTANGLE);
+    LONGS_EQUAL(1, rects->count);
+    LONGS_EQUAL(50, rects->dim_a[0]);
+    LONGS_EQUAL(0xFF0000, rects->color[0]);
+
+    api_shape_t *biggestArea = NULL;
+    api_shape_t *biggestPerimeter = NULL;
+    shapeStore_findBiggest(&store, &biggestArea, &biggestPerimeter);
+    CHECK_TRUE(biggestArea == rect);
+    CHECK_TRUE(biggestPerimeter == rect);
+}
+
+TEST(ShapeStore_SoAPattern, cached_values_match_api_shapes)
+{
+    api_rectangle_t r = {};
+    rect_config_t r_conf = {10, 20};
+    shape_config_t r_shape = {SHAPE_TYPE_RECTANGLE, 0, true};
+    api_rectangle_init(&r, &r_conf, &r_shape);
+
+    api_circle_t c = {};
+    circle_config_t c_conf = {5};
+    shape_config_t c_shape = {SHAPE_TYPE_CIRCLE, 0, true};
+    api_circle_init(&c, &c_conf, &c_shape);
+
+    api_triangle_t t = {};
+    triangle_config_t t_conf = {10, 20};
+    shape_config_t t_shape = {SHAPE_TYPE_TRIANGLE, 0, true};
+    api_triangle_init(&t, &t_conf, &t_shape);
+
+    api_shape_t *sr = shapeStore_addRectangle(&store, &r_conf, &r_shape);
+    api_shape_t *sc = shapeStore_addCircle(&store, &c_conf, &c_shape);
+    api_shape_t *st = shapeStore_addTriangle(&store, &t_conf, &t_shape);
+
+    CHECK_EQUAL(shape_get_area((api_shape_t*)&r), shape_get_area(sr));
+    CHECK_EQUAL(shape_get_area((api_shape_t*)&c), shape_get_area(sc));
+    CHECK_EQUAL(shape_get_area((api_shape_t*)&t), shape_get_area(st));
+    CHECK_EQUAL(shape_get_perimeter((api_shape_t*)&r), shape_get_perimeter(sr));
+    CHECK_EQUAL(shape_get_perimeter((api_shape_t*)&c), shape_get_perimeter(sc));
+    CHECK_EQUAL(shape_get_perimeter((api_shape_t*)&t), shape_get_perimeter(st));
+}
+
+TEST(ShapeStore_SoAPattern, update_refreshes_cached_values)
+{
+    circle_config_t circle_conf = {5};
+    shape_config_t circle_shape = {SHAPE_TYPE_CIRCLE, 0x00FF00, true};
+    api_shape_t *circle = shapeStore_addCircle(&store, &circle_conf, &circle_shape);
+
+    CHECK_TRUE(shapeStore_updateDimensions(circle, 10, 0));
+
+    DOUBLES_EQUAL(314.159, shape_get_area(circle), AREA_TOLERANCE(314.159, 0.1));
+    LONGS_EQUAL(62, shape_get_perimeter(circle));
+}
+
+TEST(ShapeStore_SoAPattern, update_bumps_generation)
+{
+    circle_config_t circle_conf = {5};
+    shape_config_t circle_shape = {SHAPE_TYPE_CIRCLE, 0x00FF00, true};
+    api_shape_t *circle = shapeStore_addCircle(&store, &circle_conf, &circle_shape);
+
+    uint32_t before = 0;
+    uint32_t after = 0;
+    CHECK_TRUE(shape_get_generation(circle, &before));
+    shapeStore_updateDimensions(circle, 10, 0);
+    CHECK_TRUE(shape_get_generation(circle, &after));
+    CHECK(before != after);
+}
+
+TEST(ShapeStore_SoAPattern, add_returns_null_when_lane_full)
+{
+    rect_config_t rect_conf = {1, 1};
+    shape_config_t rect_shape = {SHAPE_TYPE_RECTANGLE, 0, true};
+
+    for (int i = 0; i < STORE_CAPACITY; i++) {
+        CHECK_TRUE(shapeStore_addRectangle(&store, &rect_conf, &rect_shape) != NULL);
+    }
+    CHECK_TRUE(shapeStore_addRectangle(&store, &rect_conf, &rect_shape) == NULL);
+    LONGS_EQUAL(0, shapeStore_getCount(&store, SHAPE_TYPE_CIRCLE));
+}
+
+TEST(ShapeStore_SoAPattern, add_rejects_mismatched_type)
+{
+    rect_config_t rect_conf = {1, 1};
+    shape_config_t circle_shape = {SHAPE_TYPE_CIRCLE, 0, true};
+
+    CHECK_TRUE(shapeStore_addRectangle(&store, &rect_conf, &circle_shape) == NULL);
+}
+
+TEST(ShapeStore_SoAPattern, init_fails_when_memory_too_small)
+{
+    shape_store_t small;
+    uint8_t tiny[16];
+    shape_store_config_t config = {};
+    config.memory = tiny;
+    config.memory_size = sizeof(tiny);
+    config.capacity[0] = STORE_CAPACITY;
+
+    CHECK_FALSE(shapeStore_init(&small, &config));
+}
+
+TEST(ShapeStore_SoAPattern, refresh_matches_per_shape_updates)
+{
+    rect_config_t rect_conf = {10, 20};
+    shape_config_t rect_shape = {SHAPE_TYPE_RECTANGLE, 0, true};
+    api_shape_t *rect = shapeStore_addRectangle(&store, &rect_conf, &rect_shape);
+
+    // Bulk edit the dense arrays, then recompute every cache in one pass
+    shape_store_lane_t *rects = (shape_store_lane_t *)shapeStore_getLane(&store, SHAPE_TYPE_RECTANGLE);
+    rects->dim_a[0] = 30;
+    shapeStore_refresh(&store);
+
+    DOUBLES_EQUAL(600.0, shape_get_area(rect), 0.1);
+    LONGS_EQUAL(100, shape_get_perimeter(rect));
+}
+
+TEST(ShapeStore_SoAPattern, scale_updates_caches_with_one_generation_bump)
+{
+    rect_config_t rect_conf = {10, 20};
+    shape_config_t rect_shape = {SHAPE_TYPE_RECTANGLE, 0, true};
+    api_shape_t *rect = shapeStore_addRectangle(&store, &rect_conf, &rect_shape);
+
+    circle_config_t circle_conf = {5};
+    shape_config_t circle_shape = {SHAPE_TYPE_CIRCLE, 0, true};
+    api_shape_t *circle = shapeStore_addCircle(&store, &circle_conf, &circle_shape);
+
+    triangle_config_t tri_conf = {30, 40};
+    shape_config_t tri_shape = {SHAPE_TYPE_TRIANGLE, 0, true};
+    api_shape_t *tri = shapeStore_addTriangle(&store, &tri_conf, &tri_shape);
+
+    uint32_t before = store.generation;
+    shapeStore_scale(&store, 2.0f);
+    LONGS_EQUAL(before + (SHAPE_SEQLOCK ? 2 : 1), store.generation);
+
+    DOUBLES_EQUAL(800.0, shape_get_area(rect), 0.1);
+    LONGS_EQUAL(120, shape_get_perimeter(rect));
+    DOUBLES_EQUAL(314.159, shape_get_area(circle), AREA_TOLERANCE(314.159, 0.1));
+    LONGS_EQUAL(0, shapeStore_getLane(&store, SHAPE_TYPE_CIRCLE)->dim_b[0]);
+    DOUBLES_EQUAL(2400.0, shape_get_area(tri), 0.1);
+}
@@ -39,3 +39,16 @@ TEST(Triangle_PrivatePattern, demonstrates_PrivateFieldAccess)
     LONGS_EQUAL(10, small_private->base);
     LONGS_EQUAL(5, small_private->height);
 }
+
+TEST(Triangle_PrivatePattern, update_refreshes_cache_and_bumps_generation)
+{
+    triangle_t tri = { };
+    triangle_config_t conf = {10, 5};
+    triangle_init(&tri, &conf);
+
+    uint32_t generation = tri.generation;
+    triangle_updateDimensions(&tri, 40, 30);
+
+    DOUBLES_EQUAL(600.0f, tri.area, 0.1f);
+    CHECK(tri.generation != generation);
+}
@@ -0,0 +1,83 @@
+#include "CppUTest/TestHarness.h"
+#include <vector>
+
+#include "shape_variant.hpp"
+
+extern "C" {
+    #include "shape_registry.h"
+    #include "canvas.h"
+}
+
+#include "shapeTolerance.h"
+
+TEST_GROUP(ShapeVariant_StaticPolymorphism)
+{
+    void setup()
+    {
+    }
+
+    void teardown()
+    {
+    }
+};
+
+TEST(ShapeVariant_StaticPolymorphism, usage_example)
+{
+    // 1. Shapes live by value in one container, no vtable involved
+    std::vector<cdp::shape_variant> shapes;
+    shapes.reserve(3);
+    shapes.emplace_back(cdp::rectangle({10, 20}, 0xFF0000));
+    shapes.emplace_back(cdp::circle({5}, 0x00FF00));
+    shapes.emplace_back(cdp::triangle({30, 40}, 0x0000FF));
+
+    // 2. std::visit resolves the type, then calls the C implementation
+    DOUBLES_EQUAL(200.0, cdp::area(shapes[0]), 0.001);
+    DOUBLES_EQUAL(78.5398, cdp::area(shapes[1]), AREA_TOLERANCE(78.5398, 0.001));
+    DOUBLES_EQUAL(600.0, cdp::area(shapes[2]), 0.001);
+    LONGS_EQUAL(60, cdp::perimeter(shapes[0]));
+}
+
+TEST(ShapeVariant_StaticPolymorphism, matches_c_vtable_dispatch)
+{
+    cdp::shape_variant shapes[] = {
+        cdp::rectangle({7, 9}),
+        cdp::circle({12}),
+        cdp::triangle({5, 5}),
+    };
+
+    for (auto &shape : shapes) {
+        api_shape_t *c_shape = cdp::api(shape);
+        DOUBLES_EQUAL(shape_get_area(c_shape), cdp::area(shape), 0.0);
+        LONGS_EQUAL(shape_get_perimeter(c_shape), cdp::perimeter(shape));
+    }
+}
+
+TEST(ShapeVariant_StaticPolymorphism, objects_are_usable_from_c_modules)
+{
+    cdp::shape_variant small = cdp::rectangle({10, 20});
+    cdp::shape_variant big = cdp::circle({50});
+
+    const shape_registry_data_t *registry = shapeRegistry_Init();
+    CHECK_TRUE(shapeRegistry_Register(cdp::api(small)));
+    CHECK_TRUE(shapeRegistry_Register(cdp::api(big)));
+    shapeRegistry_Tasks();
+    POINTERS_EQUAL(cdp::api(big), registry->biggestArea);
+
+    canvas_config_t config = {};
+    canvas_init(&config);
+    CHECK_TRUE(canvas_addShape(cdp::api(small), 0, 0));
+    canvas_removeShape(cdp::api(small));
+}
+
+TEST(ShapeVariant_StaticPolymorphism, copied_circle_owns_its_storage)
+{
+    cdp::circle original({5});
+    cdp::circle copy = original;
+
+    circle_updateRadius(original.c_object().circle, 10);
+
+    // The copy's opaque handle points into its own memory block
+    POINTERS_EQUAL(&copy.c_object().mem, copy.c_object().circle);
+    DOUBLES_EQUAL(78.5398, copy.area(), AREA_TOLERANCE(78.5398, 0.001));
+    DOUBLES_EQUAL(314.159, original.area(), AREA_TOLERANCE(314.159, 0.001));
+}
@@ -5,6 +5,8 @@ extern "C" {
 #include "api_triangle.h"
 }
 
+#include "shapeTolerance.h"
+
 // Test Group for VTable Pattern (Interface)
 TEST_GROUP(VTablePattern)
 {
@@ -48,7 +50,7 @@ TEST(VTablePattern, Polymorphism)
     DOUBLES_EQUAL(200.0, shape_get_area(shapes[0]), 0.1);
     
     // Circle: pi * 5^2 = 78.53
-    DOUBLES_EQUAL(78.5398, shape_get_area(shapes[1]), 0.1);
+    DOUBLES_EQUAL(78.5398, shape_get_area(shapes[1]), AREA_TOLERANCE(78.5398, 0.1));
 
     // Triangle: 0.5 * 10 * 20 = 100
     DOUBLES_EQUAL(100.0, shape_get_area(shapes[2]), 0.1);
@@ -63,3 +65,149 @@ TEST(VTablePattern, Polymorphism)
     // Triangle: Not implemented (returns 0)
     LONGS_EQUAL(0, shape_get_perimeter(shapes[2]));
 }
+
+// Custom type with a counting batch slot, to observe the dispatcher
+static int g_batchCalls = 0;
+static uint32_t g_batchShapes = 0;
+
+static float fixed_area(api_shape_t *self)
+{
+    (void)self;
+    return 7.0f;
+}
+
+static uint32_t fixed_perimeter(api_shape_t *self)
+{
+    (void)self;
+    return 3;
+}
+
+static void counting_area_many(api_shape_t **shapes, uint32_t n, float *out)
+{
+    g_batchCalls++;
+    g_batchShapes += n;
+    for (uint32_t i = 0; i < n; i++) {
+        out[i] = fixed_area(shapes[i]);
+    }
+}
+
+static const shape_vtable_t batch_vtable = {
+    .draw = NULL,
+    .get_area = fixed_area,
+    .get_perimeter = fixed_perimeter,
+    .get_area_many = counting_area_many,
+    .get_perimeter_many = NULL
+};
+
+static const shape_vtable_t single_vtable = {
+    .draw = NULL,
+    .get_area = fixed_area,
+    .get_perimeter = fixed_perimeter,
+    .get_area_many = NULL,
+    .get_perimeter_many = NULL
+};
+
+TEST_GROUP(VTablePattern_Batch)
+{
+    void setup()
+    {
+        g_batchCalls = 0;
+        g_batchShapes = 0;
+    }
+
+    void teardown()
+    {
+    }
+};
+
+TEST(VTablePattern_Batch, MixedArrayMatchesPerObjectCalls)
+{
+    api_rectangle_t r = {};
+    rect_config_t r_conf = {10, 20};
+    shape_config_t r_shape = {SHAPE_TYPE_RECTANGLE, 0xFF0000, true};
+    api_rectangle_init(&r, &r_conf, &r_shape);
+
+    api_circle_t c = {};
+    circle_config_t c_conf = {5};
+    shape_config_t c_shape = {SHAPE_TYPE_CIRCLE, 0x00FF00, true};
+    api_circle_init(&c, &c_conf, &c_shape);
+
+    api_triangle_t t = {};
+    triangle_config_t t_conf = {10, 20};
+    shape_config_t t_shape = {SHAPE_TYPE_TRIANGLE, 0x0000FF, true};
+    api_triangle_init(&t, &t_conf, &t_shape);
+
+    // Interleaved types: the dispatcher groups them by vptr, results keep input order
+    api_shape_t *shapes[] = {
+        (api_shape_t*)&r, (api_shape_t*)&c, (api_shape_t*)&t,
+        (api_shape_t*)&c, NULL, (api_shape_t*)&r
+    };
+    float areas[6];
+    uint32_t perimeters[6];
+
+    shape_get_area_many(shapes, 6, areas);
+    shape_get_perimeter_many(shapes, 6, perimeters);
+
+    for (int i = 0; i < 6; i++) {
+        CHECK_EQUAL(shape_get_area(shapes[i]), areas[i]);
+        CHECK_EQUAL(shape_get_perimeter(shapes[i]), perimeters[i]);
+    }
+}
+
+TEST(VTablePattern_Batch, BatchSlotCalledOncePerGroup)
+{
+    api_shape_t a = {};
+    api_shape_t b = {};
+    api_shape_t plain = {};
+    shape_config_t conf = {SHAPE_TYPE_RECTANGLE, 0, true};
+    api_shape_init(&a, &conf, &batch_vtable);
+    api_shape_init(&b, &conf, &batch_vtable);
+    api_shape_init(&plain, &conf, &single_vtable);
+
+    api_shape_t *shapes[] = {&a, &plain, &b};
+    float areas[3];
+    uint32_t perimeters[3];
+
+    shape_get_area_many(shapes, 3, areas);
+
+    // a and b share one batch call; plain falls back to get_area
+    LONGS_EQUAL(1, g_batchCalls);
+    LONGS_EQUAL(2, g_batchShapes);
+    DOUBLES_EQUAL(7.0, areas[1], 0.001);
+
+    // No perimeter batch slot: every shape uses get_perimeter
+    shape_get_perimeter_many(shapes, 3, perimeters);
+    LONGS_EQUAL(3, perimeters[0]);
+    LONGS_EQUAL(3, perimeters[2]);
+}
+
+// Holds in both dispatch modes (API_SHAPE_DEVIRTUALIZE=0/1)
+TEST(VTablePattern_Batch, KnownTypeTagWithCustomVtableUsesItsVtable)
+{
+    api_shape_t custom = {};
+    shape_config_t conf = {SHAPE_TYPE_CIRCLE, 0, true};
+    api_shape_init(&custom, &conf, &single_vtable);
+
+    DOUBLES_EQUAL(7.0, shape_get_area(&custom), 0.001);
+    LONGS_EQUAL(3, shape_get_perimeter(&custom));
+}
+
+TEST(VTablePattern_Batch, GenerationIsOptional)
+{
+    api_shape_t custom = {};
+    shape_config_t conf = {SHAPE_TYPE_CIRCLE, 0, true};
+    api_shape_init(&custom, &conf, &single_vtable);
+
+    api_rectangle_t r = {};
+    rect_config_t r_conf = {10, 20};
+    shape_config_t r_shape = {SHAPE_TYPE_RECTANGLE, 0xFF0000, true};
+    api_rectangle_init(&r, &r_conf, &r_shape);
+
+    uint32_t before = 0;
+    uint32_t after = 0;
+    CHECK_FALSE(shape_get_generation(&custom, &before));
+    CHECK_TRUE(shape_get_generation((api_shape_t *)&r, &before));
+    rect_updateWidth(&r.rect, 11);
+    CHECK_TRUE(shape_get_generation((api_shape_t *)&r, &after));
+    CHECK(before != after);
+}